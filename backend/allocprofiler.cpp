@@ -0,0 +1,347 @@
+#include "allocprofiler.h"
+#include <QJsonArray>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#if defined(WEBAPP_ALLOC_PROFILING) && defined(__GLIBC__)
+#include <unistd.h>
+// glibc-Allokator direkt, weil malloc selbst ersetzt wird
+extern "C" {
+void *__libc_malloc(size_t size);
+void __libc_free(void *ptr);
+}
+#define WEBAPP_HOOK_MALLOC 1
+#endif
+
+namespace {
+
+const int MaxRoutes = 128;             // Slot 0 = ohne Route, letzter = Überlauf
+const int OverflowSlot = MaxRoutes - 1;
+const int MaxThreads = 128;            // danach teilen sich Threads einen Block
+const int RouteNameLen = 96;
+const int NoSlot = -1;                 // vor dem Einschalten allokiert
+
+// Vor jeder Allokation; 32 Bytes, damit der Zeiger dahinter 16-Byte-ausgerichtet bleibt
+struct alignas(16) Header {
+    void *raw;                         // Beginn des Blocks (≠ this bei Ausrichtung > 16)
+    std::size_t size;
+    int slot;
+};
+static_assert(sizeof(Header) == 32, "Header muss 32 Bytes groß sein");
+
+struct ThreadCounters {
+    std::atomic<quint64> allocations[MaxRoutes];
+    std::atomic<quint64> bytes[MaxRoutes];
+    std::atomic<quint64> frees[MaxRoutes];
+};
+
+// Alles statisch und ohne Konstruktoren — new/malloc laufen schon vor main()
+std::atomic<bool> enabled{false};
+ThreadCounters threadBlocks[MaxThreads + 1];
+std::atomic<int> threadBlocksUsed{0};
+std::atomic<qint64> liveBytes[MaxRoutes];
+std::atomic<qint64> peakLiveBytes[MaxRoutes];
+std::atomic<quint64> requests[MaxRoutes];
+char routeNames[MaxRoutes][RouteNameLen];
+int routeCount = 1;
+std::mutex routeMutex;
+
+thread_local int currentSlot = 0;
+thread_local ThreadCounters *threadBlock = nullptr;
+
+ThreadCounters &counters()
+{
+    if (!threadBlock) {
+        const int i = threadBlocksUsed.fetch_add(1, std::memory_order_relaxed);
+        threadBlock = &threadBlocks[i < MaxThreads ? i : MaxThreads];
+    }
+    return *threadBlock;
+}
+
+void *rawMalloc(std::size_t size)
+{
+#ifdef WEBAPP_HOOK_MALLOC
+    return __libc_malloc(size);
+#else
+    return std::malloc(size);
+#endif
+}
+
+void rawFree(void *ptr)
+{
+#ifdef WEBAPP_HOOK_MALLOC
+    __libc_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void count(Header *h, std::size_t size)
+{
+    h->size = size;
+    h->slot = NoSlot;
+    if (!enabled.load(std::memory_order_relaxed))
+        return;
+
+    const int slot = currentSlot;
+    h->slot = slot;
+    ThreadCounters &c = counters();
+    c.allocations[slot].fetch_add(1, std::memory_order_relaxed);
+    c.bytes[slot].fetch_add(size, std::memory_order_relaxed);
+
+    const qint64 live = liveBytes[slot].fetch_add(qint64(size), std::memory_order_relaxed) + qint64(size);
+    qint64 peak = peakLiveBytes[slot].load(std::memory_order_relaxed);
+    while (live > peak && !peakLiveBytes[slot].compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+[[maybe_unused]] void *profiledAlloc(std::size_t size, std::size_t alignment = 16) noexcept
+{
+    // Bei größerer Ausrichtung Platz zum Verschieben mit anfordern
+    const std::size_t extra = alignment > 16 ? alignment : 0;
+    void *raw = rawMalloc(sizeof(Header) + extra + (size ? size : 1));
+    if (!raw)
+        return nullptr;
+
+    auto user = reinterpret_cast<std::uintptr_t>(raw) + sizeof(Header);
+    if (extra)
+        user = (user + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+    Header *h = reinterpret_cast<Header *>(user) - 1;
+    h->raw = raw;
+    count(h, size);
+    return reinterpret_cast<void *>(user);
+}
+
+[[maybe_unused]] void profiledFree(void *ptr) noexcept
+{
+    if (!ptr)
+        return;
+    Header *h = static_cast<Header *>(ptr) - 1;
+    if (h->slot != NoSlot) {
+        counters().frees[h->slot].fetch_add(1, std::memory_order_relaxed);
+        liveBytes[h->slot].fetch_sub(qint64(h->size), std::memory_order_relaxed);
+    }
+    rawFree(h->raw);
+}
+
+int slotFor(const char *route)
+{
+    std::lock_guard<std::mutex> lock(routeMutex);
+    for (int i = 1; i < routeCount; ++i) {
+        if (std::strncmp(routeNames[i], route, RouteNameLen - 1) == 0)
+            return i;
+    }
+    // Batch-Routen enthalten den Pfad — zu viele verschiedene landen im Überlauf
+    if (routeCount == OverflowSlot)
+        return OverflowSlot;
+    std::strncpy(routeNames[routeCount], route, RouteNameLen - 1);
+    return routeCount++;
+}
+
+} // namespace
+
+bool AllocProfiler::compiledIn()
+{
+#ifdef WEBAPP_ALLOC_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocProfiler::setEnabled(bool on)
+{
+    enabled.store(on && compiledIn(), std::memory_order_relaxed);
+}
+
+bool AllocProfiler::isEnabled()
+{
+    return enabled.load(std::memory_order_relaxed);
+}
+
+int AllocProfiler::enterRoute(const char *route)
+{
+    const int previous = currentSlot;
+    if (!enabled.load(std::memory_order_relaxed))
+        return previous;
+
+    const int slot = slotFor(route);
+    requests[slot].fetch_add(1, std::memory_order_relaxed);
+    currentSlot = slot;
+    return previous;
+}
+
+void AllocProfiler::leaveRoute(int previous)
+{
+    currentSlot = previous;
+}
+
+QJsonObject AllocProfiler::report(bool reset)
+{
+    // Erst alle Zähler lesen — das JSON allokiert selbst (zählt für /debug/alloc)
+    struct Row { int slot; quint64 allocations, bytes, frees, requests; qint64 live, peak; };
+    QVector<Row> rows;
+    int routes;
+    {
+        std::lock_guard<std::mutex> lock(routeMutex);
+        routes = routeCount;
+    }
+    rows.reserve(routes + 1);
+
+    const int blocks = std::min(threadBlocksUsed.load(std::memory_order_relaxed), MaxThreads) + 1;
+    auto collect = [&](int slot) {
+        Row r{ slot, 0, 0, 0, requests[slot].load(std::memory_order_relaxed),
+               liveBytes[slot].load(std::memory_order_relaxed),
+               peakLiveBytes[slot].load(std::memory_order_relaxed) };
+        for (int t = 0; t < blocks; ++t) {
+            // Block MaxThreads ist der geteilte Überlauf-Block
+            const ThreadCounters &c = threadBlocks[t == blocks - 1 ? MaxThreads : t];
+            r.allocations += c.allocations[slot].load(std::memory_order_relaxed);
+            r.bytes       += c.bytes[slot].load(std::memory_order_relaxed);
+            r.frees       += c.frees[slot].load(std::memory_order_relaxed);
+        }
+        if (r.allocations > 0 || r.live != 0)
+            rows.append(r);
+    };
+    for (int slot = 0; slot < routes; ++slot)
+        collect(slot);
+    if (routes == OverflowSlot)
+        collect(OverflowSlot);
+
+    if (reset) {
+        for (int t = 0; t <= MaxThreads; ++t) {
+            for (int slot = 0; slot < MaxRoutes; ++slot) {
+                threadBlocks[t].allocations[slot].store(0, std::memory_order_relaxed);
+                threadBlocks[t].bytes[slot].store(0, std::memory_order_relaxed);
+                threadBlocks[t].frees[slot].store(0, std::memory_order_relaxed);
+            }
+        }
+        for (int slot = 0; slot < MaxRoutes; ++slot) {
+            requests[slot].store(0, std::memory_order_relaxed);
+            peakLiveBytes[slot].store(liveBytes[slot].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) { return a.bytes > b.bytes; });
+
+    QJsonArray list;
+    for (const Row &r : rows) {
+        QJsonObject o;
+        o["route"] = r.slot == 0 ? QStringLiteral("(ohne Route)")
+                   : r.slot == OverflowSlot ? QStringLiteral("(weitere Routen)")
+                   : QString::fromUtf8(routeNames[r.slot]);
+        o["requests"]      = qint64(r.requests);
+        o["allocations"]   = qint64(r.allocations);
+        o["bytes"]         = qint64(r.bytes);
+        o["frees"]         = qint64(r.frees);
+        o["liveBytes"]     = r.live;
+        o["peakLiveBytes"] = r.peak;
+        if (r.requests > 0) {
+            o["allocationsPerRequest"] = double(r.allocations) / r.requests;
+            o["bytesPerRequest"]       = double(r.bytes) / r.requests;
+        }
+        list.append(o);
+    }
+
+    QJsonObject result;
+    result["compiledIn"] = compiledIn();
+    result["enabled"]    = isEnabled();
+#ifdef WEBAPP_HOOK_MALLOC
+    result["hooks"]      = QStringLiteral("operator new/delete + malloc");
+#else
+    result["hooks"]      = QStringLiteral("operator new/delete");
+#endif
+    result["threads"]    = threadBlocksUsed.load(std::memory_order_relaxed);
+    result["routes"]     = list;
+    return result;
+}
+
+#ifdef WEBAPP_ALLOC_PROFILING
+
+// ===== ERSETZTE GLOBALE ALLOKATOREN =====
+
+void *operator new(std::size_t size)
+{
+    if (void *p = profiledAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    if (void *p = profiledAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return profiledAlloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return profiledAlloc(size); }
+
+void operator delete(void *ptr) noexcept { profiledFree(ptr); }
+void operator delete[](void *ptr) noexcept { profiledFree(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { profiledFree(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { profiledFree(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { profiledFree(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { profiledFree(ptr); }
+
+#ifdef WEBAPP_HOOK_MALLOC
+// Qt-Container (QString, QByteArray, QList, QJsonObject-Daten) allokieren
+// über malloc, nicht über new — unter glibc deshalb auch die malloc-Familie
+// ersetzen (der vollständige Satz laut glibc-Handbuch "Replacing malloc")
+extern "C" {
+
+void *malloc(size_t size) { return profiledAlloc(size); }
+void free(void *ptr) { profiledFree(ptr); }
+
+void *calloc(size_t n, size_t size)
+{
+    if (size && n > SIZE_MAX / size) return nullptr;
+    void *p = profiledAlloc(n * size);
+    if (p) std::memset(p, 0, n * size);
+    return p;
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    if (!ptr) return profiledAlloc(size);
+    if (size == 0) { profiledFree(ptr); return nullptr; }
+    const Header *h = static_cast<Header *>(ptr) - 1;
+    void *p = profiledAlloc(size);
+    if (p) {
+        std::memcpy(p, ptr, std::min(size, h->size));
+        profiledFree(ptr);
+    }
+    return p;
+}
+
+void *memalign(size_t alignment, size_t size) { return profiledAlloc(size, alignment); }
+void *aligned_alloc(size_t alignment, size_t size) { return profiledAlloc(size, alignment); }
+void *valloc(size_t size) { return profiledAlloc(size, size_t(sysconf(_SC_PAGESIZE))); }
+
+void *pvalloc(size_t size)
+{
+    const size_t page = size_t(sysconf(_SC_PAGESIZE));
+    return profiledAlloc((size + page - 1) & ~(page - 1), page);
+}
+
+int posix_memalign(void **out, size_t alignment, size_t size)
+{
+    void *p = profiledAlloc(size, alignment);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+
+size_t malloc_usable_size(void *ptr)
+{
+    return ptr ? (static_cast<Header *>(ptr) - 1)->size : 0;
+}
+
+} // extern "C"
+#endif // WEBAPP_HOOK_MALLOC
+
+#endif // WEBAPP_ALLOC_PROFILING
@@ -0,0 +1,35 @@
+#ifndef ALLOCPROFILER_H
+#define ALLOCPROFILER_H
+
+#include <QJsonObject>
+
+// Heap-Allokationen pro Route (GET /debug/alloc)
+//
+// Nur mit CONFIG += alloc_profiling (DEFINES WEBAPP_ALLOC_PROFILING) werden
+// die globalen operator new/delete ersetzt; gezählt wird erst, wenn
+// zusätzlich ALLOC_PROFILING=1 gesetzt ist. Ohne beides kosten die Aufrufe
+// aus RequestContext nur eine Abfrage.
+//
+// Jede Allokation bekommt einen kleinen Kopf mit Größe und Route, damit
+// delete die Bytes der richtigen Route abziehen kann. Anzahl und Bytes
+// zählt jeder Thread in eigenen Zählern; Live-Bytes und deren Spitze sind
+// global, weil Speicher oft in einem anderen Thread freigegeben wird.
+class AllocProfiler
+{
+public:
+    // Mit WEBAPP_ALLOC_PROFILING gebaut?
+    static bool compiledIn();
+    // Zählen ein-/ausschalten (nur wirksam, wenn compiledIn())
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // Route für den aufrufenden Thread setzen — liefert die vorherige
+    // zum Zurücksetzen mit leaveRoute()
+    static int enterRoute(const char *route);
+    static void leaveRoute(int previous);
+
+    // Zähler je Route, nach Bytes sortiert; reset → danach auf 0
+    static QJsonObject report(bool reset = false);
+};
+
+#endif // ALLOCPROFILER_H
@@ -1,4 +1,5 @@
 #include "authmanager.h"
+#include "logger.h"
 #include <QMessageAuthenticationCode>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -12,10 +13,10 @@ AuthManager::AuthManager(QObject *parent)
     QByteArray envSecret = qgetenv("API_SECRET");
     if (envSecret.isEmpty()) {
         m_secret = QUuid::createUuid().toByteArray() + QUuid::createUuid().toByteArray();
-        qInfo() << "Auth: Zufälliger Secret-Key generiert (setze API_SECRET für persistenten Key)";
+        qCInfo(lcAuth) << "Auth: Zufälliger Secret-Key generiert (setze API_SECRET für persistenten Key)";
     } else {
         m_secret = envSecret;
-        qInfo() << "Auth: Secret-Key aus API_SECRET geladen";
+        qCInfo(lcAuth) << "Auth: Secret-Key aus API_SECRET geladen";
     }
 
     // Credentials aus Umgebungsvariablen oder Development-Defaults
@@ -23,7 +24,7 @@ AuthManager::AuthManager(QObject *parent)
     m_apiPassword = qEnvironmentVariable("API_PASSWORD", "admin123");
 
     if (qEnvironmentVariable("API_USER").isEmpty()) {
-        qWarning() << "Auth: Verwende Default-Credentials (API_USER/API_PASSWORD setzen für Production!)";
+        qCWarning(lcAuth) << "Auth: Verwende Default-Credentials (API_USER/API_PASSWORD setzen für Production!)";
     }
 }
 
@@ -52,9 +53,9 @@ QString AuthManager::generateToken(const QString &username)
 
     QString token = QString::fromUtf8(headerB64 + "." + payloadB64 + "." + signature);
 
-    qInfo() << "Auth: Token generiert für User:" << username
-            << "- gültig bis:" << QDateTime::fromSecsSinceEpoch(
-                   QDateTime::currentSecsSinceEpoch() + m_tokenLifetime).toString(Qt::ISODate);
+    qCDebug(lcAuth) << "Auth: Token generiert für User:" << username
+                    << "- gültig bis:" << QDateTime::fromSecsSinceEpoch(
+                           QDateTime::currentSecsSinceEpoch() + m_tokenLifetime).toString(Qt::ISODate);
 
     return token;
 }
@@ -63,7 +64,7 @@ QString AuthManager::validateToken(const QString &token) const
 {
     QStringList parts = token.split('.');
     if (parts.size() != 3) {
-        qDebug() << "Auth: Token-Format ungültig (erwartet 3 Teile)";
+        qCDebug(lcAuth) << "Auth: Token-Format ungültig (erwartet 3 Teile)";
         return {};
     }
 
@@ -72,7 +73,7 @@ QString AuthManager::validateToken(const QString &token) const
     QByteArray expectedSig = base64UrlEncode(sign(sigInput));
 
     if (expectedSig != parts[2].toUtf8()) {
-        qDebug() << "Auth: Token-Signatur ungültig";
+        qCDebug(lcAuth) << "Auth: Token-Signatur ungültig";
         return {};
     }
 
@@ -80,7 +81,7 @@ QString AuthManager::validateToken(const QString &token) const
     QByteArray payloadJson = base64UrlDecode(parts[1].toUtf8());
     QJsonDocument doc = QJsonDocument::fromJson(payloadJson);
     if (doc.isNull()) {
-        qDebug() << "Auth: Token-Payload nicht lesbar";
+        qCDebug(lcAuth) << "Auth: Token-Payload nicht lesbar";
         return {};
     }
 
@@ -89,7 +90,7 @@ QString AuthManager::validateToken(const QString &token) const
     // Ablaufzeit prüfen
     qint64 exp = payload["exp"].toInteger();
     if (QDateTime::currentSecsSinceEpoch() > exp) {
-        qDebug() << "Auth: Token abgelaufen";
+        qCDebug(lcAuth) << "Auth: Token abgelaufen";
         return {};
     }
 
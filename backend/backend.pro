@@ -1,4 +1,4 @@
-QT += core network sql httpserver
+QT += core network sql httpserver concurrent
 QT -= gui
 
 CONFIG += c++17 console
@@ -11,22 +11,67 @@ QMAKE_CXXFLAGS += -Wall -Wextra
 TARGET = backend
 TEMPLATE = app
 
+# Allokations-Profiling pro Route: qmake CONFIG+=alloc_profiling, zur
+# Laufzeit mit ALLOC_PROFILING=1 einschalten (GET /debug/alloc)
+alloc_profiling {
+    DEFINES += WEBAPP_ALLOC_PROFILING
+}
+
 # Source Files
 SOURCES += \
     main.cpp \
+    allocprofiler.cpp \
     server.cpp \
     database.cpp \
+    replicarouter.cpp \
+    queryguard.cpp \
+    healthmonitor.cpp \
+    tableexport.cpp \
+    staticassets.cpp \
+    trafficcapture.cpp \
+    columnarresult.cpp \
+    productstats.cpp \
+    catalogsnapshot.cpp \
+    responsecache.cpp \
+    writebatcher.cpp \
+    schemamigrator.cpp \
+    logger.cpp \
+    requestcontext.cpp \
+    connectiontracker.cpp \
+    eventstream.cpp \
+    notifylistener.cpp \
     authmanager.cpp
 
 # Header Files
 HEADERS += \
     server.h \
+    allocprofiler.h \
     database.h \
+    replicarouter.h \
+    queryguard.h \
+    healthmonitor.h \
+    tableexport.h \
+    staticassets.h \
+    trafficcapture.h \
+    capturelog.h \
+    columnarresult.h \
+    productstats.h \
+    catalogsnapshot.h \
+    responsecache.h \
+    sharedresult.h \
+    writebatcher.h \
+    schemamigrator.h \
+    logger.h \
+    requestcontext.h \
+    connectiontracker.h \
+    eventstream.h \
+    notifylistener.h \
     authmanager.h
 
 # PostgreSQL für Development (Mac)
 unix:!macx {
     # Linux
+    INCLUDEPATH += /usr/include/postgresql
     LIBS += -lpq
 }
 
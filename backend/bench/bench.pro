@@ -0,0 +1,29 @@
+# Benchmark für die Produkt-Auswertung (/api/products/stats)
+#
+#   cd backend/bench && qmake && make && ./stats-bench [zeilen] [durchläufe]
+#
+# Nutzt dieselbe Aggregation wie das Backend (productstats.cpp), aber mit
+# synthetischen Daten statt der Datenbank.
+
+QT += core sql concurrent
+QT -= gui
+
+CONFIG += c++17 console release
+CONFIG -= app_bundle
+
+QMAKE_CXXFLAGS += -Wall -Wextra
+# Schleifen sollen vektorisiert werden
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
+
+TARGET = stats-bench
+TEMPLATE = app
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    main.cpp \
+    ../productstats.cpp
+
+HEADERS += \
+    ../productstats.h
@@ -0,0 +1,100 @@
+// Benchmark: /api/products/stats auf synthetischen Daten
+//
+// Baut einen ProductSnapshot mit N Zeilen (Standard 10 Mio.) und misst
+// ProductStats::aggregate() ohne Gruppierung sowie nach category_id und
+// supplier_id — einmal mit einem Thread, einmal mit allen.
+
+#include "productstats.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QThreadPool>
+#include <QUrlQuery>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static const int Categories = 500;
+static const int Suppliers = 5000;
+
+static ProductSnapshot syntheticSnapshot(qint64 rows)
+{
+    QRandomGenerator rng(4711);
+    ProductSnapshot s;
+    s.reserve(rows);
+
+    for (qint64 i = 0; i < rows; ++i) {
+        // ~2 % ohne Kategorie, ~10 % ohne Einkaufspreis
+        const qint64 category = rng.bounded(50) == 0 ? ProductSnapshot::NullKey : rng.bounded(Categories) + 1;
+        const qint64 supplier = rng.bounded(Suppliers) + 1;
+        const double sales = std::round(rng.bounded(100000.0)) / 100.0 + 0.5;
+        const double purchase = rng.bounded(10) == 0 ? std::nan("") : std::round(sales * (50 + rng.bounded(40))) / 100.0;
+        const int vat = rng.bounded(8) == 0 ? 1 : 2;
+        s.appendRow(category, supplier, purchase, sales, vat);
+    }
+    s.builtAt = QDateTime::currentDateTimeUtc();
+    return s;
+}
+
+// Median über runs Durchläufe in ms
+static double measure(const ProductSnapshot &s, const ProductStats::Request &request, int runs)
+{
+    QVector<double> times;
+    for (int r = 0; r < runs; ++r) {
+        QElapsedTimer t;
+        t.start();
+        const QJsonObject result = ProductStats::aggregate(s, request);
+        times.append(t.nsecsElapsed() / 1e6);
+        Q_UNUSED(result);
+    }
+    std::sort(times.begin(), times.end());
+    return times.at(times.size() / 2);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const qint64 rows = argc > 1 ? QByteArray(argv[1]).toLongLong() : 10000000;
+    const int runs = argc > 2 ? QByteArray(argv[2]).toInt() : 5;
+    const int maxThreads = QThreadPool::globalInstance()->maxThreadCount();
+
+    QElapsedTimer build;
+    build.start();
+    const ProductSnapshot snapshot = syntheticSnapshot(rows);
+    std::printf("Schnappschuss: %lld Zeilen, %lld Kategorien, %lld Lieferanten, Aufbau %lld ms\n",
+                static_cast<long long>(snapshot.rowCount()),
+                static_cast<long long>(snapshot.category.values.size()),
+                static_cast<long long>(snapshot.supplier.values.size()),
+                static_cast<long long>(build.elapsed()));
+    std::printf("Median aus %d Durchläufen\n\n", runs);
+
+    const struct { const char *name; const char *query; } cases[] = {
+        { "gesamt sum,avg,min,max",         "metrics=sum,avg,min,max" },
+        { "gesamt alle Kennzahlen",         "metrics=sum,avg,min,max,margin,vat,bands" },
+        { "category_id sum,avg,min,max",    "group_by=category_id&metrics=sum,avg,min,max" },
+        { "category_id alle Kennzahlen",    "group_by=category_id&metrics=sum,avg,min,max,margin,vat,bands" },
+        { "supplier_id alle Kennzahlen",    "group_by=supplier_id&metrics=sum,avg,min,max,margin,vat,bands" },
+    };
+
+    std::printf("%-32s %12s %12s %10s %14s\n", "Fall", "1 Thread", "Threads", "Faktor", "Mio. Zeilen/s");
+    for (const auto &c : cases) {
+        ProductStats::Request request;
+        QString error;
+        if (!ProductStats::parseRequest(QUrlQuery(QString::fromLatin1(c.query)), &request, &error)) {
+            std::fprintf(stderr, "%s: %s\n", c.name, qPrintable(error));
+            return 1;
+        }
+
+        QThreadPool::globalInstance()->setMaxThreadCount(1);
+        const double single = measure(snapshot, request, runs);
+        QThreadPool::globalInstance()->setMaxThreadCount(maxThreads);
+        const double parallel = measure(snapshot, request, runs);
+
+        std::printf("%-32s %9.1f ms %9.1f ms %9.1fx %14.0f\n", c.name, single, parallel,
+                    single / parallel, rows / parallel / 1000.0);
+    }
+    std::printf("\n%d Threads\n", maxThreads);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#ifndef CAPTURELOG_H
+#define CAPTURELOG_H
+
+#include <QByteArray>
+#include <QDataStream>
+
+// Format des Traffic-Mitschnitts (CAPTURE_FILE) — geteilt von Backend und
+// replay/traffic-replay, daher nur QtCore und alles inline.
+//
+// Datei: Magic, Formatversion, Startzeit (ms seit Epoch), dann Records bis
+// zum Dateiende. Alles per QDataStream (Big Endian, Bytefolgen mit Länge).
+// Version 2 hängt Status und Dauer der Antwort an jeden Record; Version 1
+// bleibt lesbar (beides dann unbekannt).
+namespace CaptureLog {
+
+inline constexpr char Magic[8] = { 'W', 'A', 'C', 'A', 'P', 'L', 'O', 'G' };
+inline constexpr quint32 FormatVersion = 2;
+inline constexpr int StreamVersion = QDataStream::Qt_6_5;
+
+struct Record {
+    qint64 offsetUs = 0;       // seit Beginn des Mitschnitts
+    QByteArray method;         // "GET", "POST", …
+    QByteArray route;          // Route-Muster, z.B. "GET /api/products/{id}"
+    QByteArray target;         // Pfad + Query (Tokens/Passwörter entfernt)
+    QByteArray accept;
+    QByteArray contentType;
+    QByteArray ifMatch;
+    QByteArray ifNoneMatch;
+    bool authorized = false;   // hatte einen Authorization-Header (Token selbst nicht gespeichert)
+    QByteArray body;
+    qint32 status = 0;         // HTTP-Status der Antwort, 0 = keine (Client vorher weg) / unbekannt
+    qint64 durationUs = -1;    // Eintritt in den Handler bis Statuszeile der Antwort, -1 = unbekannt
+};
+
+inline QDataStream &operator<<(QDataStream &s, const Record &r)
+{
+    return s << r.offsetUs << r.method << r.route << r.target << r.accept << r.contentType
+             << r.ifMatch << r.ifNoneMatch << r.authorized << r.body << r.status << r.durationUs;
+}
+
+// Record einer Datei mit der angegebenen Formatversion lesen
+inline QDataStream &readRecord(QDataStream &s, Record &r, quint32 version)
+{
+    s >> r.offsetUs >> r.method >> r.route >> r.target >> r.accept >> r.contentType
+      >> r.ifMatch >> r.ifNoneMatch >> r.authorized >> r.body;
+    if (version >= 2)
+        s >> r.status >> r.durationUs;
+    return s;
+}
+
+inline QDataStream &operator>>(QDataStream &s, Record &r)
+{
+    return readRecord(s, r, FormatVersion);
+}
+
+} // namespace CaptureLog
+
+#endif // CAPTURELOG_H
@@ -0,0 +1,184 @@
+#include "catalogsnapshot.h"
+#include "productstats.h"
+#include <QCryptographicHash>
+#include <QSaveFile>
+#include <QSqlQuery>
+#include <QTemporaryFile>
+#include <QTimeZone>
+#include <QVariant>
+#include <cmath>
+#include <cstring>
+
+static const char Magic[8] = { 'W', 'A', 'C', 'A', 'T', 'L', 'O', 'G' };
+static const quint32 ByteOrderMark = 0x01020304;
+
+// Layout ist Teil des Dateiformats — Änderungen nur mit neuer FormatVersion
+static_assert(sizeof(CatalogSnapshot::Record) == 120, "Record-Layout geändert");
+static_assert(sizeof(CatalogSnapshot::Header) == 88, "Header-Layout geändert");
+
+const char *CatalogSnapshot::selectColumns()
+{
+    return "product_id, gtin, category_id, supplier_id, purchase_price, sales_price, "
+           "created_at, updated_at, row_version, product_number, name, unit, description, "
+           "updated_by, vat_code, active";
+}
+
+bool CatalogSnapshot::write(const QString &path, QSqlQuery &query, qint64 *rows, QString *error)
+{
+    QSaveFile out(path);
+    QTemporaryFile heapFile;
+    if (!out.open(QIODevice::WriteOnly) || !heapFile.open()) {
+        *error = out.isOpen() ? heapFile.errorString() : out.errorString();
+        return false;
+    }
+
+    // Platz für den Header, geschrieben wird er am Ende (Anzahl, Prüfsumme)
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    quint64 heapSize = 0;
+    auto text = [&](int column) {
+        const QVariant v = query.value(column);
+        if (v.isNull())
+            return StringRef{ NullOffset, 0 };
+        const QByteArray utf8 = v.toString().toUtf8();
+        const StringRef ref{ quint32(heapSize), quint32(utf8.size()) };
+        heapFile.write(utf8);
+        heapSize += quint64(utf8.size());
+        return ref;
+    };
+    auto integer = [&](int column) {
+        const QVariant v = query.value(column);
+        return v.isNull() ? NullValue : v.toLongLong();
+    };
+    auto timestamp = [&](int column) {
+        const QVariant v = query.value(column);
+        return v.isNull() ? NullValue : v.toDateTime().toMSecsSinceEpoch();
+    };
+
+    quint64 count = 0;
+    while (query.next()) {
+        Record r;
+        std::memset(&r, 0, sizeof(r));
+        r.productId = query.value(0).toLongLong();
+        r.gtin = integer(1);
+        r.categoryId = integer(2);
+        r.supplierId = integer(3);
+        r.purchasePrice = query.value(4).isNull() ? std::nan("") : query.value(4).toDouble();
+        r.salesPrice = query.value(5).toDouble();
+        r.createdAtMs = timestamp(6);
+        r.updatedAtMs = timestamp(7);
+        r.rowVersion = query.value(8).toLongLong();
+        r.productNumber = text(9);
+        r.name = text(10);
+        r.unit = text(11);
+        r.description = text(12);
+        r.updatedBy = text(13);
+        r.vatCode = quint8(query.value(14).toInt());
+        r.active = quint8(query.value(15).toInt());
+
+        const QByteArrayView bytes(reinterpret_cast<const char *>(&r), sizeof(r));
+        out.write(bytes.data(), bytes.size());
+        hash.addData(bytes);
+        ++count;
+    }
+    if (heapSize >= NullOffset) {
+        *error = "String-Heap größer als 4 GB";
+        out.cancelWriting();
+        return false;
+    }
+
+    // Heap hinter die Records kopieren
+    header.heapOffset = sizeof(Header) + count * sizeof(Record);
+    heapFile.seek(0);
+    char buffer[64 * 1024];
+    qint64 n;
+    while ((n = heapFile.read(buffer, sizeof(buffer))) > 0) {
+        out.write(buffer, n);
+        hash.addData(QByteArrayView(buffer, n));
+    }
+
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.byteOrder = ByteOrderMark;
+    header.formatVersion = FormatVersion;
+    header.headerSize = sizeof(Header);
+    header.recordSize = sizeof(Record);
+    header.rowCount = count;
+    header.heapSize = heapSize;
+    header.createdAtMs = QDateTime::currentMSecsSinceEpoch();
+    const QByteArray digest = hash.result();
+    std::memcpy(header.checksum, digest.constData(), sizeof(header.checksum));
+
+    out.seek(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!out.commit()) {
+        *error = out.errorString();
+        return false;
+    }
+    *rows = qint64(count);
+    return true;
+}
+
+bool CatalogSnapshot::open(const QString &path, QString *error)
+{
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+    const qint64 size = file.size();
+    if (size < qint64(sizeof(Header))) {
+        *error = "Datei zu klein";
+        return false;
+    }
+    const uchar *data = file.map(0, size);
+    if (!data) {
+        *error = file.errorString();
+        return false;
+    }
+
+    const auto *h = reinterpret_cast<const Header *>(data);
+    QString problem;
+    if (std::memcmp(h->magic, Magic, sizeof(Magic)) != 0) {
+        problem = "Kein Katalog-Schnappschuss";
+    } else if (h->byteOrder != ByteOrderMark || h->formatVersion != FormatVersion
+               || h->headerSize != sizeof(Header) || h->recordSize != sizeof(Record)) {
+        problem = QString("Format %1 nicht unterstützt").arg(h->formatVersion);
+    } else if (h->heapOffset != sizeof(Header) + h->rowCount * sizeof(Record)
+               || h->heapOffset + h->heapSize != quint64(size)) {
+        problem = "Größen im Header passen nicht zur Datei";
+    } else {
+        // Records + Heap liegen direkt hintereinander
+        const QByteArray digest = QCryptographicHash::hash(
+            QByteArrayView(reinterpret_cast<const char *>(data) + sizeof(Header), size - qint64(sizeof(Header))),
+            QCryptographicHash::Sha256);
+        if (std::memcmp(digest.constData(), h->checksum, sizeof(h->checksum)) != 0)
+            problem = "Prüfsumme falsch";
+    }
+    if (!problem.isEmpty()) {
+        *error = problem;
+        file.close();
+        return false;
+    }
+
+    header = h;
+    records = reinterpret_cast<const Record *>(data + sizeof(Header));
+    heap = reinterpret_cast<const char *>(data) + h->heapOffset;
+    return true;
+}
+
+QString CatalogSnapshot::string(const StringRef &ref) const
+{
+    if (ref.offset == NullOffset || quint64(ref.offset) + ref.size > header->heapSize)
+        return QString();
+    return QString::fromUtf8(heap + ref.offset, ref.size);
+}
+
+void CatalogSnapshot::appendTo(ProductSnapshot &snapshot, qint64 row) const
+{
+    static_assert(NullValue == ProductSnapshot::NullKey, "NULL-Schlüssel müssen übereinstimmen");
+    const Record &r = records[row];
+    snapshot.appendRow(r.categoryId, r.supplierId, r.purchasePrice, r.salesPrice, r.vatCode);
+}
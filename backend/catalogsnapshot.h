@@ -0,0 +1,97 @@
+#ifndef CATALOGSNAPSHOT_H
+#define CATALOGSNAPSHOT_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QString>
+#include <QTimeZone>
+#include <limits>
+
+class QSqlQuery;
+struct ProductSnapshot;
+
+// product-Tabelle als Datei für Warmstarts (CATALOG_SNAPSHOT_FILE)
+//
+// Aufbau: Header, dann ein Record fester Breite je Zeile (nach product_id
+// sortiert), dann ein String-Heap mit allen Texten als UTF-8. Der Header
+// enthält Formatversion, Record-Größe, Byte-Order und eine SHA-256 über
+// Records und Heap. Gelesen wird per mmap — die Records werden direkt aus
+// dem Mapping verwendet, nichts wird geparst.
+//
+// Geschrieben wird über QSaveFile (temporäre Datei + rename): ein
+// laufender Prozess, der die alte Datei noch gemappt hat, sieht sie
+// unverändert weiter.
+class CatalogSnapshot
+{
+public:
+    // NULL in Ganzzahl-Spalten (NULL in purchase_price = NaN)
+    static constexpr qint64 NullValue = std::numeric_limits<qint64>::min();
+    static const quint32 FormatVersion = 1;
+
+    struct StringRef {
+        quint32 offset;       // im Heap, NullOffset = NULL
+        quint32 size;
+    };
+    static const quint32 NullOffset = 0xFFFFFFFF;
+
+    struct Record {
+        qint64 productId;
+        qint64 gtin;
+        qint64 categoryId;
+        qint64 supplierId;
+        double purchasePrice;
+        double salesPrice;
+        qint64 createdAtMs;
+        qint64 updatedAtMs;
+        qint64 rowVersion;
+        StringRef productNumber;
+        StringRef name;
+        StringRef unit;
+        StringRef description;
+        StringRef updatedBy;
+        quint8 vatCode;
+        quint8 active;
+        quint8 reserved[6];
+    };
+
+    struct Header {
+        char magic[8];
+        quint32 byteOrder;    // 0x01020304 in der Byte-Order des Schreibers
+        quint32 formatVersion;
+        quint32 headerSize;
+        quint32 recordSize;
+        quint64 rowCount;
+        quint64 heapOffset;
+        quint64 heapSize;
+        qint64 createdAtMs;
+        quint8 checksum[32];  // SHA-256 über Records + Heap
+    };
+
+    // Spalten in der Reihenfolge, die write() erwartet
+    static const char *selectColumns();
+
+    // Zeilen aus der Abfrage (SELECT selectColumns() … ORDER BY product_id)
+    // atomar nach path schreiben
+    static bool write(const QString &path, QSqlQuery &query, qint64 *rows, QString *error);
+
+    // Datei mappen und prüfen (Format, Größen, Prüfsumme)
+    bool open(const QString &path, QString *error);
+    bool isOpen() const { return header != nullptr; }
+
+    qint64 rowCount() const { return qint64(header->rowCount); }
+    const Record &record(qint64 row) const { return records[row]; }
+    QString string(const StringRef &ref) const;
+    QDateTime createdAt() const { return QDateTime::fromMSecsSinceEpoch(header->createdAtMs, QTimeZone::UTC); }
+
+    // Zeile für die Auswertung übernehmen
+    void appendTo(ProductSnapshot &snapshot, qint64 row) const;
+
+private:
+    QFile file;
+    const Header *header = nullptr;
+    const Record *records = nullptr;
+    const char *heap = nullptr;
+};
+
+#endif // CATALOGSNAPSHOT_H
@@ -0,0 +1,281 @@
+#include "columnarresult.h"
+#include <QCborStreamWriter>
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QSqlField>
+#include <QSqlQuery>
+#include <QSqlRecord>
+
+// Dictionary nur, wenn es sich lohnt: genug Zeilen, wenige verschiedene
+// Werte, Codes passen in ein Byte
+static const int MinDictionaryRows = 8;
+static const int MaxDictionarySize = 256;
+static const int MinRowsPerEntry = 4;
+
+ColumnarResult::Type ColumnarResult::typeFor(const QMetaType &type)
+{
+    switch (type.id()) {
+    case QMetaType::Bool:
+        return Type::Bool;
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+        return Type::Int;
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return Type::Float;
+    default:
+        return Type::String;
+    }
+}
+
+QString ColumnarResult::typeName(Type type)
+{
+    switch (type) {
+    case Type::Int:    return QStringLiteral("int");
+    case Type::Float:  return QStringLiteral("float");
+    case Type::Bool:   return QStringLiteral("bool");
+    case Type::String: break;
+    }
+    return QStringLiteral("string");
+}
+
+bool ColumnarResult::read(QSqlQuery &query, int limit)
+{
+    const QSqlRecord rec = query.record();
+    columns.clear();
+    columns.resize(rec.count());
+    for (int i = 0; i < rec.count(); ++i) {
+        columns[i].name = rec.fieldName(i);
+        columns[i].type = typeFor(rec.field(i).metaType());
+    }
+    rows = 0;
+
+    while (query.next()) {
+        if (limit > 0 && rows == limit)
+            return true;
+        for (int i = 0; i < columns.size(); ++i)
+            append(columns[i], query.value(i));
+        ++rows;
+    }
+    return false;
+}
+
+void ColumnarResult::append(Column &column, const QVariant &value)
+{
+    const bool isNull = value.isNull();
+    if (isNull) {
+        column.nulls.resize(rows / 8 + 1, '\0');
+        column.nulls[rows / 8] = char(column.nulls.at(rows / 8) | (1 << (rows % 8)));
+        column.hasNulls = true;
+    }
+
+    switch (column.type) {
+    case Type::Int:
+    case Type::Bool:
+        column.ints.append(isNull ? 0 : (column.type == Type::Bool ? qint64(value.toBool()) : value.toLongLong()));
+        break;
+    case Type::Float:
+        column.floats.append(isNull ? 0.0 : value.toDouble());
+        break;
+    case Type::String:
+        if (isNull)
+            column.strings.append(QString());
+        else if (value.metaType().id() == QMetaType::QDateTime)
+            column.strings.append(value.toDateTime().toString(Qt::ISODateWithMs));
+        else
+            column.strings.append(value.toString());
+        break;
+    }
+}
+
+ColumnarResult::Dictionary ColumnarResult::buildDictionary(const Column &column) const
+{
+    Dictionary dict;
+    if (rows < MinDictionaryRows || column.type == Type::Float)
+        return dict;
+
+    auto isNullAt = [&column](int row) {
+        return column.hasNulls && row / 8 < column.nulls.size()
+               && (quint8(column.nulls.at(row / 8)) & (1 << (row % 8)));
+    };
+
+    const int maxEntries = qMin(MaxDictionarySize, rows / MinRowsPerEntry);
+    dict.codes.resize(rows);
+
+    if (column.type == Type::String) {
+        QHash<QString, int> index;
+        for (int r = 0; r < rows; ++r) {
+            if (isNullAt(r)) { dict.codes[r] = 0; continue; }
+            auto it = index.constFind(column.strings.at(r));
+            if (it == index.cend()) {
+                if (index.size() == maxEntries) return Dictionary();
+                it = index.insert(column.strings.at(r), int(dict.stringValues.size()));
+                dict.stringValues.append(column.strings.at(r));
+            }
+            dict.codes[r] = quint8(*it);
+        }
+        dict.used = !dict.stringValues.isEmpty();
+    } else {
+        QHash<qint64, int> index;
+        for (int r = 0; r < rows; ++r) {
+            if (isNullAt(r)) { dict.codes[r] = 0; continue; }
+            auto it = index.constFind(column.ints.at(r));
+            if (it == index.cend()) {
+                if (index.size() == maxEntries) return Dictionary();
+                it = index.insert(column.ints.at(r), int(dict.intValues.size()));
+                dict.intValues.append(column.ints.at(r));
+            }
+            dict.codes[r] = quint8(*it);
+        }
+        dict.used = !dict.intValues.isEmpty();
+    }
+    return dict;
+}
+
+QVariant ColumnarResult::lastValue(int column) const
+{
+    if (rows == 0 || column < 0 || column >= columns.size()) return QVariant();
+    const Column &c = columns.at(column);
+    switch (c.type) {
+    case Type::Int:    return c.ints.last();
+    case Type::Bool:   return c.ints.last() != 0;
+    case Type::Float:  return c.floats.last();
+    case Type::String: break;
+    }
+    return c.strings.last();
+}
+
+// ===== JSON =====
+
+void ColumnarResult::addToJson(QJsonObject &object) const
+{
+    QJsonArray names;
+    QJsonArray data;
+
+    for (const Column &c : columns) {
+        names.append(c.name);
+
+        QJsonObject col;
+        col["name"] = c.name;
+        col["type"] = typeName(c.type);
+
+        const Dictionary dict = buildDictionary(c);
+        if (dict.used) {
+            QJsonArray values;
+            if (c.type == Type::String) {
+                for (const QString &s : dict.stringValues) values.append(s);
+            } else {
+                for (qint64 v : dict.intValues)
+                    values.append(c.type == Type::Bool ? QJsonValue(v != 0) : QJsonValue(v));
+            }
+            QJsonArray codes;
+            for (quint8 code : dict.codes) codes.append(int(code));
+            col["dict"] = values;
+            col["codes"] = codes;
+        } else {
+            QJsonArray values;
+            switch (c.type) {
+            case Type::Int:    for (qint64 v : c.ints) values.append(v); break;
+            case Type::Bool:   for (qint64 v : c.ints) values.append(v != 0); break;
+            case Type::Float:  for (double v : c.floats) values.append(v); break;
+            case Type::String: for (const QString &s : c.strings) values.append(s); break;
+            }
+            col["values"] = values;
+        }
+
+        if (c.hasNulls) {
+            QByteArray bitmap = c.nulls;
+            bitmap.resize((rows + 7) / 8, '\0');
+            col["nulls"] = QString::fromLatin1(bitmap.toBase64());
+        }
+        data.append(col);
+    }
+
+    object["layout"] = "columnar";
+    object["columns"] = names;
+    object["rowCount"] = rows;
+    object["data"] = data;
+}
+
+// ===== CBOR =====
+
+void ColumnarResult::writeCbor(QCborStreamWriter &w) const
+{
+    w.append(QLatin1StringView("layout"));
+    w.append(QLatin1StringView("columnar"));
+
+    w.append(QLatin1StringView("columns"));
+    w.startArray(columns.size());
+    for (const Column &c : columns)
+        w.append(c.name);
+    w.endArray();
+
+    w.append(QLatin1StringView("rowCount"));
+    w.append(qint64(rows));
+
+    w.append(QLatin1StringView("data"));
+    w.startArray(columns.size());
+    for (const Column &c : columns) {
+        const Dictionary dict = buildDictionary(c);
+        w.startMap();
+        w.append(QLatin1StringView("name"));
+        w.append(c.name);
+        w.append(QLatin1StringView("type"));
+        w.append(typeName(c.type));
+
+        if (dict.used) {
+            w.append(QLatin1StringView("dict"));
+            if (c.type == Type::String) {
+                w.startArray(dict.stringValues.size());
+                for (const QString &s : dict.stringValues) w.append(s);
+            } else {
+                w.startArray(dict.intValues.size());
+                for (qint64 v : dict.intValues) {
+                    if (c.type == Type::Bool) w.append(v != 0);
+                    else                      w.append(v);
+                }
+            }
+            w.endArray();
+            // Ein Byte pro Zeile
+            w.append(QLatin1StringView("codes"));
+            w.append(QByteArray(reinterpret_cast<const char *>(dict.codes.constData()), dict.codes.size()));
+        } else {
+            w.append(QLatin1StringView("values"));
+            switch (c.type) {
+            case Type::Int:
+                w.startArray(c.ints.size());
+                for (qint64 v : c.ints) w.append(v);
+                break;
+            case Type::Bool:
+                w.startArray(c.ints.size());
+                for (qint64 v : c.ints) w.append(v != 0);
+                break;
+            case Type::Float:
+                w.startArray(c.floats.size());
+                for (double v : c.floats) w.append(v);
+                break;
+            case Type::String:
+                w.startArray(c.strings.size());
+                for (const QString &s : c.strings) w.append(s);
+                break;
+            }
+            w.endArray();
+        }
+
+        if (c.hasNulls) {
+            QByteArray bitmap = c.nulls;
+            bitmap.resize((rows + 7) / 8, '\0');
+            w.append(QLatin1StringView("nulls"));
+            w.append(bitmap);
+        }
+        w.endMap();
+    }
+    w.endArray();
+}
@@ -0,0 +1,74 @@
+#ifndef COLUMNARRESULT_H
+#define COLUMNARRESULT_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+class QCborStreamWriter;
+class QSqlQuery;
+
+// Abfrageergebnis spaltenweise (layout=columnar)
+//
+// Statt einer Map pro Zeile gibt es ein typisiertes Array pro Spalte:
+//
+//   {"name": "sales_price", "type": "float", "values": [1.49, 2.99, …]}
+//   {"name": "unit", "type": "string", "dict": ["ST", "KG"], "codes": [0, 0, 1, …]}
+//
+// Spalten mit wenigen verschiedenen Werten (unit, vat_code, active,
+// updated_by, …) werden automatisch als Dictionary kodiert. NULLs stehen
+// in einer Bitmap pro Spalte ("nulls", Bit i = Zeile i, LSB zuerst; in
+// JSON Base64), an ihrer Stelle steht in values/codes ein Platzhalter.
+// Spalten ohne NULL haben keine Bitmap.
+//
+// In CBOR sind codes (≤ 256 Einträge) und nulls Byte-Strings.
+class ColumnarResult
+{
+public:
+    // Zeilen einlesen — limit > 0: höchstens limit Zeilen, Rückgabe true,
+    // wenn danach noch eine Zeile folgt (Abfrage mit limit + 1)
+    bool read(QSqlQuery &query, int limit = 0);
+
+    int rowCount() const { return rows; }
+    int columnCount() const { return int(columns.size()); }
+
+    // Wert der letzten Zeile (z.B. nextAfter beim Keyset-Paging)
+    QVariant lastValue(int column) const;
+
+    // "layout", "columns", "rowCount" und "data" in ein JSON-Objekt eintragen
+    void addToJson(QJsonObject &object) const;
+    // Dieselben Schlüssel in eine geöffnete CBOR-Map schreiben
+    void writeCbor(QCborStreamWriter &writer) const;
+
+private:
+    enum class Type { Int, Float, Bool, String };
+
+    struct Column {
+        QString name;
+        Type type = Type::String;
+        QVector<qint64> ints;       // Int, Bool
+        QVector<double> floats;     // Float
+        QVector<QString> strings;   // String (auch Datum als ISO-String)
+        QByteArray nulls;           // Bitmap, leer solange kein NULL kam
+        bool hasNulls = false;
+    };
+
+    struct Dictionary {
+        bool used = false;
+        QVector<qint64> intValues;
+        QVector<QString> stringValues;
+        QVector<quint8> codes;
+    };
+
+    static Type typeFor(const QMetaType &type);
+    static QString typeName(Type type);
+    void append(Column &column, const QVariant &value);
+    Dictionary buildDictionary(const Column &column) const;
+
+    QVector<Column> columns;
+    int rows = 0;
+};
+
+#endif // COLUMNARRESULT_H
@@ -0,0 +1,75 @@
+#include "connectiontracker.h"
+#include <QHttpServerRequest>
+#include <cstring>
+#include <functional>
+
+namespace {
+
+// Socket, der die Statuszeile jeder Antwort erkennt. QHttpServer schreibt
+// Statuszeile und Header einer Antwort in einem Stück, Bodies getrennt —
+// ein Body, der selbst mit "HTTP/1.x NNN " beginnt, würde mitgezählt.
+class ResponseSocket : public QTcpSocket
+{
+public:
+    using QTcpSocket::QTcpSocket;
+
+    std::function<void(int)> onStatus;
+
+protected:
+    qint64 writeData(const char *data, qint64 len) override
+    {
+        if (onStatus && len >= 13 && std::memcmp(data, "HTTP/1.", 7) == 0 && data[8] == ' '
+            && data[12] == ' ') {
+            int status = 0;
+            for (int i = 9; i < 12 && status >= 0; ++i)
+                status = data[i] >= '0' && data[i] <= '9' ? status * 10 + (data[i] - '0') : -1;
+            if (status > 0)
+                onStatus(status);
+        }
+        return QTcpSocket::writeData(data, len);
+    }
+};
+
+} // namespace
+
+ConnectionTracker::ConnectionTracker(QObject *parent)
+    : QTcpServer(parent)
+{
+}
+
+void ConnectionTracker::incomingConnection(qintptr socketDescriptor)
+{
+    ResponseSocket *socket = new ResponseSocket(this);
+    if (!socket->setSocketDescriptor(socketDescriptor)) {
+        delete socket;
+        return;
+    }
+
+    const QString k = key(socket->peerAddress(), socket->peerPort());
+    sockets.insert(k, socket);
+    socket->onStatus = [this, k](int status) { emit responseStarted(k, status); };
+
+    connect(socket, &QTcpSocket::disconnected, this, [this, k, socket]() {
+        if (sockets.value(k) == socket)
+            sockets.remove(k);
+        emit connectionClosed(k);
+    });
+
+    // QHttpServer übernimmt den Socket wie gewohnt über nextPendingConnection()
+    addPendingConnection(socket);
+}
+
+QTcpSocket *ConnectionTracker::socketFor(const QHttpServerRequest &request) const
+{
+    return sockets.value(connectionKey(request)).data();
+}
+
+QString ConnectionTracker::connectionKey(const QHttpServerRequest &request)
+{
+    return key(request.remoteAddress(), request.remotePort());
+}
+
+QString ConnectionTracker::key(const QHostAddress &address, quint16 port)
+{
+    return address.toString() + QLatin1Char('/') + QString::number(port);
+}
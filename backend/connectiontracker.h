@@ -0,0 +1,50 @@
+#ifndef CONNECTIONTRACKER_H
+#define CONNECTIONTRACKER_H
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHash>
+#include <QPointer>
+
+class QHttpServerRequest;
+
+// TCP-Server, der seine Client-Sockets kennt
+//
+// QHttpServer gibt den Socket eines Requests nicht heraus. Für Streaming
+// (Backpressure über bytesToWrite) und Abbruch bei Client-Disconnect wird
+// er aber gebraucht — daher legt dieser Server die Sockets selbst an und
+// ordnet sie über Remote-Adresse + Port den Requests zu.
+//
+// Außerdem meldet er den Beginn jeder Antwort (Statuszeile) und das Ende
+// jeder Verbindung — für den Traffic-Mitschnitt, unabhängig davon, ob die
+// Route synchron oder über einen Responder antwortet.
+class ConnectionTracker : public QTcpServer
+{
+    Q_OBJECT
+
+public:
+    explicit ConnectionTracker(QObject *parent = nullptr);
+
+    // Socket zum Request oder nullptr (bereits geschlossen)
+    QTcpSocket *socketFor(const QHttpServerRequest &request) const;
+
+    int openConnections() const { return sockets.size(); }
+
+    // Schlüssel der Verbindung eines Requests (Remote-Adresse + Port)
+    static QString connectionKey(const QHttpServerRequest &request);
+
+signals:
+    // Statuszeile einer Antwort geschrieben (HTTP/1.x, in Request-Reihenfolge)
+    void responseStarted(const QString &connection, int status);
+    void connectionClosed(const QString &connection);
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+
+private:
+    static QString key(const QHostAddress &address, quint16 port);
+
+    QHash<QString, QPointer<QTcpSocket>> sockets;
+};
+
+#endif // CONNECTIONTRACKER_H
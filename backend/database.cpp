@@ -1,16 +1,40 @@
 #include "database.h"
+#include "logger.h"
+#include "schemamigrator.h"
+#include "columnarresult.h"
+#include "productstats.h"
+#include "catalogsnapshot.h"
+#include "replicarouter.h"
+#include "requestcontext.h"
+#include "queryguard.h"
 #include <QDebug>
 #include <QSqlRecord>
+#include <QThread>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QCborStreamWriter>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <limits>
+#include <vector>
 
 Database::Database(QObject *parent)
     : QObject(parent)
 {
+    // Worker-Pool für parallele Lesezugriffe — Threads laufen dauerhaft,
+    // damit ihre DB-Verbindungen nicht ständig neu aufgebaut werden
+    const int poolSize = qEnvironmentVariableIntValue("DB_POOL_SIZE");
+    workerPool.setMaxThreadCount(poolSize > 0 ? poolSize : 4);
+    workerPool.setExpiryTimeout(-1);
+
+    guard = new QueryGuard(this);
 }
 
 Database::~Database()
 {
+    replicaProbeTimer.stop();
+    workerPool.waitForDone();
     if (db.isOpen()) {
         db.close();
     }
@@ -53,37 +77,40 @@ bool Database::connect()
         return false;
     }
     
-    qInfo() << "Datenbank verbunden:" << db.databaseName();
+    qCInfo(lcDb) << "Datenbank verbunden:" << db.databaseName();
+    setupReplicas();
     return true;
 }
 
 QString Database::getGreeting(const QString &language)
 {
     if (!isConnected()) {
-        qWarning() << "Keine Datenbankverbindung!";
+        qCWarning(lcDb) << "Keine Datenbankverbindung!";
         return "Error: No database connection";
     }
     
-    QSqlQuery query(db);
-    
     // Prepared Statement für Sicherheit
-    query.prepare("SELECT message FROM greetings WHERE language = :lang LIMIT 1");
-    query.bindValue(":lang", language);
+    bool ok = false;
+    QSqlQuery query = execRead([&](QSqlQuery &q) {
+        q.prepare("SELECT message FROM greetings WHERE language = :lang LIMIT 1");
+        q.bindValue(":lang", language);
+        return q.exec();
+    }, &ok);
     
-    if (!query.exec()) {
+    if (!ok) {
         logError("Greeting abrufen", query.lastError());
         return "Error loading greeting";
     }
     
     if (query.next()) {
         QString message = query.value("message").toString();
-        qDebug() << "Greeting gefunden:" << message << "(" << language << ")";
+        qCDebug(lcDb) << "Greeting gefunden:" << message << "(" << language << ")";
         return message;
     }
     
     // Fallback auf Deutsch wenn Sprache nicht gefunden
     if (language != "de") {
-        qWarning() << "Sprache nicht gefunden:" << language << "- Fallback auf Deutsch";
+        qCWarning(lcDb) << "Sprache nicht gefunden:" << language << "- Fallback auf Deutsch";
         return getGreeting("de");
     }
     
@@ -95,32 +122,117 @@ QStringList Database::getTables()
     QStringList tables;
     if (!isConnected()) return tables;
 
-    QSqlQuery query(db);
-    query.exec("SELECT table_name FROM information_schema.tables "
-               "WHERE table_schema = 'public' ORDER BY table_name");
+    bool ok = false;
+    QSqlQuery query = execRead([](QSqlQuery &q) {
+        return q.exec("SELECT table_name FROM information_schema.tables "
+                      "WHERE table_schema = 'public' ORDER BY table_name");
+    }, &ok);
     while (query.next()) {
         tables << query.value(0).toString();
     }
     return tables;
 }
 
-QJsonObject Database::getTableData(const QString &tableName)
+// Wert einer Spalte als CBOR: Zahlen binär, NULL → null, Zeitstempel als
+// Tag 0 mit demselben ISO-String wie im JSON
+static void writeCborValue(QCborStreamWriter &w, const QVariant &v)
+{
+    if (v.isNull()) { w.appendNull(); return; }
+
+    switch (v.metaType().id()) {
+    case QMetaType::Bool:
+        w.append(v.toBool());
+        break;
+    case QMetaType::Short:
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+        w.append(v.toLongLong());
+        break;
+    case QMetaType::UShort:
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+        w.append(v.toULongLong());
+        break;
+    case QMetaType::Float:
+    case QMetaType::Double:
+        w.append(v.toDouble());
+        break;
+    case QMetaType::QDateTime:
+        w.append(QCborKnownTags::DateTimeString);
+        w.append(v.toDateTime().toString(Qt::ISODateWithMs));
+        break;
+    case QMetaType::QByteArray:
+        w.append(v.toByteArray());
+        break;
+    default:
+        w.append(v.toString());
+        break;
+    }
+}
+
+// Spaltennamen als CBOR-Array
+static void writeCborColumns(QCborStreamWriter &w, const QSqlRecord &rec)
+{
+    w.append(QLatin1StringView("columns"));
+    w.startArray(rec.count());
+    for (int i = 0; i < rec.count(); ++i)
+        w.append(rec.fieldName(i));
+    w.endArray();
+}
+
+// Eine Zeile als CBOR-Map (Spaltenname → Wert), direkt aus der Abfrage
+static void writeCborRow(QCborStreamWriter &w, const QSqlQuery &q, const QSqlRecord &rec)
+{
+    w.startMap(rec.count());
+    for (int i = 0; i < rec.count(); ++i) {
+        w.append(rec.fieldName(i));
+        writeCborValue(w, q.value(i));
+    }
+    w.endMap();
+}
+
+bool Database::execTableQuery(QSqlQuery &query, const QString &tableName, int limit, QString *error)
 {
-    QJsonObject result;
     if (!isConnected()) {
-        result["error"] = "Keine Datenbankverbindung";
-        return result;
+        *error = "Keine Datenbankverbindung";
+        return false;
     }
 
     // Whitelist: nur existierende Tabellen erlauben (SQL-Injection-Schutz)
     QStringList validTables = getTables();
+    if (QueryGuard::lastReason() != QueryGuard::Reason::None) {
+        *error = QueryGuard::lastMessage();
+        return false;
+    }
     if (!validTables.contains(tableName)) {
-        result["error"] = "Tabelle nicht gefunden: " + tableName;
-        return result;
+        *error = "Tabelle nicht gefunden: " + tableName;
+        return false;
     }
 
-    QSqlQuery query(db);
-    query.exec(QString("SELECT * FROM %1 LIMIT 200").arg(tableName));
+    bool ok = false;
+    query = execRead([&](QSqlQuery &q) {
+        q.setForwardOnly(true);
+        return q.exec(QString("SELECT * FROM %1 LIMIT %2").arg(tableName).arg(limit));
+    }, &ok);
+    if (!ok) {
+        logError("Tabellendaten abrufen", query.lastError());
+        *error = readError(query);
+        return false;
+    }
+    return true;
+}
+
+QJsonObject Database::getTableData(const QString &tableName, int limit)
+{
+    QJsonObject result;
+    QString error;
+    QSqlQuery query(connection());
+    if (!execTableQuery(query, tableName, limit, &error)) {
+        result["error"] = error;
+        return result;
+    }
 
     // Spalten auslesen
     QSqlRecord rec = query.record();
@@ -146,6 +258,47 @@ QJsonObject Database::getTableData(const QString &tableName)
     return result;
 }
 
+QByteArray Database::getTableDataCbor(const QString &tableName, int limit, QString *error)
+{
+    QSqlQuery query(connection());
+    if (!execTableQuery(query, tableName, limit, error))
+        return QByteArray();
+
+    // Gleiche Struktur wie getTableData(); Zeilen gehen ohne Zwischenobjekte
+    // direkt in den Writer. columns steht vor rows (Decoder verlässt sich darauf).
+    QByteArray out;
+    QCborStreamWriter w(&out);
+    const QSqlRecord rec = query.record();
+
+    w.startMap();
+    w.append(QLatin1StringView("table"));
+    w.append(tableName);
+    writeCborColumns(w, rec);
+
+    w.append(QLatin1StringView("rows"));
+    w.startArray();
+    qint64 rowCount = 0;
+    while (query.next()) {
+        writeCborRow(w, query, rec);
+        ++rowCount;
+    }
+    w.endArray();
+
+    w.append(QLatin1StringView("rowCount"));
+    w.append(rowCount);
+    w.endMap();
+    return out;
+}
+
+bool Database::readTableColumnar(const QString &tableName, int limit, ColumnarResult &result, QString *error)
+{
+    QSqlQuery query(connection());
+    if (!execTableQuery(query, tableName, limit, error))
+        return false;
+    result.read(query);
+    return true;
+}
+
 QJsonObject Database::getRowById(const QString &tableName, int id)
 {
     QJsonObject result;
@@ -160,11 +313,14 @@ QJsonObject Database::getRowById(const QString &tableName, int id)
         return result;
     }
 
-    QSqlQuery query(db);
-    query.prepare(QString("SELECT * FROM %1 WHERE id = :id").arg(tableName));
-    query.bindValue(":id", id);
+    bool ok = false;
+    QSqlQuery query = execRead([&](QSqlQuery &q) {
+        q.prepare(QString("SELECT * FROM %1 WHERE id = :id").arg(tableName));
+        q.bindValue(":id", id);
+        return q.exec();
+    }, &ok);
 
-    if (!query.exec() || !query.next()) {
+    if (!ok || !query.next()) {
         result["error"] = "Datensatz nicht gefunden";
         return result;
     }
@@ -178,96 +334,62 @@ QJsonObject Database::getRowById(const QString &tableName, int id)
 
 // ===== PRODUCT CRUD =====
 
-void Database::initProductTable()
-{
-    if (!isConnected()) return;
-
-    QSqlQuery q(db);
-
-    // Tabelle anlegen (PostgreSQL-Syntax, Oracle-kompatible Struktur)
-    bool ok = q.exec(R"(
-        CREATE TABLE IF NOT EXISTS product (
-            product_id   SERIAL PRIMARY KEY,
-            product_number VARCHAR(20) UNIQUE NOT NULL,
-            gtin         BIGINT,
-            name         VARCHAR(100) NOT NULL,
-            unit         VARCHAR(2) NOT NULL DEFAULT 'ST',
-            category_id  INTEGER,
-            supplier_id  INTEGER,
-            purchase_price NUMERIC(10,2),
-            sales_price  NUMERIC(10,2) NOT NULL,
-            vat_code     SMALLINT NOT NULL DEFAULT 2,
-            description  VARCHAR(500),
-            active       SMALLINT NOT NULL DEFAULT 1,
-            created_at   TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-            updated_at   TIMESTAMP,
-            updated_by   VARCHAR(25)
-        )
-    )");
-    if (!ok) { logError("Product-Tabelle erstellen", q.lastError()); return; }
-
-    q.exec("CREATE INDEX IF NOT EXISTS idx_product_number ON product(product_number)");
-    q.exec("CREATE INDEX IF NOT EXISTS idx_gtin ON product(gtin)");
-    q.exec("CREATE INDEX IF NOT EXISTS idx_category ON product(category_id)");
-
-    // Beispieldaten nur einfügen wenn Tabelle leer
-    QSqlQuery countQ(db);
-    countQ.exec("SELECT COUNT(*) FROM product");
-    if (!countQ.next() || countQ.value(0).toInt() > 0) return;
-
-    struct Sample {
-        const char *number, *gtin, *name, *unit, *desc;
-        double purchase, sales;
-        int vatCode;
-    };
-    Sample samples[] = {
-        {"P001", "4008400401584", "Mineralwasser Classic 0,5l",    "ST",
-         "Natuerliches Mineralwasser, 0,5 Liter PET-Flasche",       0.29, 0.49, 1},
-        {"P002", "4001690019002", "Kartoffelchips Salz 150g",       "ST",
-         "Kartoffelchips mit Meersalz, 150g Tuete",                  0.79, 1.29, 1},
-        {"P003", "4006591000011", "Langkornreis 1kg",               "ST",
-         "Parboiled Langkornreis, 1 kg Packung",                     1.29, 1.99, 1},
-        {"P004", "7622210951939", "Vollmilch-Schokolade 100g",      "ST",
-         "Zartschmelzende Vollmilch-Schokolade, 100g Tafel",         0.89, 1.49, 1},
-        {"P005", "4026608000020", "Vollkornbrot 500g",              "ST",
-         "Saftiges Vollkornbrot, 500g, in Scheiben",                 1.49, 2.29, 1}
-    };
+bool Database::migrateSchema()
+{
+    if (!isConnected()) return false;
+
+    SchemaMigrator migrator(connection());
+    return migrator.migrate();
+}
+
+bool Database::execProductsQuery(QSqlQuery &q, int afterId, int limit, QString *error)
+{
+    if (!isConnected()) { *error = "Keine Datenbankverbindung"; return false; }
 
-    for (const auto &s : samples) {
-        QSqlQuery ins(db);
-        ins.prepare(
-            "INSERT INTO product "
-            "(product_number, gtin, name, unit, purchase_price, sales_price, vat_code, description) "
-            "VALUES (:num, :gtin, :name, :unit, :pp, :sp, :vc, :desc)"
-        );
-        ins.bindValue(":num",  QString(s.number));
-        ins.bindValue(":gtin", QString(s.gtin).toLongLong());
-        ins.bindValue(":name", QString(s.name));
-        ins.bindValue(":unit", QString(s.unit));
-        ins.bindValue(":pp",   s.purchase);
-        ins.bindValue(":sp",   s.sales);
-        ins.bindValue(":vc",   s.vatCode);
-        ins.bindValue(":desc", QString(s.desc));
-        if (!ins.exec()) logError("Beispielprodukt einfuegen", ins.lastError());
+    // Keyset-Paging über product_id: eine Zeile mehr holen als angefordert,
+    // um ohne COUNT(*) zu wissen, ob es weitergeht
+    QString sql = "SELECT product_id, product_number, gtin, name, unit, category_id, supplier_id, "
+                  "purchase_price, sales_price, vat_code, description, active, "
+                  "created_at, updated_at, updated_by, row_version FROM product "
+                  "WHERE product_id > :after ORDER BY product_id";
+    if (limit > 0) {
+        sql += db.driverName() == "QOCI"
+                   ? QString(" FETCH FIRST %1 ROWS ONLY").arg(limit + 1)
+                   : QString(" LIMIT %1").arg(limit + 1);
     }
-    qInfo() << "5 Beispielprodukte in product-Tabelle eingefuegt";
+
+    bool ok = false;
+    q = execRead([&](QSqlQuery &query) {
+        query.setForwardOnly(true);
+        query.prepare(sql);
+        query.bindValue(":after", afterId);
+        return query.exec();
+    }, &ok);
+    if (!ok) {
+        logError("getProducts", q.lastError());
+        *error = readError(q);
+        return false;
+    }
+    return true;
 }
 
-QJsonObject Database::getProducts()
+QJsonObject Database::getProducts(int afterId, int limit)
 {
     QJsonObject result;
-    if (!isConnected()) { result["error"] = "Keine Datenbankverbindung"; return result; }
-
-    QSqlQuery q(db);
-    q.exec("SELECT product_id, product_number, gtin, name, unit, category_id, supplier_id, "
-           "purchase_price, sales_price, vat_code, description, active, "
-           "created_at, updated_at, updated_by FROM product ORDER BY product_id");
+    QString error;
+    QSqlQuery q(connection());
+    if (!execProductsQuery(q, afterId, limit, &error)) {
+        result["error"] = error;
+        return result;
+    }
 
     QSqlRecord rec = q.record();
     QJsonArray columns, rows;
     for (int i = 0; i < rec.count(); ++i) columns.append(rec.fieldName(i));
 
+    bool hasMore = false;
     while (q.next()) {
+        if (limit > 0 && rows.size() == limit) { hasMore = true; break; }
         QJsonObject row;
         for (int i = 0; i < rec.count(); ++i)
             row[rec.fieldName(i)] = QJsonValue::fromVariant(q.value(i));
@@ -277,21 +399,192 @@ QJsonObject Database::getProducts()
     result["products"] = rows;
     result["columns"]  = columns;
     result["count"]    = rows.size();
+    if (limit > 0) {
+        result["hasMore"] = hasMore;
+        if (!rows.isEmpty())
+            result["nextAfter"] = rows.last().toObject()["product_id"];
+    }
     return result;
 }
 
+QByteArray Database::getProductsCbor(int afterId, int limit, QString *error)
+{
+    QSqlQuery q(connection());
+    if (!execProductsQuery(q, afterId, limit, error))
+        return QByteArray();
+
+    // Gleiche Struktur wie getProducts(), Zeilen direkt in den Writer
+    QByteArray out;
+    QCborStreamWriter w(&out);
+    const QSqlRecord rec = q.record();
+
+    w.startMap();
+    writeCborColumns(w, rec);
+
+    w.append(QLatin1StringView("products"));
+    w.startArray();
+    qint64 count = 0;
+    QVariant lastId;
+    bool hasMore = false;
+    while (q.next()) {
+        if (limit > 0 && count == limit) { hasMore = true; break; }
+        writeCborRow(w, q, rec);
+        lastId = q.value(0);   // product_id
+        ++count;
+    }
+    w.endArray();
+
+    w.append(QLatin1StringView("count"));
+    w.append(count);
+    if (limit > 0) {
+        w.append(QLatin1StringView("hasMore"));
+        w.append(hasMore);
+        if (count > 0) {
+            w.append(QLatin1StringView("nextAfter"));
+            writeCborValue(w, lastId);
+        }
+    }
+    w.endMap();
+    return out;
+}
+
+bool Database::readProductsColumnar(int afterId, int limit, ColumnarResult &result, bool *hasMore, QString *error)
+{
+    QSqlQuery q(connection());
+    if (!execProductsQuery(q, afterId, limit, error))
+        return false;
+    *hasMore = result.read(q, limit);
+    return true;
+}
+
+bool Database::loadProductSnapshot(ProductSnapshot &snapshot, QString *error)
+{
+    if (!isConnected()) { *error = "Keine Datenbankverbindung"; return false; }
+
+    bool ok = false;
+    QSqlQuery q = execRead([](QSqlQuery &query) {
+        query.setForwardOnly(true);
+        return query.exec("SELECT category_id, supplier_id, purchase_price, sales_price, vat_code FROM product");
+    }, &ok);
+    if (!ok) {
+        logError("loadProductSnapshot", q.lastError());
+        *error = readError(q);
+        return false;
+    }
+    snapshot = ProductSnapshot::fromQuery(q);
+    return true;
+}
+
+bool Database::catchUpProductSnapshot(const CatalogSnapshot &catalog, ProductSnapshot &snapshot,
+                                      qint64 *changed, QString *error)
+{
+    // Zeilen, die mehr als so oft geändert sind, lieber komplett neu laden
+    static const double MaxChangedShare = 0.5;
+    // product_ids pro Nachlade-Abfrage
+    static const int FetchBatch = 1000;
+
+    if (!isConnected()) { *error = "Keine Datenbankverbindung"; return false; }
+    QElapsedTimer timer;
+    timer.start();
+
+    // Nur zwei Ganzzahlen je Zeile statt der ganzen Tabelle
+    bool ok = false;
+    QSqlQuery versions = execRead([](QSqlQuery &query) {
+        query.setForwardOnly(true);
+        return query.exec("SELECT product_id, row_version FROM product ORDER BY product_id");
+    }, &ok);
+    if (!ok) {
+        logError("catchUpProductSnapshot", versions.lastError());
+        *error = readError(versions);
+        return false;
+    }
+
+    // Merge-Join: Datei und Abfrage sind beide nach product_id sortiert
+    const qint64 rows = catalog.rowCount();
+    std::vector<bool> keep(size_t(rows), false);
+    QList<qint64> fetch;
+    qint64 row = 0, kept = 0, updated = 0;
+    while (versions.next()) {
+        const qint64 id = versions.value(0).toLongLong();
+        const qint64 version = versions.value(1).toLongLong();
+        while (row < rows && catalog.record(row).productId < id)
+            ++row;                                        // in der DB gelöscht
+        if (row < rows && catalog.record(row).productId == id) {
+            if (catalog.record(row).rowVersion == version) {
+                keep[size_t(row)] = true;
+                ++kept;
+            } else {
+                fetch.append(id);                         // geändert
+                ++updated;
+            }
+            ++row;
+        } else {
+            fetch.append(id);                             // neu
+        }
+    }
+    const qint64 deleted = rows - kept - updated;
+    *changed = fetch.size() + deleted;
+
+    if (fetch.size() > (kept + fetch.size()) * MaxChangedShare)
+        return loadProductSnapshot(snapshot, error);
+
+    snapshot.reserve(kept + fetch.size());
+    for (qint64 i = 0; i < rows; ++i) {
+        if (keep[size_t(i)])
+            catalog.appendTo(snapshot, i);
+    }
+
+    for (qsizetype start = 0; start < fetch.size(); start += FetchBatch) {
+        QStringList ids;
+        for (qsizetype i = start; i < qMin(fetch.size(), start + FetchBatch); ++i)
+            ids << QString::number(fetch.at(i));
+        QSqlQuery q = execRead([&](QSqlQuery &query) {
+            query.setForwardOnly(true);
+            return query.exec("SELECT category_id, supplier_id, purchase_price, sales_price, vat_code "
+                              "FROM product WHERE product_id IN (" + ids.join(',') + ")");
+        }, &ok);
+        if (!ok) {
+            logError("catchUpProductSnapshot", q.lastError());
+            *error = readError(q);
+            return false;
+        }
+        snapshot.appendRows(q);
+    }
+
+    snapshot.finish(timer.elapsed());
+    return true;
+}
+
+bool Database::writeCatalogSnapshot(const QString &path, qint64 *rows, QString *error)
+{
+    if (!isConnected()) { *error = "Keine Datenbankverbindung"; return false; }
+
+    bool ok = false;
+    QSqlQuery q = execRead([](QSqlQuery &query) {
+        query.setForwardOnly(true);
+        return query.exec(QString("SELECT %1 FROM product ORDER BY product_id")
+                              .arg(QLatin1StringView(CatalogSnapshot::selectColumns())));
+    }, &ok);
+    if (!ok) {
+        logError("writeCatalogSnapshot", q.lastError());
+        *error = readError(q);
+        return false;
+    }
+    return CatalogSnapshot::write(path, q, rows, error);
+}
+
 QJsonObject Database::insertProduct(const QJsonObject &data, const QString &updatedBy)
 {
     QJsonObject result;
     if (!isConnected()) { result["error"] = "Keine Datenbankverbindung"; return result; }
 
-    QSqlQuery q(db);
+    QSqlQuery q(connection());
     q.prepare(
         "INSERT INTO product "
         "(product_number, gtin, name, unit, category_id, supplier_id, "
         " purchase_price, sales_price, vat_code, description, active, updated_by) "
         "VALUES (:num, :gtin, :name, :unit, :cat, :sup, :pp, :sp, :vc, :desc, :active, :by) "
-        "RETURNING product_id"
+        "RETURNING product_id, row_version"
     );
 
     q.bindValue(":num",    data["product_number"].toString());
@@ -313,9 +606,10 @@ QJsonObject Database::insertProduct(const QJsonObject &data, const QString &upda
         return result;
     }
 
-    result["success"]    = true;
-    result["product_id"] = q.value(0).toInt();
-    result["message"]    = "Produkt erfolgreich angelegt";
+    result["success"]     = true;
+    result["product_id"]  = q.value(0).toInt();
+    result["row_version"] = q.value(1).toLongLong();
+    result["message"]     = "Produkt erfolgreich angelegt";
     return result;
 }
 
@@ -324,14 +618,17 @@ QJsonObject Database::updateProduct(int productId, const QJsonObject &data, cons
     QJsonObject result;
     if (!isConnected()) { result["error"] = "Keine Datenbankverbindung"; return result; }
 
-    QSqlQuery q(db);
-    q.prepare(
+    // Neue row_version (Trigger, Migration 7) wie bei patchProduct()
+    const bool returning = db.driverName() == "QPSQL";
+    QSqlQuery q(connection());
+    q.prepare(QString(
         "UPDATE product SET "
         "  product_number = :num, gtin = :gtin, name = :name, unit = :unit, "
         "  category_id = :cat, supplier_id = :sup, purchase_price = :pp, "
         "  sales_price = :sp, vat_code = :vc, description = :desc, "
-        "  active = :active, updated_at = CURRENT_TIMESTAMP, updated_by = :by "
-        "WHERE product_id = :id"
+        "  active = :active, "
+        "  updated_at = CURRENT_TIMESTAMP, updated_by = :by "
+        "WHERE product_id = :id") + (returning ? " RETURNING row_version" : "")
     );
 
     q.bindValue(":num",    data["product_number"].toString());
@@ -353,10 +650,182 @@ QJsonObject Database::updateProduct(int productId, const QJsonObject &data, cons
         result["error"] = q.lastError().text();
         return result;
     }
-    if (q.numRowsAffected() == 0) { result["error"] = "Produkt nicht gefunden"; return result; }
+    if (returning ? !q.next() : q.numRowsAffected() == 0) { result["error"] = "Produkt nicht gefunden"; return result; }
 
-    result["success"] = true;
-    result["message"] = "Produkt erfolgreich aktualisiert";
+    qint64 version = -1;
+    if (returning) {
+        version = q.value(0).toLongLong();
+    } else {
+        QString error;
+        if (!readRowVersion(productId, &version, &error)) {
+            result["error"] = error;
+            return result;
+        }
+    }
+
+    result["success"]     = true;
+    result["product_id"]  = productId;
+    result["row_version"] = version;
+    result["message"]     = "Produkt erfolgreich aktualisiert";
+    return result;
+}
+
+QJsonObject Database::getProduct(int productId)
+{
+    QJsonObject result;
+    if (!isConnected()) { result["error"] = "Keine Datenbankverbindung"; return result; }
+
+    bool ok = false;
+    QSqlQuery q = execRead([&](QSqlQuery &query) {
+        query.prepare("SELECT product_id, product_number, gtin, name, unit, category_id, supplier_id, "
+                      "purchase_price, sales_price, vat_code, description, active, "
+                      "created_at, updated_at, updated_by, row_version FROM product WHERE product_id = :id");
+        query.bindValue(":id", productId);
+        return query.exec();
+    }, &ok);
+    if (!ok) {
+        logError("Produkt laden", q.lastError());
+        result["error"] = readError(q);
+        return result;
+    }
+    if (!q.next()) {
+        result["error"] = "Produkt nicht gefunden";
+        result["notFound"] = true;
+        return result;
+    }
+
+    const QSqlRecord rec = q.record();
+    for (int i = 0; i < rec.count(); ++i)
+        result[rec.fieldName(i)] = QJsonValue::fromVariant(q.value(i));
+    return result;
+}
+
+QJsonObject Database::patchProduct(int productId, const QJsonObject &fields, qint64 expectedVersion,
+                                   const QString &updatedBy)
+{
+    // Änderbare Spalten (JSON-Name = Spaltenname) — alles andere wird abgewiesen
+    struct Column { const char *name; QMetaType::Type type; bool nullable; };
+    static const Column columns[] = {
+        { "product_number", QMetaType::QString,   false },
+        { "gtin",           QMetaType::LongLong,  true  },
+        { "name",           QMetaType::QString,   false },
+        { "unit",           QMetaType::QString,   false },
+        { "category_id",    QMetaType::Int,       true  },
+        { "supplier_id",    QMetaType::Int,       true  },
+        { "purchase_price", QMetaType::Double,    true  },
+        { "sales_price",    QMetaType::Double,    false },
+        { "vat_code",       QMetaType::Int,       false },
+        { "description",    QMetaType::QString,   true  },
+        { "active",         QMetaType::Int,       false },
+    };
+
+    QJsonObject result;
+    if (!isConnected()) { result["error"] = "Keine Datenbankverbindung"; return result; }
+    if (fields.isEmpty()) { result["error"] = "Keine Felder zum Aktualisieren"; return result; }
+
+    QStringList assignments;
+    QVariantList values;
+    for (auto it = fields.begin(); it != fields.end(); ++it) {
+        const Column *col = nullptr;
+        for (const Column &c : columns) {
+            if (it.key() == QLatin1StringView(c.name)) { col = &c; break; }
+        }
+        if (!col) {
+            result["error"] = "Feld nicht änderbar: " + it.key();
+            return result;
+        }
+
+        const QJsonValue v = it.value();
+        QVariant value;
+        if (v.isNull()) {
+            if (!col->nullable) {
+                result["error"] = "Feld darf nicht leer sein: " + it.key();
+                return result;
+            }
+            value = QVariant(QMetaType(col->type));   // typisiertes NULL
+        } else if (col->type == QMetaType::QString ? !v.isString() : !v.isDouble()) {
+            result["error"] = "Ungültiger Wert für " + it.key();
+            return result;
+        } else if (col->type == QMetaType::QString) {
+            value = v.toString();
+        } else if (col->type == QMetaType::Double) {
+            value = v.toDouble();
+        } else {
+            // toInteger() liefert für 1.5 still 0 — nur ganze Zahlen im Spaltenbereich
+            const qint64 n = v.toInteger();
+            if (double(n) != v.toDouble()
+                || (col->type == QMetaType::Int
+                    && (n < std::numeric_limits<int>::min() || n > std::numeric_limits<int>::max()))) {
+                result["error"] = "Ungültiger Wert für " + it.key();
+                return result;
+            }
+            value = col->type == QMetaType::Int ? QVariant(int(n)) : QVariant(n);
+        }
+        assignments << QString("%1 = :v%2").arg(col->name).arg(values.size());
+        values << value;
+    }
+
+    // Nur die geänderten Spalten: kleineres WAL, HOT-Updates bleiben möglich,
+    // solange keine indizierte Spalte dabei ist. row_version zählt der
+    // Trigger hoch (Migration 7)
+    QString sql = "UPDATE product SET " + assignments.join(", ")
+                  + ", updated_at = CURRENT_TIMESTAMP, updated_by = :by "
+                    "WHERE product_id = :id";
+    if (expectedVersion >= 0)
+        sql += " AND row_version = :expected";
+    // Oracle kennt kein RETURNING ohne INTO — neue Version danach in derselben
+    // Transaktion lesen (der WriteBatcher hält sie offen, die Zeile ist gesperrt)
+    const bool returning = db.driverName() == "QPSQL";
+    if (returning)
+        sql += " RETURNING row_version";
+
+    QSqlQuery q(connection());
+    q.prepare(sql);
+    for (int i = 0; i < values.size(); ++i)
+        q.bindValue(QString(":v%1").arg(i), values.at(i));
+    q.bindValue(":by", updatedBy.isEmpty() ? QVariant() : updatedBy);
+    q.bindValue(":id", productId);
+    if (expectedVersion >= 0)
+        q.bindValue(":expected", expectedVersion);
+
+    if (!q.exec()) {
+        logError("Produkt teilweise aktualisieren", q.lastError());
+        result["error"] = q.lastError().text();
+        return result;
+    }
+
+    const bool updated = returning ? q.next() : q.numRowsAffected() > 0;
+    if (!updated) {
+        // Keine Zeile geändert: gibt es das Produkt nicht, oder ist die Version veraltet?
+        QSqlQuery check(connection());
+        check.prepare("SELECT row_version FROM product WHERE product_id = :id");
+        check.bindValue(":id", productId);
+        if (check.exec() && check.next()) {
+            result["error"] = "Produkt wurde inzwischen geändert";
+            result["conflict"] = true;
+            result["row_version"] = check.value(0).toLongLong();
+        } else {
+            result["error"] = "Produkt nicht gefunden";
+            result["notFound"] = true;
+        }
+        return result;
+    }
+
+    qint64 version = -1;
+    if (returning) {
+        version = q.value(0).toLongLong();
+    } else {
+        QString error;
+        if (!readRowVersion(productId, &version, &error)) {
+            result["error"] = error;
+            return result;
+        }
+    }
+
+    result["success"]     = true;
+    result["product_id"]  = productId;
+    result["row_version"] = version;
+    result["message"]     = "Produkt erfolgreich aktualisiert";
     return result;
 }
 
@@ -365,7 +834,7 @@ QJsonObject Database::deleteProduct(int productId)
     QJsonObject result;
     if (!isConnected()) { result["error"] = "Keine Datenbankverbindung"; return result; }
 
-    QSqlQuery q(db);
+    QSqlQuery q(connection());
     q.prepare("DELETE FROM product WHERE product_id = :id");
     q.bindValue(":id", productId);
 
@@ -376,11 +845,271 @@ QJsonObject Database::deleteProduct(int productId)
     }
     if (q.numRowsAffected() == 0) { result["error"] = "Produkt nicht gefunden"; return result; }
 
-    result["success"] = true;
-    result["message"] = "Produkt erfolgreich geloescht";
+    result["success"]    = true;
+    result["product_id"] = productId;
+    result["message"]    = "Produkt erfolgreich geloescht";
     return result;
 }
 
+bool Database::readRowVersion(int productId, qint64 *version, QString *error)
+{
+    QSqlQuery read(connection());
+    read.prepare("SELECT row_version FROM product WHERE product_id = :id");
+    read.bindValue(":id", productId);
+    if (!read.exec() || !read.next()) {
+        logError("Zeilenversion lesen", read.lastError());
+        *error = read.lastError().text();
+        return false;
+    }
+    *version = read.value(0).toLongLong();
+    return true;
+}
+
+QSqlDatabase Database::connection()
+{
+    // Haupt-Thread nutzt die primäre Verbindung
+    if (QThread::currentThread() == thread())
+        return db;
+
+    // Jeder Worker-Thread bekommt eine eigene Verbindung (QSqlDatabase ist
+    // nicht thread-übergreifend nutzbar)
+    const QString name = QString("webapp-worker-%1").arg(quintptr(QThread::currentThreadId()));
+    if (QSqlDatabase::contains(name)) {
+        QSqlDatabase conn = QSqlDatabase::database(name, false);
+        if (conn.isOpen() || conn.open())
+            return conn;
+        logError("Worker-Verbindung öffnen", conn.lastError());
+        return conn;
+    }
+
+    QSqlDatabase conn = QSqlDatabase::cloneDatabase(db.connectionName(), name);
+    if (!conn.open())
+        logError("Worker-Verbindung öffnen", conn.lastError());
+    else
+        qCDebug(lcDb) << "Worker-Verbindung geöffnet:" << name;
+    return conn;
+}
+
+QThreadPool *Database::pool()
+{
+    return &workerPool;
+}
+
+// ===== LESE-REPLICAS =====
+
+// Rückstand in ms; -1 = keine Replica (nicht im Recovery-Modus). Hat die
+// Replica alles Empfangene eingespielt, ist sie aktuell — auch wenn der
+// letzte Commit auf dem Primary lange her ist. Der Rückstand dient nur dem
+// allgemeinen Limit, read-your-writes vergleicht die eingespielte Position.
+static const char *const ReplicaLagSql =
+    "SELECT CASE WHEN NOT pg_is_in_recovery() THEN -1 "
+    "WHEN pg_last_wal_receive_lsn() = pg_last_wal_replay_lsn() THEN 0 "
+    "ELSE COALESCE(EXTRACT(EPOCH FROM clock_timestamp() - pg_last_xact_replay_timestamp()) * 1000, -1) "
+    "END, pg_last_wal_replay_lsn()::text";
+
+void Database::setupReplicas()
+{
+    const QString spec = qEnvironmentVariable("DB_REPLICAS");
+    if (spec.isEmpty()) return;
+    if (db.driverName() != "QPSQL") {
+        qCWarning(lcDb) << "DB_REPLICAS wird nur mit PostgreSQL unterstützt — ignoriert";
+        return;
+    }
+
+    const QList<ReplicaRouter::Endpoint> endpoints = ReplicaRouter::parse(spec, db.port());
+    if (endpoints.isEmpty()) return;
+
+    const QByteArray maxLag = qgetenv("DB_REPLICA_MAX_LAG_MS");
+    const int interval = qEnvironmentVariableIntValue("DB_REPLICA_PROBE_MS");
+    replicaProbeTimer.setInterval(interval > 0 ? interval : 1000);
+    replicas = std::make_unique<ReplicaRouter>(endpoints, maxLag.isEmpty() ? 1000 : maxLag.toLongLong(),
+                                               replicaProbeTimer.interval());
+
+    for (const auto &ep : endpoints)
+        qCInfo(lcDb) << "Lese-Replica:" << ep.host << ep.port;
+
+    // Bis zur ersten Messung liest alles vom Primary
+    QObject::connect(&replicaProbeTimer, &QTimer::timeout, this, &Database::probeReplicas);
+    replicaProbeTimer.start();
+    probeReplicas();
+}
+
+void Database::probeReplicas()
+{
+    // Messung im Worker-Pool — eine hängende Replica blockiert nicht den Haupt-Thread
+    if (replicaProbeRunning) return;
+    replicaProbeRunning = true;
+
+    QtConcurrent::run(&workerPool, [this]() {
+        for (int i = 0; i < replicas->count(); ++i) {
+            QSqlDatabase conn = replicaConnection(i);
+            QSqlQuery q(conn);
+            if (!q.exec(ReplicaLagSql) || !q.next()) {
+                const QString error = conn.isOpen() ? q.lastError().text() : conn.lastError().text();
+                if (replicas->reportFailure(i, error))
+                    qCWarning(lcDb) << "Lese-Replica nicht erreichbar:" << replicas->endpoint(i).host
+                                    << replicas->endpoint(i).port << error;
+                conn.close();   // nächster Versuch baut neu auf
+                continue;
+            }
+            replicas->reportLag(i, qint64(q.value(0).toDouble()),
+                                ReplicaRouter::parseLsn(q.value(1).toString()));
+        }
+    }).then(this, [this]() { replicaProbeRunning = false; });
+}
+
+QSqlDatabase Database::replicaConnection(int replica)
+{
+    // Pro Replica und Thread eine eigene Verbindung, wie bei connection()
+    const QString name = QString("webapp-replica-%1-%2").arg(replica).arg(quintptr(QThread::currentThreadId()));
+    if (QSqlDatabase::contains(name)) {
+        QSqlDatabase conn = QSqlDatabase::database(name, false);
+        if (!conn.isOpen() && !conn.open())
+            qCDebug(lcDb) << "Replica-Verbindung öffnen:" << name << conn.lastError().text();
+        return conn;
+    }
+
+    const ReplicaRouter::Endpoint ep = replicas->endpoint(replica);
+    QSqlDatabase conn = QSqlDatabase::cloneDatabase(db.connectionName(), name);
+    conn.setHostName(ep.host);
+    conn.setPort(ep.port);
+    // Nicht erreichbare Replica soll nicht lange blockieren
+    conn.setConnectOptions("connect_timeout=2");
+    if (!conn.open())
+        qCDebug(lcDb) << "Replica-Verbindung öffnen:" << name << conn.lastError().text();
+    else
+        qCDebug(lcDb) << "Replica-Verbindung geöffnet:" << name;
+    return conn;
+}
+
+// Niedrigste eingespielte Position der Replicas, von denen dieser Thread
+// seit beginReadTracking() gelesen hat; Primary = max
+static thread_local quint64 t_readLsn = std::numeric_limits<quint64>::max();
+
+QSqlQuery Database::execRead(const std::function<bool(QSqlQuery &)> &exec, bool *ok)
+{
+    const RequestContext *ctx = RequestContext::current();
+    const int replica = replicas ? replicas->pick(ctx ? ctx->session() : QString()) : -1;
+    QueryGuard::resetLast();
+
+    if (replica >= 0) {
+        QSqlDatabase conn = replicaConnection(replica);
+        QSqlQuery q(conn);
+        {
+            QueryGuard::Scope scope(guard, conn);
+            if (!scope.admitted()) { *ok = false; return q; }
+            const quint64 replayed = replicas->replayLsn(replica);
+            if ((*ok = exec(q))) {
+                t_readLsn = qMin(t_readLsn, replayed);
+                return q;
+            }
+            scope.failed(q.lastError());
+        }
+        // Abgebrochen oder Zeitlimit: auf dem Primary würde es nicht besser
+        if (QueryGuard::lastReason() != QueryGuard::Reason::None)
+            return q;
+
+        // Ohne SQLSTATE bzw. Klasse 08/57P ist die Verbindung weg — Replica
+        // bis zur nächsten Messung sperren. Andere Fehler (z. B. Abbruch
+        // wegen Recovery-Konflikt) nur auf dem Primary wiederholen.
+        const QSqlError error = q.lastError();
+        const QString code = error.nativeErrorCode();
+        if (!conn.isOpen() || code.isEmpty() || code.startsWith("08") || code.startsWith("57P")) {
+            if (replicas->reportFailure(replica, error.text()))
+                qCWarning(lcDb) << "Lese-Replica ausgefallen:" << replicas->endpoint(replica).host
+                                << replicas->endpoint(replica).port << error.text();
+            conn.close();
+        }
+        replicas->noteRetry();
+    }
+
+    QSqlDatabase conn = connection();
+    QSqlQuery q(conn);
+    QueryGuard::Scope scope(guard, conn);
+    if (!scope.admitted()) { *ok = false; return q; }
+    if (!(*ok = exec(q)))
+        scope.failed(q.lastError());
+    return q;
+}
+
+QString Database::readError(const QSqlQuery &query)
+{
+    return QueryGuard::lastReason() != QueryGuard::Reason::None ? QueryGuard::lastMessage()
+                                                               : query.lastError().text();
+}
+
+QueryGuard *Database::queryGuard()
+{
+    return guard;
+}
+
+quint64 Database::writeLsn()
+{
+    if (!replicas) return 0;
+    // Nach dem Commit: mindestens die Position des Commit-Records
+    QSqlQuery q(connection());
+    if (!q.exec("SELECT pg_current_wal_lsn()::text") || !q.next()) {
+        logError("WAL-Position lesen", q.lastError());
+        return 0;
+    }
+    return ReplicaRouter::parseLsn(q.value(0).toString());
+}
+
+void Database::noteWrite(const QString &session, quint64 lsn)
+{
+    if (replicas)
+        replicas->noteWrite(session, lsn);
+}
+
+bool Database::hasRecentWrite(const QString &session) const
+{
+    return replicas && replicas->hasRecentWrite(session);
+}
+
+void Database::noteDataChanged()
+{
+    if (!replicas) return;
+    const quint64 change = replicas->beginChange();
+    QtConcurrent::run(&workerPool, [this, change]() {
+        // Läuft nach dem Commit bzw. nach Zustellung der Notification
+        replicas->resolveChange(change, writeLsn());
+    });
+}
+
+void Database::beginReadTracking()
+{
+    t_readLsn = std::numeric_limits<quint64>::max();
+}
+
+bool Database::readsAreCurrent() const
+{
+    return !replicas || replicas->isCurrent(t_readLsn);
+}
+
+QJsonObject Database::replicaStats() const
+{
+    return replicas ? replicas->stats() : QJsonObject();
+}
+
+QString Database::libpqConnInfo(const QString &applicationName) const
+{
+    if (db.driverName() != "QPSQL") return {};
+
+    // Werte in '...' quoten, \ und ' escapen (libpq-Conninfo-Syntax)
+    auto quote = [](const QString &value) {
+        QString v = value;
+        v.replace("\\", "\\\\").replace("'", "\\'");
+        return "'" + v + "'";
+    };
+
+    return QString("host=%1 port=%2 dbname=%3 user=%4 password=%5 "
+                   "connect_timeout=3 application_name=%6")
+        .arg(quote(db.hostName()))
+        .arg(db.port())
+        .arg(quote(db.databaseName()), quote(db.userName()),
+             quote(db.password()), quote(applicationName));
+}
+
 bool Database::isConnected() const
 {
     return db.isOpen();
@@ -388,11 +1117,12 @@ bool Database::isConnected() const
 
 void Database::logError(const QString &operation, const QSqlError &error)
 {
+    // Eine Meldung statt fünf — landet als eine strukturierte Log-Zeile
     if (error.type() != QSqlError::NoError) {
-        qCritical() << "DB-Fehler bei" << operation << ":";
-        qCritical() << "  Type:" << error.type();
-        qCritical() << "  Text:" << error.text();
-        qCritical() << "  Database:" << error.databaseText();
-        qCritical() << "  Driver:" << error.driverText();
+        qCCritical(lcDb).nospace() << "DB-Fehler bei " << operation
+                                   << ": type=" << error.type()
+                                   << " code=" << error.nativeErrorCode()
+                                   << " database=" << error.databaseText()
+                                   << " driver=" << error.driverText();
     }
 }
@@ -9,6 +9,16 @@
 #include <QStringList>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QThreadPool>
+#include <QTimer>
+#include <functional>
+#include <memory>
+
+class CatalogSnapshot;
+class ColumnarResult;
+class QueryGuard;
+class ReplicaRouter;
+struct ProductSnapshot;
 
 class Database : public QObject
 {
@@ -27,29 +37,111 @@ public:
     // Tabellen auflisten
     QStringList getTables();
 
-    // Tabellenstruktur + Daten holen
-    QJsonObject getTableData(const QString &tableName);
+    // Tabellenstruktur + Daten holen (max. limit Zeilen)
+    QJsonObject getTableData(const QString &tableName, int limit = 200);
+    // Dasselbe als CBOR, Zeilen direkt aus der Abfrage kodiert (Fehler → leer + error)
+    QByteArray getTableDataCbor(const QString &tableName, int limit, QString *error);
+    // Spaltenweise (layout=columnar), Ausgabe als JSON oder CBOR macht der Aufrufer
+    bool readTableColumnar(const QString &tableName, int limit, ColumnarResult &result, QString *error);
 
     // Einzelnen Datensatz holen
     QJsonObject getRowById(const QString &tableName, int id);
 
-    // Product-Tabelle anlegen + Beispieldaten einfügen
-    void initProductTable();
+    // Schema-Migrationen ausführen (product-Tabelle, Indizes, Beispieldaten)
+    bool migrateSchema();
 
-    // Product CRUD
-    QJsonObject getProducts();
+    // Product CRUD — getProducts seitenweise ab afterId (limit 0 = alle)
+    QJsonObject getProducts(int afterId = 0, int limit = 0);
+    QByteArray getProductsCbor(int afterId, int limit, QString *error);
+    bool readProductsColumnar(int afterId, int limit, ColumnarResult &result, bool *hasMore, QString *error);
+    // Spaltenweiser Schnappschuss für /api/products/stats
+    bool loadProductSnapshot(ProductSnapshot &snapshot, QString *error);
+    // Dasselbe ausgehend von einer Katalog-Datei: nur (product_id,
+    // row_version) lesen, geänderte und neue Zeilen nachladen, gelöschte
+    // weglassen. changed = nachgeladene + gelöschte Zeilen
+    bool catchUpProductSnapshot(const CatalogSnapshot &catalog, ProductSnapshot &snapshot,
+                                qint64 *changed, QString *error);
+    // Ganze product-Tabelle als Katalog-Datei schreiben (CATALOG_SNAPSHOT_FILE)
+    bool writeCatalogSnapshot(const QString &path, qint64 *rows, QString *error);
+    // Insert/Update/Delete liefern "product_id", Insert und Update auch die neue "row_version"
     QJsonObject insertProduct(const QJsonObject &data, const QString &updatedBy = QString());
     QJsonObject updateProduct(int productId, const QJsonObject &data, const QString &updatedBy = QString());
+    // Einzelnes Produkt inkl. row_version
+    QJsonObject getProduct(int productId);
+    // Nur die übergebenen Felder schreiben; expectedVersion >= 0 → nur, wenn
+    // row_version noch passt. Fehler: "error" + "notFound" bzw. "conflict"
+    // (mit aktueller "row_version"), sonst neue "row_version"
+    QJsonObject patchProduct(int productId, const QJsonObject &fields, qint64 expectedVersion,
+                             const QString &updatedBy = QString());
     QJsonObject deleteProduct(int productId);
 
     // Verbindungsstatus prüfen
     bool isConnected() const;
+
+    // Verbindung für den aufrufenden Thread (Haupt-Thread oder Worker)
+    QSqlDatabase connection();
+
+    // Thread-Pool für parallele Lesezugriffe (DB_POOL_SIZE, Default 4)
+    QThreadPool *pool();
+
+    // Zeitbudgets je Route und Abbruch laufender Lesezugriffe
+    QueryGuard *queryGuard();
+
+    // Aktuelle WAL-Position des Primary auf der Verbindung dieses Threads
+    // (nach einem Commit aufrufen); 0 ohne DB_REPLICAS oder bei Fehler
+    quint64 writeLsn();
+    // Schreibzugriff der Session (Benutzer) ist committet — ihre nächsten
+    // Lesezugriffe gehen nur an Replicas, die bis lsn eingespielt haben
+    void noteWrite(const QString &session, quint64 lsn);
+    // Lesezugriffe der Session brauchen evtl. den Primary (kein Teilen mit anderen)
+    bool hasRecentWrite(const QString &session) const;
+
+    // Response-Cache: Haupt-Thread meldet Änderungen an den Daten; die
+    // WAL-Position danach wird im Worker-Pool nachgereicht
+    void noteDataChanged();
+    // Pro Thread: vor einem Handler zurücksetzen, danach prüfen, ob alle
+    // Lesezugriffe vom Primary oder einer aktuellen Replica kamen
+    static void beginReadTracking();
+    bool readsAreCurrent() const;
+
+    // Replica-Zustand und Verteilung der Lesezugriffe (leer ohne DB_REPLICAS)
+    QJsonObject replicaStats() const;
+
+    // Verbindungsparameter als libpq-Conninfo (für LISTEN/NOTIFY, COPY)
+    // — leer, wenn nicht PostgreSQL
+    QString libpqConnInfo(const QString &applicationName = "webapp") const;
     
 private:
     QSqlDatabase db;
+    QThreadPool workerPool;
+    QueryGuard *guard = nullptr;
+
+    // Lese-Replicas (DB_REPLICAS), nullptr = alles über den Primary
+    std::unique_ptr<ReplicaRouter> replicas;
+    QTimer replicaProbeTimer;
+    bool replicaProbeRunning = false;
+
+    void setupReplicas();
+    void probeReplicas();
+    // Verbindung zur Replica für den aufrufenden Thread
+    QSqlDatabase replicaConnection(int replica);
+    // Lesende Abfrage: exec auf einer Replica, bei Fehlern einmal auf dem
+    // Primary wiederholt; ohne passende Replica gleich dort.
+    // ok = false → Fehler in lastError() der zurückgegebenen Abfrage
+    QSqlQuery execRead(const std::function<bool(QSqlQuery &)> &exec, bool *ok);
+    // Fehlertext dazu — bei Abbruch/Zeitlimit die Meldung des QueryGuard
+    static QString readError(const QSqlQuery &query);
     
     // Hilfsfunktion für Fehlerbehandlung
     void logError(const QString &operation, const QSqlError &error);
+
+    // row_version nach einem Schreibzugriff ohne RETURNING (Oracle) — in
+    // derselben Transaktion, die Zeile ist noch gesperrt
+    bool readRowVersion(int productId, qint64 *version, QString *error);
+
+    // Abfragen für JSON- und CBOR-Ausgabe gemeinsam
+    bool execTableQuery(QSqlQuery &query, const QString &tableName, int limit, QString *error);
+    bool execProductsQuery(QSqlQuery &q, int afterId, int limit, QString *error);
 };
 
 #endif // DATABASE_H
@@ -0,0 +1,157 @@
+#include "eventstream.h"
+#include "logger.h"
+#include <QDebug>
+#include <QDateTime>
+
+// Ab so vielen ungesendeten Bytes im Socket wird gepuffert statt geschrieben
+static const qint64 HighWaterBytes = 256 * 1024;
+// Maximale Anzahl gepufferter Events pro Client
+static const int MaxBacklog = 256;
+// Anzahl Events für Resume per Last-Event-ID
+static const int HistorySize = 512;
+
+EventStream::EventStream(QObject *parent)
+    : QObject(parent)
+{
+    // Kommentar-Zeile alle 15 s hält Proxies offen und erkennt tote Clients
+    heartbeatTimer.setInterval(15000);
+    connect(&heartbeatTimer, &QTimer::timeout, this, &EventStream::heartbeat);
+    heartbeatTimer.start();
+
+    // Event-IDs über Neustarts hinweg eindeutig (Zeitbasis), damit ein
+    // Client mit alter Last-Event-ID sicher ein resync bekommt
+    nextId = quint64(QDateTime::currentMSecsSinceEpoch()) * 1000;
+}
+
+QByteArray EventStream::frame(quint64 id, const QByteArray &event, const QByteArray &data)
+{
+    return "id: " + QByteArray::number(id) + "\nevent: " + event + "\ndata: " + data + "\n\n";
+}
+
+void EventStream::subscribe(QHttpServerResponder &&responder, QTcpSocket *socket, quint64 lastEventId)
+{
+    auto sub = std::unique_ptr<Subscriber>(new Subscriber{ std::move(responder), socket, {}, false });
+    Subscriber *raw = sub.get();
+
+    sub->responder.writeChunk("retry: 3000\n\n");
+
+    // Resume: verpasste Events nachliefern, sofern noch in der History —
+    // sonst (zu alt, oder ID aus einem früheren Prozess) neu laden lassen
+    if (lastEventId > 0 && lastEventId != nextId - 1) {
+        const bool covered = lastEventId < nextId && !history.isEmpty()
+                             && history.head().first <= lastEventId + 1;
+        if (covered) {
+            for (const auto &entry : std::as_const(history)) {
+                if (entry.first > lastEventId)
+                    deliver(*sub, entry.second);
+            }
+        } else {
+            sub->needsResync = true;
+            flush(raw);
+        }
+    }
+
+    if (socket) {
+        connect(socket, &QTcpSocket::bytesWritten, this, [this, raw]() { flush(raw); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, raw]() { remove(raw); });
+    }
+
+    subscribers.push_back(std::move(sub));
+    qCDebug(lcHttp) << "SSE: Abonnent verbunden, aktiv:" << subscribers.size();
+}
+
+void EventStream::publish(const QByteArray &event, const QByteArray &data)
+{
+    const quint64 id = nextId++;
+    const QByteArray f = frame(id, event, data);
+
+    history.enqueue({ id, f });
+    while (history.size() > HistorySize)
+        history.dequeue();
+
+    for (auto &sub : subscribers)
+        deliver(*sub, f);
+}
+
+void EventStream::publishResync()
+{
+    history.clear();
+    for (auto &sub : subscribers) {
+        sub->backlog.clear();
+        sub->needsResync = true;
+        flush(sub.get());
+    }
+}
+
+void EventStream::deliver(Subscriber &sub, const QByteArray &f)
+{
+    if (sub.needsResync) return;   // Client lädt ohnehin neu
+
+    const bool congested = sub.socket && sub.socket->bytesToWrite() > HighWaterBytes;
+    if (!congested && sub.backlog.isEmpty()) {
+        sub.responder.writeChunk(f);
+        ++delivered;
+        return;
+    }
+
+    sub.backlog.enqueue(f);
+    if (sub.backlog.size() > MaxBacklog) {
+        sub.backlog.clear();
+        sub.needsResync = true;
+        ++overflows;
+        qCWarning(lcHttp) << "SSE: Client zu langsam, Puffer verworfen → resync";
+    }
+}
+
+void EventStream::flush(Subscriber *sub)
+{
+    while (!sub->socket || sub->socket->bytesToWrite() <= HighWaterBytes) {
+        if (sub->needsResync) {
+            sub->responder.writeChunk(frame(nextId - 1, "resync", "{}"));
+            sub->needsResync = false;
+            return;
+        }
+        if (sub->backlog.isEmpty()) return;
+        sub->responder.writeChunk(sub->backlog.dequeue());
+        ++delivered;
+    }
+}
+
+void EventStream::remove(Subscriber *sub)
+{
+    for (auto it = subscribers.begin(); it != subscribers.end(); ++it) {
+        if (it->get() == sub) {
+            if (sub->socket)
+                disconnect(sub->socket, nullptr, this, nullptr);
+            subscribers.erase(it);
+            break;
+        }
+    }
+    qCDebug(lcHttp) << "SSE: Abonnent getrennt, aktiv:" << subscribers.size();
+}
+
+void EventStream::heartbeat()
+{
+    for (auto it = subscribers.begin(); it != subscribers.end();) {
+        Subscriber *sub = it->get();
+        if (!sub->socket || sub->socket->state() != QAbstractSocket::ConnectedState) {
+            if (sub->socket)
+                disconnect(sub->socket, nullptr, this, nullptr);
+            it = subscribers.erase(it);
+            continue;
+        }
+        if (sub->backlog.isEmpty() && sub->socket->bytesToWrite() <= HighWaterBytes)
+            sub->responder.writeChunk(": ping\n\n");
+        ++it;
+    }
+}
+
+QJsonObject EventStream::stats() const
+{
+    QJsonObject s;
+    s["subscribers"] = int(subscribers.size());
+    s["delivered"]   = qint64(delivered);
+    s["overflows"]   = qint64(overflows);
+    s["lastEventId"] = qint64(nextId - 1);
+    return s;
+}
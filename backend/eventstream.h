@@ -0,0 +1,67 @@
+#ifndef EVENTSTREAM_H
+#define EVENTSTREAM_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHttpServerResponder>
+#include <QJsonObject>
+#include <QPointer>
+#include <QQueue>
+#include <QTcpSocket>
+#include <QTimer>
+#include <memory>
+#include <vector>
+
+// Server-Sent-Events-Verteiler
+//
+// Jeder Abonnent hat einen eigenen, begrenzten Puffer. Solange der Socket
+// eines Clients noch viel Ungesendetes hat, werden Events dort gesammelt;
+// läuft der Puffer über, wird er verworfen und der Client bekommt ein
+// "resync"-Event (neu laden statt Diffs anwenden). Ein langsamer Client
+// bremst so weder den Server noch die anderen Abonnenten.
+class EventStream : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EventStream(QObject *parent = nullptr);
+
+    // Responder übernehmen (Header bereits gesendet) — lastEventId für Resume
+    void subscribe(QHttpServerResponder &&responder, QTcpSocket *socket, quint64 lastEventId = 0);
+
+    // Event an alle Abonnenten verteilen
+    void publish(const QByteArray &event, const QByteArray &data);
+
+    // Alle Clients zum Neuladen auffordern (z.B. nach LISTEN-Reconnect)
+    void publishResync();
+
+    int subscriberCount() const { return int(subscribers.size()); }
+    QJsonObject stats() const;
+
+private:
+    struct Subscriber {
+        QHttpServerResponder responder;
+        QPointer<QTcpSocket> socket;
+        QQueue<QByteArray> backlog;
+        bool needsResync = false;
+    };
+
+    static QByteArray frame(quint64 id, const QByteArray &event, const QByteArray &data);
+
+    void deliver(Subscriber &sub, const QByteArray &frame);
+    void flush(Subscriber *sub);
+    void remove(Subscriber *sub);
+    void heartbeat();
+
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+
+    // Letzte Events für Resume per Last-Event-ID
+    QQueue<QPair<quint64, QByteArray>> history;
+    quint64 nextId = 0;
+
+    QTimer heartbeatTimer;
+    quint64 delivered = 0;
+    quint64 overflows = 0;
+};
+
+#endif // EVENTSTREAM_H
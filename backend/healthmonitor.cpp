@@ -0,0 +1,183 @@
+#include "healthmonitor.h"
+#include "database.h"
+#include "logger.h"
+#include "queryguard.h"
+#include "writebatcher.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QtConcurrent>
+
+static const int DefaultProbeMs = 2000;
+static const int DefaultMaxQueueWaitMs = 250;
+static const int DefaultMaxQueueDepth = 64;
+
+static int envInt(const char *name, int fallback)
+{
+    const int value = qEnvironmentVariableIntValue(name);
+    return value > 0 ? value : fallback;
+}
+
+HealthMonitor::HealthMonitor(Database *database, WriteBatcher *batcher, QObject *parent)
+    : QObject(parent), db(database), writeBatcher(batcher)
+{
+    maxQueueWaitMs = envInt("HEALTH_MAX_QUEUE_WAIT_MS", DefaultMaxQueueWaitMs);
+    maxQueueDepth = envInt("HEALTH_MAX_QUEUE", DefaultMaxQueueDepth);
+    uptime.start();
+
+    timer.setInterval(envInt("HEALTH_PROBE_MS", DefaultProbeMs));
+    connect(&timer, &QTimer::timeout, this, &HealthMonitor::probe);
+    timer.start();
+
+    // Bis zur ersten Prüfung nicht bereit
+    evaluate();
+    probe();
+}
+
+void HealthMonitor::startDrain()
+{
+    if (draining) return;
+    draining = true;
+    qCInfo(lcHttp) << "Drain: /health/ready meldet ab jetzt 503";
+    evaluate();
+}
+
+void HealthMonitor::probe()
+{
+    // Hängt die letzte Prüfung noch, keine zweite starten — evaluate() sieht
+    // am Alter, dass die DB (oder der Pool) nicht antwortet
+    if (probeRunning) {
+        evaluate();
+        return;
+    }
+    probeRunning = true;
+    probeStarted.start();
+
+    Database *database = db;
+    QElapsedTimer queued;
+    queued.start();
+    QtConcurrent::run(database->pool(), [database, queued]() {
+        ProbeResult r;
+        r.queueWaitMs = queued.elapsed();
+
+        QElapsedTimer t;
+        t.start();
+        QSqlDatabase conn = database->connection();
+        QSqlQuery q(conn);
+        r.ok = q.exec(conn.driverName() == "QOCI" ? "SELECT 1 FROM DUAL" : "SELECT 1") && q.next();
+        r.latencyMs = t.elapsed();
+        if (!r.ok) {
+            r.error = conn.isOpen() ? q.lastError().text() : conn.lastError().text();
+            // QPSQL hält eine tote Verbindung für offen — neu aufbauen lassen
+            conn.close();
+        }
+        return r;
+    }).then(this, [this](const ProbeResult &r) { probeDone(r); });
+}
+
+void HealthMonitor::probeDone(const ProbeResult &r)
+{
+    probeRunning = false;
+    ++probes;
+    lastProbe.start();
+    lastLatencyMs = r.latencyMs;
+    lastQueueWaitMs = r.queueWaitMs;
+
+    if (r.ok) {
+        if (!dbOk && consecutiveFailures > 0)
+            qCInfo(lcDb) << "Health: Datenbank wieder erreichbar nach" << consecutiveFailures << "Fehlversuchen";
+        consecutiveFailures = 0;
+        lastError.clear();
+    } else {
+        ++failures;
+        if (consecutiveFailures++ == 0)
+            qCWarning(lcDb) << "Health: Datenbank nicht erreichbar:" << r.error;
+        lastError = r.error;
+    }
+    dbOk = r.ok;
+    evaluate();
+}
+
+void HealthMonitor::evaluate()
+{
+    const qint64 staleMs = 3 * timer.interval();
+    const qint64 probeAge = lastProbe.isValid() ? lastProbe.elapsed() : -1;
+    const int poolActive = db->pool()->activeThreadCount();
+    const int poolMax = db->pool()->maxThreadCount();
+    // Lesende Requests, die auf einen Pool-Thread warten, + wartende Schreibzugriffe
+    const int readQueue = qMax(0, db->queryGuard()->inFlight() - poolActive);
+    const int writeQueue = writeBatcher ? writeBatcher->queued() : 0;
+    // Eine laufende Prüfung, die schon länger wartet, zählt mit
+    const qint64 queueWait = probeRunning ? qMax(lastQueueWaitMs, probeStarted.elapsed()) : lastQueueWaitMs;
+
+    QJsonArray reasons;
+    if (draining)
+        reasons.append("Server wird beendet (Drain)");
+    if (probeAge < 0)
+        reasons.append("Noch keine DB-Prüfung abgeschlossen");
+    else if (!dbOk)
+        reasons.append("Datenbank nicht erreichbar: " + lastError);
+    else if (probeAge > staleMs)
+        reasons.append(QString("Letzte DB-Prüfung vor %1 ms").arg(probeAge));
+    if (poolActive >= poolMax && queueWait > maxQueueWaitMs)
+        reasons.append(QString("DB-Pool ausgelastet (%1/%2, Wartezeit %3 ms)").arg(poolActive).arg(poolMax).arg(queueWait));
+    if (readQueue + writeQueue > maxQueueDepth)
+        reasons.append(QString("Warteschlange zu lang (%1 Lesen, %2 Schreiben)").arg(readQueue).arg(writeQueue));
+
+    const bool nowReady = reasons.isEmpty();
+    if (nowReady != ready) {
+        ++readyTransitions;
+        if (nowReady)
+            qCInfo(lcHttp) << "Health: bereit";
+        else
+            qCWarning(lcHttp) << "Health: nicht bereit —" << reasons.first().toString();
+        ready = nowReady;
+    }
+
+    QJsonObject database;
+    database["reachable"] = dbOk;
+    database["latencyMs"] = lastLatencyMs;
+    database["probeAgeMs"] = probeAge;
+    database["consecutiveFailures"] = consecutiveFailures;
+    if (!lastError.isEmpty())
+        database["error"] = lastError;
+
+    QJsonObject pool;
+    pool["active"] = poolActive;
+    pool["max"] = poolMax;
+    pool["queueWaitMs"] = queueWait;
+
+    QJsonObject queues;
+    queues["reads"] = readQueue;
+    queues["writes"] = writeQueue;
+    queues["max"] = maxQueueDepth;
+
+    QJsonObject state;
+    state["status"] = ready ? "ready" : "not ready";
+    state["draining"] = draining;
+    state["database"] = database;
+    state["pool"] = pool;
+    state["queues"] = queues;
+    if (!reasons.isEmpty())
+        state["reasons"] = reasons;
+    state["checkedAt"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    lastState = state;
+    cachedReady = QJsonDocument(state).toJson(QJsonDocument::Compact);
+
+    QJsonObject live;
+    live["status"] = "live";
+    live["uptimeSec"] = uptime.elapsed() / 1000;
+    live["checkedAt"] = state["checkedAt"];
+    cachedLive = QJsonDocument(live).toJson(QJsonDocument::Compact);
+}
+
+QJsonObject HealthMonitor::stats() const
+{
+    QJsonObject s = lastState;
+    s["probes"] = qint64(probes);
+    s["probeFailures"] = qint64(failures);
+    s["readyTransitions"] = qint64(readyTransitions);
+    s["probeIntervalMs"] = timer.interval();
+    return s;
+}
@@ -0,0 +1,84 @@
+#ifndef HEALTHMONITOR_H
+#define HEALTHMONITOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QString>
+#include <QTimer>
+
+class Database;
+class WriteBatcher;
+
+// Liveness/Readiness aus dem Speicher (GET /health/live, /health/ready)
+//
+// Ein Timer (HEALTH_PROBE_MS, Default 2000) schickt ein SELECT 1 durch den
+// DB-Worker-Pool und bewertet danach den Zustand: DB erreichbar und
+// Prüfung aktuell, Pool nicht ausgelastet (Wartezeit der Prüfung im Pool),
+// Warteschlangen kurz, kein Drain. Die Antworten werden dabei fertig
+// serialisiert — ein Health-Check kostet weder DB-Zugriff noch JSON-Aufbau.
+class HealthMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    HealthMonitor(Database *database, WriteBatcher *writeBatcher, QObject *parent = nullptr);
+
+    // Fertige Antworten (JSON), ready() mit passendem Status
+    QByteArray liveBody() const { return cachedLive; }
+    QByteArray readyBody() const { return cachedReady; }
+    bool isReady() const { return ready; }
+
+    // Letztes Ergebnis der DB-Prüfung (für /health)
+    bool databaseReachable() const { return dbOk; }
+
+    // Ab jetzt nicht mehr bereit (Shutdown) — Load Balancer nimmt die Instanz raus
+    void startDrain();
+    bool isDraining() const { return draining; }
+
+    // Zustand und Zähler (für /metrics)
+    QJsonObject stats() const;
+
+private:
+    struct ProbeResult {
+        bool ok = false;
+        qint64 queueWaitMs = 0;
+        qint64 latencyMs = 0;
+        QString error;
+    };
+
+    void probe();
+    void probeDone(const ProbeResult &result);
+    void evaluate();
+
+    Database *db;
+    WriteBatcher *writeBatcher;
+    QTimer timer;
+    QElapsedTimer uptime;
+
+    int maxQueueWaitMs;
+    int maxQueueDepth;
+
+    // Letzte Prüfung
+    bool probeRunning = false;
+    QElapsedTimer probeStarted;
+    bool dbOk = false;
+    QElapsedTimer lastProbe;         // seit der letzten abgeschlossenen Prüfung
+    qint64 lastLatencyMs = -1;
+    qint64 lastQueueWaitMs = 0;
+    QString lastError;
+    int consecutiveFailures = 0;
+    quint64 probes = 0;
+    quint64 failures = 0;
+
+    bool draining = false;
+    bool ready = false;
+    quint64 readyTransitions = 0;
+    QJsonObject lastState;
+    QByteArray cachedLive;
+    QByteArray cachedReady;
+};
+
+#endif // HEALTHMONITOR_H
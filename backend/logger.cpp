@@ -0,0 +1,240 @@
+#include "logger.h"
+#include "requestcontext.h"
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QMutexLocker>
+#include <cstdio>
+#include <unistd.h>
+
+Q_LOGGING_CATEGORY(lcHttp, "webapp.http")
+Q_LOGGING_CATEGORY(lcDb,   "webapp.db")
+Q_LOGGING_CATEGORY(lcAuth, "webapp.auth")
+
+std::atomic<AsyncLogger *> AsyncLogger::s_instance{nullptr};
+
+static QMutex rulesMutex;
+static QString currentRules;
+
+AsyncLogger::AsyncLogger(int capacity)
+{
+    // Kapazität auf Zweierpotenz runden (Index per Maske)
+    size_t cap = 1;
+    while (cap < size_t(qMax(capacity, 2))) cap <<= 1;
+
+    m_slots.reset(new Slot[cap]);
+    for (size_t i = 0; i < cap; ++i)
+        m_slots[i].seq.store(i, std::memory_order_relaxed);
+    m_mask = cap - 1;
+
+    m_json = qEnvironmentVariable("LOG_FORMAT", "json").compare("text", Qt::CaseInsensitive) != 0;
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    uninstall();
+}
+
+void AsyncLogger::install()
+{
+    if (m_running.exchange(true)) return;
+
+    s_instance.store(this, std::memory_order_release);
+    m_writer = QThread::create([this]() { writerLoop(); });
+    m_writer->setObjectName("log-writer");
+    m_writer->start(QThread::LowPriority);
+    m_previousHandler = qInstallMessageHandler(&AsyncLogger::messageHandler);
+}
+
+void AsyncLogger::uninstall()
+{
+    if (!m_running.exchange(false)) return;
+
+    qInstallMessageHandler(m_previousHandler);
+    s_instance.store(nullptr, std::memory_order_release);
+
+    // Writer leert den Puffer noch vollständig, bevor er endet
+    m_writer->wait();
+    delete m_writer;
+    m_writer = nullptr;
+}
+
+// ===== FILTERREGELN =====
+
+void AsyncLogger::setFilterRules(const QString &rules)
+{
+    QString normalized = rules;
+    normalized.replace(';', '\n');
+    QLoggingCategory::setFilterRules(normalized);
+
+    QMutexLocker lock(&rulesMutex);
+    currentRules = normalized;
+}
+
+QString AsyncLogger::filterRules()
+{
+    QMutexLocker lock(&rulesMutex);
+    return currentRules;
+}
+
+QJsonObject AsyncLogger::stats()
+{
+    QJsonObject s;
+    AsyncLogger *logger = s_instance.load(std::memory_order_acquire);
+    s["enabled"] = logger != nullptr;
+    if (!logger) return s;
+
+    s["capacity"] = qint64(logger->m_mask + 1);
+    s["written"]  = qint64(logger->m_written.load(std::memory_order_relaxed));
+    s["dropped"]  = qint64(logger->m_dropped.load(std::memory_order_relaxed));
+    s["format"]   = logger->m_json ? "json" : "text";
+    s["categories"] = QJsonObject{
+        { lcHttp().categoryName(), lcHttp().isDebugEnabled() ? "debug" : "info" },
+        { lcDb().categoryName(),   lcDb().isDebugEnabled()   ? "debug" : "info" },
+        { lcAuth().categoryName(), lcAuth().isDebugEnabled() ? "debug" : "info" }
+    };
+    return s;
+}
+
+// ===== PRODUCER =====
+
+void AsyncLogger::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+{
+    AsyncLogger *logger = s_instance.load(std::memory_order_acquire);
+    if (!logger) {
+        fprintf(stderr, "%s\n", qUtf8Printable(msg));
+        return;
+    }
+
+    QByteArray line = logger->format(type, context, msg);
+
+    // Fatal: synchron schreiben, danach bricht Qt den Prozess ab
+    if (type == QtFatalMsg) {
+        logger->writeOut(line);
+        return;
+    }
+
+    if (!logger->tryPush(std::move(line)))
+        logger->m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+QByteArray AsyncLogger::format(QtMsgType type, const QMessageLogContext &context, const QString &msg) const
+{
+    const char *level = "debug";
+    switch (type) {
+    case QtDebugMsg:    level = "debug"; break;
+    case QtInfoMsg:     level = "info"; break;
+    case QtWarningMsg:  level = "warning"; break;
+    case QtCriticalMsg: level = "critical"; break;
+    case QtFatalMsg:    level = "fatal"; break;
+    }
+
+    const RequestContext *req = RequestContext::current();
+    const QString ts = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+    const char *category = context.category ? context.category : "default";
+
+    if (!m_json) {
+        QByteArray line = ts.toUtf8() + ' ' + level + ' ' + category;
+        if (req) line += " [" + req->id() + ' ' + req->route() + ']';
+        line += ' ' + msg.toUtf8() + '\n';
+        return line;
+    }
+
+    QJsonObject o;
+    o["ts"]    = ts;
+    o["level"] = QLatin1StringView(level);
+    o["cat"]   = QLatin1StringView(category);
+    o["msg"]   = msg;
+    if (req) {
+        o["req"]   = QString::fromLatin1(req->id());
+        o["route"] = QString::fromLatin1(req->route());
+    }
+    return QJsonDocument(o).toJson(QJsonDocument::Compact) + '\n';
+}
+
+// Bounded MPMC-Queue nach D. Vyukov (hier mit nur einem Consumer genutzt)
+bool AsyncLogger::tryPush(QByteArray &&line)
+{
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+    for (;;) {
+        slot = &m_slots[pos & m_mask];
+        const size_t seq = slot->seq.load(std::memory_order_acquire);
+        const intptr_t diff = intptr_t(seq) - intptr_t(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;   // Puffer voll
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->line = std::move(line);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+// ===== CONSUMER =====
+
+bool AsyncLogger::tryPop(QByteArray &line)
+{
+    Slot &slot = m_slots[m_dequeuePos & m_mask];
+    const size_t seq = slot.seq.load(std::memory_order_acquire);
+    if (intptr_t(seq) - intptr_t(m_dequeuePos + 1) < 0)
+        return false;   // leer
+
+    line = std::move(slot.line);
+    slot.line = QByteArray();
+    slot.seq.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+    ++m_dequeuePos;
+    return true;
+}
+
+void AsyncLogger::writerLoop()
+{
+    QByteArray batch;
+    QByteArray line;
+    quint64 reportedDrops = 0;
+
+    for (;;) {
+        const bool running = m_running.load(std::memory_order_acquire);
+
+        // Alles Vorhandene einsammeln und mit einem write() ausgeben
+        quint64 count = 0;
+        while (batch.size() < 64 * 1024 && tryPop(line)) {
+            batch += line;
+            ++count;
+        }
+
+        const quint64 dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != reportedDrops) {
+            batch += "logger: " + QByteArray::number(dropped - reportedDrops)
+                     + " Meldungen verworfen (Puffer voll)\n";
+            reportedDrops = dropped;
+        }
+
+        if (!batch.isEmpty()) {
+            writeOut(batch);
+            m_written.fetch_add(count, std::memory_order_relaxed);
+            batch.clear();
+            continue;
+        }
+
+        if (!running) break;
+        QThread::msleep(5);
+    }
+}
+
+void AsyncLogger::writeOut(const QByteArray &data)
+{
+    const char *p = data.constData();
+    qsizetype left = data.size();
+    while (left > 0) {
+        const ssize_t n = ::write(STDERR_FILENO, p, size_t(left));
+        if (n <= 0) break;
+        p += n;
+        left -= n;
+    }
+}
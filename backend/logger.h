@@ -0,0 +1,74 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+// Logging-Kategorien pro Subsystem — zur Laufzeit schaltbar, z.B.
+//   QT_LOGGING_RULES="webapp.db.debug=false"  oder  POST /api/logging
+Q_DECLARE_LOGGING_CATEGORY(lcHttp)
+Q_DECLARE_LOGGING_CATEGORY(lcDb)
+Q_DECLARE_LOGGING_CATEGORY(lcAuth)
+
+// Asynchrones Logging über qInstallMessageHandler
+//
+// Der aufrufende Thread formatiert nur die Zeile und legt sie in einen
+// lock-freien Ringpuffer (MPSC). Ein Hintergrund-Thread schreibt gesammelt
+// nach stderr. Ist der Puffer voll, wird die Meldung verworfen und gezählt —
+// der Request-Pfad blockiert nie auf stderr.
+//
+// Format: JSON Lines (Default) oder Text (LOG_FORMAT=text)
+class AsyncLogger
+{
+public:
+    explicit AsyncLogger(int capacity = 8192);
+    ~AsyncLogger();
+
+    // Message-Handler installieren bzw. wiederherstellen (inkl. Flush)
+    void install();
+    void uninstall();
+
+    // Filterregeln setzen (Syntax wie QT_LOGGING_RULES, ';' oder '\n' getrennt)
+    static void setFilterRules(const QString &rules);
+    static QString filterRules();
+
+    // Zähler für /metrics
+    static QJsonObject stats();
+
+private:
+    struct Slot {
+        std::atomic<size_t> seq;
+        QByteArray line;
+    };
+
+    static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+    QByteArray format(QtMsgType type, const QMessageLogContext &context, const QString &msg) const;
+
+    bool tryPush(QByteArray &&line);
+    bool tryPop(QByteArray &line);
+    void writerLoop();
+    void writeOut(const QByteArray &data);
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) size_t m_dequeuePos = 0;        // nur Writer-Thread
+
+    std::atomic<quint64> m_written{0};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<bool> m_running{false};
+    bool m_json = true;
+
+    QThread *m_writer = nullptr;
+    QtMessageHandler m_previousHandler = nullptr;
+
+    // Von allen loggenden Threads gelesen
+    static std::atomic<AsyncLogger *> s_instance;
+};
+
+#endif // LOGGER_H
@@ -1,13 +1,40 @@
 #include <QCoreApplication>
 #include <QDebug>
+#include <QElapsedTimer>
 #include "server.h"
 #include "database.h"
 #include "authmanager.h"
+#include "logger.h"
+#include "allocprofiler.h"
 
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
 
+    // Asynchrones, strukturiertes Logging (stderr-Schreiben im Hintergrund-Thread)
+    AsyncLogger logger;
+    logger.install();
+
+    // Startzeit-Messung (Time-to-Listen) — pro Phase in ms
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+    qint64 phaseStart = 0;
+    auto phaseDone = [&](const char *phase) {
+        const qint64 now = startupTimer.elapsed();
+        qInfo().nospace() << "Startup: " << phase << " " << (now - phaseStart) << " ms";
+        phaseStart = now;
+    };
+
+    // Allokations-Profiling (nur mit CONFIG += alloc_profiling gebaut)
+    if (qEnvironmentVariableIntValue("ALLOC_PROFILING") == 1) {
+        if (AllocProfiler::compiledIn()) {
+            AllocProfiler::setEnabled(true);
+            qInfo() << "Allokations-Profiling aktiv (GET /debug/alloc)";
+        } else {
+            qWarning() << "ALLOC_PROFILING gesetzt, aber ohne CONFIG += alloc_profiling gebaut — ignoriert";
+        }
+    }
+
     qInfo() << "=== Qt WebApp Backend ===";
     qInfo() << "Qt Version:" << QT_VERSION_STR;
 
@@ -19,13 +46,19 @@ int main(int argc, char *argv[])
     }
 
     qInfo() << "Datenbank erfolgreich verbunden";
+    phaseDone("DB-Verbindung");
 
-    // Product-Tabelle anlegen + Beispieldaten einfügen
-    db.initProductTable();
+    // Schema-Migrationen (Fast Path: nur Versionsabfrage)
+    if (!db.migrateSchema()) {
+        qCritical() << "Schema-Migration fehlgeschlagen!";
+        return 1;
+    }
+    phaseDone("Schema-Migration");
 
     // Auth-Manager initialisieren
     AuthManager auth;
     qInfo() << "Authentifizierung aktiviert (Token-Lebensdauer:" << auth.tokenLifetime() / 3600 << "Stunden)";
+    phaseDone("Auth");
 
     // HTTP Server starten
     Server server(&db, &auth);
@@ -34,17 +67,28 @@ int main(int argc, char *argv[])
         qCritical() << "Server konnte nicht gestartet werden!";
         return 1;
     }
+    phaseDone("Listen");
+    qInfo() << "Startup: Time-to-Listen" << startupTimer.elapsed() << "ms";
 
     qInfo() << "Server läuft auf http://localhost:" + QString::number(port);
     qInfo() << "API Endpoints:";
+    qInfo() << "  GET  /health/live        (öffentlich)";
+    qInfo() << "  GET  /health/ready       (öffentlich, 503 wenn nicht bereit)";
     qInfo() << "  POST /api/login          (öffentlich)";
     qInfo() << "  GET  /api/greeting       (Auth erforderlich)";
     qInfo() << "  GET  /api/styles         (Auth erforderlich)";
     qInfo() << "  GET  /api/tables         (Auth erforderlich)";
     qInfo() << "  GET  /api/table?name=X   (Auth erforderlich)";
+    qInfo() << "  GET  /api/table/export?name=X&format=csv|ndjson (Auth erforderlich, gestreamt)";
+    qInfo() << "  POST /api/batch          (Auth erforderlich)";
+    qInfo() << "  GET  /api/products/events (Auth erforderlich, SSE)";
     qInfo() << "  POST /api/shutdown       (Auth erforderlich)";
+    qInfo() << "  GET  /api/logging        (Auth erforderlich, POST setzt Regeln)";
+    qInfo() << "  GET  /metrics            (intern)";
+    qInfo() << "  GET  /*                  (Frontend aus STATIC_DIR, falls gesetzt)";
+    qInfo() << "  GET  /debug/alloc        (intern, nur mit alloc_profiling)";
     qInfo() << "";
-    qInfo() << "Env-Variablen: API_USER, API_PASSWORD, API_SECRET";
+    qInfo() << "Env-Variablen: API_USER, API_PASSWORD, API_SECRET, DB_POOL_SIZE, LOG_FORMAT, QT_LOGGING_RULES";
     qInfo() << "Drücke Ctrl+C zum Beenden";
 
     return app.exec();
@@ -0,0 +1,199 @@
+#include "notifylistener.h"
+#include "logger.h"
+#include <QDebug>
+#include <libpq-fe.h>
+
+NotifyListener::NotifyListener(const QString &connInfo, QObject *parent)
+    : QObject(parent), connInfo(connInfo)
+{
+    reconnectTimer.setInterval(2000);
+    reconnectTimer.setSingleShot(true);
+    connect(&reconnectTimer, &QTimer::timeout, this, &NotifyListener::reconnect);
+}
+
+NotifyListener::~NotifyListener()
+{
+    closeConnection();
+}
+
+void NotifyListener::listen(const QString &channel)
+{
+    if (channels.contains(channel)) return;
+    channels << channel;
+    unsubscribed << channel;
+
+    if (state == State::Listening)
+        sendListens();
+}
+
+bool NotifyListener::start()
+{
+    if (openConnection()) return true;
+    reconnectTimer.start();
+    return false;
+}
+
+bool NotifyListener::openConnection()
+{
+    // Verbindungsaufbau ohne Blockieren — danach wie nach PGRES_POLLING_WRITING
+    conn = PQconnectStart(connInfo.toUtf8().constData());
+    if (!conn || PQstatus(conn) == CONNECTION_BAD) {
+        qCWarning(lcDb) << "LISTEN-Verbindung fehlgeschlagen:" << PQerrorMessage(conn);
+        PQfinish(conn);
+        conn = nullptr;
+        return false;
+    }
+    state = State::Connecting;
+    queryPending = false;
+    announced = false;
+    unsubscribed = channels;
+    watch(QSocketNotifier::Write);
+    return true;
+}
+
+void NotifyListener::closeConnection()
+{
+    if (notifier) {
+        notifier->setEnabled(false);
+        notifier->deleteLater();
+        notifier = nullptr;
+    }
+    if (conn) {
+        PQfinish(conn);
+        conn = nullptr;
+    }
+    state = State::Disconnected;
+}
+
+void NotifyListener::lost(const QString &message)
+{
+    qCWarning(lcDb) << message << PQerrorMessage(conn);
+    closeConnection();
+    reconnectTimer.start();
+}
+
+void NotifyListener::reconnect()
+{
+    reconnecting = true;
+    if (!openConnection())
+        reconnectTimer.start();
+}
+
+void NotifyListener::watch(QSocketNotifier::Type type)
+{
+    // Der Socket kann sich während PQconnectPoll ändern — Notifier neu anlegen
+    if (notifier) {
+        notifier->setEnabled(false);
+        notifier->deleteLater();
+    }
+    notifier = new QSocketNotifier(PQsocket(conn), type, this);
+    connect(notifier, &QSocketNotifier::activated, this, &NotifyListener::onSocket);
+}
+
+void NotifyListener::onSocket()
+{
+    if (!conn) return;
+
+    if (state == State::Connecting) {
+        poll();
+        return;
+    }
+    // LISTEN noch nicht ganz verschickt → weiter senden
+    if (notifier->type() == QSocketNotifier::Write) {
+        const int pending = PQflush(conn);
+        if (pending < 0)
+            lost("LISTEN nicht gesendet:");
+        else if (pending == 0)
+            watch(QSocketNotifier::Read);
+        return;
+    }
+    readInput();
+}
+
+void NotifyListener::poll()
+{
+    switch (PQconnectPoll(conn)) {
+    case PGRES_POLLING_READING:
+        watch(QSocketNotifier::Read);
+        break;
+    case PGRES_POLLING_WRITING:
+        watch(QSocketNotifier::Write);
+        break;
+    case PGRES_POLLING_OK:
+        // Nicht-blockierend senden und lesen
+        PQsetnonblocking(conn, 1);
+        state = State::Listening;
+        watch(QSocketNotifier::Read);
+        sendListens();
+        break;
+    default:
+        lost("LISTEN-Verbindung fehlgeschlagen:");
+        break;
+    }
+}
+
+void NotifyListener::sendListens()
+{
+    // Immer nur eine Abfrage gleichzeitig — weitere Kanäle nach dem Ergebnis
+    if (queryPending || unsubscribed.isEmpty()) return;
+
+    QByteArray sql;
+    for (const QString &channel : std::as_const(unsubscribed)) {
+        const QByteArray name = channel.toUtf8();
+        char *ident = PQescapeIdentifier(conn, name.constData(), size_t(name.size()));
+        if (!ident) {
+            qCWarning(lcDb) << "LISTEN" << channel << "fehlgeschlagen:" << PQerrorMessage(conn);
+            continue;
+        }
+        sql += QByteArray("LISTEN ") + ident + ';';
+        PQfreemem(ident);
+    }
+    unsubscribed.clear();
+    if (sql.isEmpty()) return;
+
+    if (!PQsendQuery(conn, sql.constData())) {
+        lost("LISTEN nicht gesendet:");
+        return;
+    }
+    queryPending = true;
+    const int pending = PQflush(conn);
+    if (pending < 0)
+        lost("LISTEN nicht gesendet:");
+    else if (pending == 1)
+        watch(QSocketNotifier::Write);
+}
+
+void NotifyListener::readInput()
+{
+    if (!PQconsumeInput(conn) || PQstatus(conn) != CONNECTION_OK) {
+        lost("LISTEN-Verbindung verloren:");
+        return;
+    }
+
+    // Ergebnis des LISTEN abholen, sobald es vollständig ist
+    if (queryPending && !PQisBusy(conn)) {
+        while (PGresult *res = PQgetResult(conn)) {
+            if (PQresultStatus(res) != PGRES_COMMAND_OK)
+                qCWarning(lcDb) << "LISTEN fehlgeschlagen:" << PQresultErrorMessage(res);
+            PQclear(res);
+        }
+        queryPending = false;
+
+        if (!announced) {
+            announced = true;
+            qCInfo(lcDb) << "LISTEN aktiv auf" << channels;
+            // Nach einem Verbindungsverlust können Notifications fehlen
+            if (reconnecting) {
+                reconnecting = false;
+                emit reconnected();
+            }
+        }
+        sendListens();
+        if (!conn) return;
+    }
+
+    while (PGnotify *n = PQnotifies(conn)) {
+        emit notification(QString::fromUtf8(n->relname), QByteArray(n->extra));
+        PQfreemem(n);
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef NOTIFYLISTENER_H
+#define NOTIFYLISTENER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QSocketNotifier>
+#include <QStringList>
+#include <QTimer>
+
+typedef struct pg_conn PGconn;
+
+// PostgreSQL LISTEN/NOTIFY über eine eigene libpq-Verbindung
+//
+// Der Socket der Verbindung hängt per QSocketNotifier am Event-Loop —
+// Notifications kommen ohne Polling an. Verbindungsaufbau (PQconnectPoll)
+// und LISTEN (PQsendQuery) laufen ebenfalls über den Notifier, der
+// Event-Loop wartet nie auf die Datenbank. Bricht die Verbindung ab, wird
+// automatisch neu verbunden und reconnected() gemeldet, sobald LISTEN
+// wieder aktiv ist (Verbraucher müssen dann davon ausgehen,
+// Notifications verpasst zu haben).
+class NotifyListener : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit NotifyListener(const QString &connInfo, QObject *parent = nullptr);
+    ~NotifyListener();
+
+    // Kanal abonnieren (auch vor start() möglich)
+    void listen(const QString &channel);
+
+    // Verbindungsaufbau anstoßen; false, wenn er sofort scheitert
+    // (dann neuer Versuch per Timer)
+    bool start();
+    bool isConnected() const { return state == State::Listening; }
+
+signals:
+    void notification(const QString &channel, const QByteArray &payload);
+    void reconnected();
+
+private slots:
+    void onSocket();
+    void reconnect();
+
+private:
+    enum class State { Disconnected, Connecting, Listening };
+
+    bool openConnection();
+    void closeConnection();
+    void lost(const QString &message);
+    void watch(QSocketNotifier::Type type);
+    void poll();
+    void sendListens();
+    void readInput();
+
+    QString connInfo;
+    QStringList channels;
+    QStringList unsubscribed;        // noch kein LISTEN auf der aktuellen Verbindung
+    PGconn *conn = nullptr;
+    QSocketNotifier *notifier = nullptr;
+    QTimer reconnectTimer;
+    State state = State::Disconnected;
+    bool queryPending = false;       // LISTEN verschickt, Ergebnis steht aus
+    bool announced = false;          // erstes LISTEN nach Verbindungsaufbau bestätigt
+    bool reconnecting = false;       // reconnected() melden, sobald LISTEN wieder aktiv ist
+};
+
+#endif // NOTIFYLISTENER_H
@@ -0,0 +1,423 @@
+#include "productstats.h"
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QThreadPool>
+#include <QUrlQuery>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// Blockgröße: groß genug, dass sich die Akkumulatoren je Block lohnen,
+// klein genug für eine gleichmäßige Verteilung auf die Threads
+static const qint64 MinChunkRows = 1 << 16;
+static const int ChunksPerThread = 4;
+static const int MaxBandEdges = 32;
+
+// ===== ProductSnapshot =====
+
+void ProductSnapshot::Keys::append(qint64 key)
+{
+    auto it = index.constFind(key);
+    if (it == index.cend()) {
+        it = index.insert(key, quint32(values.size()));
+        values.append(key);
+    }
+    group.append(*it);
+}
+
+void ProductSnapshot::reserve(qint64 rows)
+{
+    category.group.reserve(rows);
+    supplier.group.reserve(rows);
+    salesPrice.reserve(rows);
+    margin.reserve(rows);
+    hasPurchase.reserve(rows);
+    vatCode.reserve(rows);
+}
+
+void ProductSnapshot::appendRow(qint64 categoryId, qint64 supplierId, double purchasePrice,
+                                double price, int vat)
+{
+    const bool purchase = !std::isnan(purchasePrice);
+    category.append(categoryId);
+    supplier.append(supplierId);
+    salesPrice.append(price);
+    margin.append(purchase ? price - purchasePrice : 0.0);
+    hasPurchase.append(purchase ? 1 : 0);
+    vatCode.append(quint8(qBound(0, vat, VatCodes - 1)));
+}
+
+void ProductSnapshot::appendRows(QSqlQuery &query)
+{
+    auto key = [&query](int column) {
+        const QVariant v = query.value(column);
+        return v.isNull() ? NullKey : v.toLongLong();
+    };
+
+    while (query.next()) {
+        const QVariant purchase = query.value(2);
+        appendRow(key(0), key(1),
+                  purchase.isNull() ? std::nan("") : purchase.toDouble(),
+                  query.value(3).toDouble(), query.value(4).toInt());
+    }
+}
+
+void ProductSnapshot::finish(qint64 elapsedMs)
+{
+    // Hash-Maps werden nach dem Aufbau nicht mehr gebraucht
+    category.index.clear();
+    supplier.index.clear();
+    builtAt = QDateTime::currentDateTimeUtc();
+    buildMs = elapsedMs;
+}
+
+ProductSnapshot ProductSnapshot::fromQuery(QSqlQuery &query)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    ProductSnapshot s;
+    s.appendRows(query);
+    s.finish(timer.elapsed());
+    return s;
+}
+
+// ===== Aggregation =====
+
+namespace {
+
+// Akkumulatoren je Gruppe für einen Block
+struct Partial {
+    int bandCount = 0;
+    QVector<qint64> count;
+    QVector<double> sum, min, max;
+    QVector<double> marginSum;
+    QVector<qint64> marginCount;
+    QVector<qint64> vat;       // groups × VatCodes
+    QVector<qint64> bands;     // groups × bandCount
+
+    Partial() = default;
+    Partial(int groups, const ProductStats::Request &request)
+        : bandCount(int(request.bandEdges.size()) + 1)
+        , count(groups, 0)
+        , sum(groups, 0.0)
+        , min(groups, std::numeric_limits<double>::infinity())
+        , max(groups, -std::numeric_limits<double>::infinity())
+    {
+        if (request.metrics & ProductStats::Margin) {
+            marginSum.fill(0.0, groups);
+            marginCount.fill(0, groups);
+        }
+        if (request.metrics & ProductStats::Vat)
+            vat.fill(0, groups * ProductSnapshot::VatCodes);
+        if (request.metrics & ProductStats::Bands)
+            bands.fill(0, groups * bandCount);
+    }
+
+    void merge(const Partial &other)
+    {
+        if (count.isEmpty()) { *this = other; return; }
+        for (qsizetype g = 0; g < count.size(); ++g) {
+            count[g] += other.count.at(g);
+            sum[g] += other.sum.at(g);
+            min[g] = std::min(min.at(g), other.min.at(g));
+            max[g] = std::max(max.at(g), other.max.at(g));
+        }
+        for (qsizetype g = 0; g < marginSum.size(); ++g) {
+            marginSum[g] += other.marginSum.at(g);
+            marginCount[g] += other.marginCount.at(g);
+        }
+        for (qsizetype i = 0; i < vat.size(); ++i)
+            vat[i] += other.vat.at(i);
+        for (qsizetype i = 0; i < bands.size(); ++i)
+            bands[i] += other.bands.at(i);
+    }
+};
+
+// Eine Schleife je Kennzahl; groupOf(i) liefert die Gruppe der Zeile
+template <typename GroupOf>
+void accumulateGroups(const ProductSnapshot &s, const ProductStats::Request &request, int metrics,
+                      bool countRows, qint64 begin, qint64 end, GroupOf groupOf, Partial &p)
+{
+    const double *price = s.salesPrice.constData();
+
+    if (countRows) {
+        qint64 *count = p.count.data();
+        for (qint64 i = begin; i < end; ++i)
+            ++count[groupOf(i)];
+    }
+    if (metrics & (ProductStats::Sum | ProductStats::Avg)) {
+        double *sum = p.sum.data();
+        for (qint64 i = begin; i < end; ++i)
+            sum[groupOf(i)] += price[i];
+    }
+    if (metrics & ProductStats::Min) {
+        double *min = p.min.data();
+        for (qint64 i = begin; i < end; ++i) {
+            const quint32 g = groupOf(i);
+            min[g] = std::min(min[g], price[i]);
+        }
+    }
+    if (metrics & ProductStats::Max) {
+        double *max = p.max.data();
+        for (qint64 i = begin; i < end; ++i) {
+            const quint32 g = groupOf(i);
+            max[g] = std::max(max[g], price[i]);
+        }
+    }
+    if (metrics & ProductStats::Margin) {
+        const double *margin = s.margin.constData();
+        const quint8 *hasPurchase = s.hasPurchase.constData();
+        double *marginSum = p.marginSum.data();
+        qint64 *marginCount = p.marginCount.data();
+        for (qint64 i = begin; i < end; ++i) {
+            const quint32 g = groupOf(i);
+            marginSum[g] += margin[i];
+            marginCount[g] += hasPurchase[i];
+        }
+    }
+    if (metrics & ProductStats::Vat) {
+        const quint8 *vatCode = s.vatCode.constData();
+        qint64 *vat = p.vat.data();
+        for (qint64 i = begin; i < end; ++i)
+            ++vat[groupOf(i) * ProductSnapshot::VatCodes + vatCode[i]];
+    }
+    if (metrics & ProductStats::Bands) {
+        // Band = Anzahl der Grenzen ≤ Preis (ohne Sprung, wenige Grenzen)
+        const double *edges = request.bandEdges.constData();
+        const int edgeCount = int(request.bandEdges.size());
+        qint64 *bands = p.bands.data();
+        for (qint64 i = begin; i < end; ++i) {
+            int band = 0;
+            for (int e = 0; e < edgeCount; ++e)
+                band += price[i] >= edges[e];
+            ++bands[groupOf(i) * p.bandCount + band];
+        }
+    }
+}
+
+// Ohne group_by: Reduktion in vier Spuren (unabhängige Additionen → SIMD)
+void accumulateTotal(const ProductSnapshot &s, const ProductStats::Request &request,
+                     qint64 begin, qint64 end, Partial &p)
+{
+    const double *price = s.salesPrice.constData() + begin;
+    const qint64 n = end - begin;
+
+    double sum[4] = { 0, 0, 0, 0 };
+    double min[4], max[4];
+    std::fill(min, min + 4, std::numeric_limits<double>::infinity());
+    std::fill(max, max + 4, -std::numeric_limits<double>::infinity());
+
+    qint64 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int l = 0; l < 4; ++l) {
+            sum[l] += price[i + l];
+            min[l] = std::min(min[l], price[i + l]);
+            max[l] = std::max(max[l], price[i + l]);
+        }
+    }
+    for (; i < n; ++i) {
+        sum[0] += price[i];
+        min[0] = std::min(min[0], price[i]);
+        max[0] = std::max(max[0], price[i]);
+    }
+
+    p.count[0] += n;
+    p.sum[0] += (sum[0] + sum[1]) + (sum[2] + sum[3]);
+    p.min[0] = std::min({ p.min[0], min[0], min[1], min[2], min[3] });
+    p.max[0] = std::max({ p.max[0], max[0], max[1], max[2], max[3] });
+
+    if (request.metrics & ProductStats::Margin) {
+        const double *margin = s.margin.constData() + begin;
+        const quint8 *hasPurchase = s.hasPurchase.constData() + begin;
+        double msum[4] = { 0, 0, 0, 0 };
+        qint64 mcount = 0;
+        qint64 j = 0;
+        for (; j + 4 <= n; j += 4) {
+            for (int l = 0; l < 4; ++l) {
+                msum[l] += margin[j + l];
+                mcount += hasPurchase[j + l];
+            }
+        }
+        for (; j < n; ++j) {
+            msum[0] += margin[j];
+            mcount += hasPurchase[j];
+        }
+        p.marginSum[0] += (msum[0] + msum[1]) + (msum[2] + msum[3]);
+        p.marginCount[0] += mcount;
+    }
+
+    const int rest = request.metrics & (ProductStats::Vat | ProductStats::Bands);
+    if (rest)
+        accumulateGroups(s, request, rest, false, begin, end, [](qint64) { return quint32(0); }, p);
+}
+
+double cents(double value)
+{
+    return std::round(value * 100.0) / 100.0;
+}
+
+QJsonObject groupJson(const Partial &p, int g, const ProductStats::Request &request)
+{
+    QJsonObject o;
+    const qint64 count = p.count.at(g);
+    o["count"] = count;
+    if (request.metrics & ProductStats::Sum) o["sum"] = cents(p.sum.at(g));
+    if (request.metrics & ProductStats::Avg) o["avg"] = count > 0 ? p.sum.at(g) / count : 0.0;
+    if (count > 0) {
+        if (request.metrics & ProductStats::Min) o["min"] = cents(p.min.at(g));
+        if (request.metrics & ProductStats::Max) o["max"] = cents(p.max.at(g));
+    }
+    if (request.metrics & ProductStats::Margin) {
+        const qint64 n = p.marginCount.at(g);
+        QJsonObject m;
+        m["sum"] = cents(p.marginSum.at(g));
+        m["avg"] = n > 0 ? p.marginSum.at(g) / n : 0.0;
+        m["count"] = n;   // Produkte mit Einkaufspreis
+        o["margin"] = m;
+    }
+    if (request.metrics & ProductStats::Vat) {
+        QJsonObject vat;
+        for (int c = 0; c < ProductSnapshot::VatCodes; ++c) {
+            const qint64 n = p.vat.at(g * ProductSnapshot::VatCodes + c);
+            if (n > 0) vat[QString::number(c)] = n;
+        }
+        o["vat"] = vat;
+    }
+    if (request.metrics & ProductStats::Bands) {
+        QJsonArray bands;
+        for (int b = 0; b < p.bandCount; ++b)
+            bands.append(p.bands.at(g * p.bandCount + b));
+        o["bands"] = bands;
+    }
+    return o;
+}
+
+} // namespace
+
+bool ProductStats::parseRequest(const QUrlQuery &query, Request *request, QString *error)
+{
+    const QString groupBy = query.queryItemValue("group_by");
+    if (groupBy == "category_id")
+        request->groupBy = GroupBy::Category;
+    else if (groupBy == "supplier_id")
+        request->groupBy = GroupBy::Supplier;
+    else if (groupBy.isEmpty())
+        request->groupBy = GroupBy::None;
+    else {
+        *error = "group_by muss category_id oder supplier_id sein";
+        return false;
+    }
+
+    const QString metrics = query.queryItemValue("metrics");
+    if (!metrics.isEmpty()) {
+        static const QHash<QString, int> names = {
+            { "sum", Sum }, { "avg", Avg }, { "min", Min }, { "max", Max },
+            { "margin", Margin }, { "vat", Vat }, { "bands", Bands }
+        };
+        request->metrics = 0;
+        for (const QString &m : metrics.split(',', Qt::SkipEmptyParts)) {
+            const int flag = names.value(m.trimmed(), 0);
+            if (!flag) {
+                *error = "Unbekannte Kennzahl: " + m.trimmed();
+                return false;
+            }
+            request->metrics |= flag;
+        }
+    }
+
+    // bands=10,50,100 → Preisbänder <10, 10–50, 50–100, ≥100
+    const QString bands = query.queryItemValue("bands");
+    if (!bands.isEmpty()) {
+        request->metrics |= Bands;
+        for (const QString &e : bands.split(',', Qt::SkipEmptyParts)) {
+            bool ok = false;
+            const double edge = e.trimmed().toDouble(&ok);
+            if (!ok || (!request->bandEdges.isEmpty() && edge <= request->bandEdges.last())) {
+                *error = "bands: aufsteigende Zahlen erwartet";
+                return false;
+            }
+            request->bandEdges.append(edge);
+        }
+        if (request->bandEdges.size() > MaxBandEdges) {
+            *error = QString("bands: höchstens %1 Grenzen").arg(MaxBandEdges);
+            return false;
+        }
+    } else if (request->metrics & Bands) {
+        request->bandEdges = { 10, 50, 100, 500 };
+    }
+    return true;
+}
+
+QJsonObject ProductStats::aggregate(const ProductSnapshot &s, const Request &request)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const ProductSnapshot::Keys *keys = nullptr;
+    if (request.groupBy == GroupBy::Category) keys = &s.category;
+    if (request.groupBy == GroupBy::Supplier) keys = &s.supplier;
+    const int groups = keys ? int(keys->values.size()) : 1;
+    const qint64 rows = s.rowCount();
+
+    const int threads = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+    const qint64 chunk = qMax(MinChunkRows, (rows + threads * ChunksPerThread - 1) / (threads * ChunksPerThread));
+    QVector<QPair<qint64, qint64>> ranges;
+    for (qint64 b = 0; b < rows; b += chunk)
+        ranges.append({ b, qMin(rows, b + chunk) });
+
+    Partial total = QtConcurrent::blockingMappedReduced<Partial>(
+        ranges,
+        [&](const QPair<qint64, qint64> &range) {
+            Partial p(groups, request);
+            if (keys) {
+                const quint32 *group = keys->group.constData();
+                accumulateGroups(s, request, request.metrics, true, range.first, range.second,
+                                 [group](qint64 i) { return group[i]; }, p);
+            } else {
+                accumulateTotal(s, request, range.first, range.second, p);
+            }
+            return p;
+        },
+        [](Partial &result, const Partial &part) { result.merge(part); },
+        QtConcurrent::UnorderedReduce);
+    if (total.count.isEmpty())
+        total = Partial(groups, request);
+
+    QJsonObject result;
+    result["rows"] = rows;
+    result["snapshotAt"] = s.builtAt.toString(Qt::ISODateWithMs);
+    if (request.metrics & Bands) {
+        QJsonArray edges;
+        for (double e : request.bandEdges) edges.append(e);
+        result["bandEdges"] = edges;
+    }
+
+    if (!keys) {
+        result["groupBy"] = QJsonValue::Null;
+        result["totals"] = groupJson(total, 0, request);
+    } else {
+        result["groupBy"] = request.groupBy == GroupBy::Category ? "category_id" : "supplier_id";
+
+        // Nach Schlüssel sortiert, NULL zuerst
+        QVector<int> order(groups);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [keys](int a, int b) {
+            return keys->values.at(a) < keys->values.at(b);
+        });
+
+        QJsonArray list;
+        for (int g : order) {
+            QJsonObject o = groupJson(total, g, request);
+            const qint64 key = keys->values.at(g);
+            o["key"] = key == ProductSnapshot::NullKey ? QJsonValue(QJsonValue::Null) : QJsonValue(key);
+            list.append(o);
+        }
+        result["groups"] = list;
+    }
+    result["computeMs"] = timer.elapsed();
+    return result;
+}
@@ -0,0 +1,96 @@
+#ifndef PRODUCTSTATS_H
+#define PRODUCTSTATS_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+#include <limits>
+
+class QSqlQuery;
+class QUrlQuery;
+
+// Spaltenweiser Schnappschuss der product-Tabelle (Structure of Arrays)
+//
+// Enthält nur, was die Auswertung braucht, jede Spalte als eigenes
+// zusammenhängendes Array. Gruppenschlüssel (category_id, supplier_id)
+// sind dicht durchnummeriert, die Schleifen indizieren damit direkt in
+// die Akkumulatoren statt über eine Hash-Map.
+struct ProductSnapshot
+{
+    // Schlüsselwert für NULL (Produkte ohne Kategorie/Lieferant)
+    static constexpr qint64 NullKey = std::numeric_limits<qint64>::min();
+    // vat_code ist NUMBER(1)
+    static const int VatCodes = 10;
+
+    struct Keys {
+        QVector<quint32> group;          // Gruppe je Zeile
+        QVector<qint64> values;          // Schlüssel je Gruppe
+        QHash<qint64, quint32> index;    // nur beim Aufbau
+
+        void append(qint64 key);
+    };
+
+    Keys category;
+    Keys supplier;
+    QVector<double> salesPrice;
+    QVector<double> margin;              // sales - purchase, 0 ohne Einkaufspreis
+    QVector<quint8> hasPurchase;         // 1 = purchase_price gesetzt
+    QVector<quint8> vatCode;
+
+    QDateTime builtAt;
+    qint64 buildMs = 0;
+
+    qint64 rowCount() const { return salesPrice.size(); }
+    void reserve(qint64 rows);
+
+    // purchasePrice NaN = NULL
+    void appendRow(qint64 categoryId, qint64 supplierId, double purchasePrice,
+                   double salesPrice, int vatCode);
+
+    // Zeilen aus SELECT category_id, supplier_id, purchase_price, sales_price, vat_code
+    void appendRows(QSqlQuery &query);
+    // Nach dem Aufbau: Hash-Maps freigeben, builtAt/buildMs setzen
+    void finish(qint64 elapsedMs);
+
+    // appendRows() + finish() in einem
+    static ProductSnapshot fromQuery(QSqlQuery &query);
+};
+
+// Aggregation über einen ProductSnapshot (GET /api/products/stats)
+//
+// Die Zeilen werden in Blöcke geteilt und parallel im globalen
+// Thread-Pool aggregiert (QtConcurrent::blockingMappedReduced), jeder Block
+// mit eigenen Akkumulatoren je Gruppe. Die inneren Schleifen laufen über
+// nackte Arrays, eine Schleife je Kennzahl, ohne Verzweigungen; ohne
+// group_by rechnen sum/min/max in vier unabhängigen Spuren, damit der
+// Compiler vektorisieren kann.
+class ProductStats
+{
+public:
+    enum class GroupBy { None, Category, Supplier };
+
+    enum Metric {
+        Sum    = 0x01,
+        Avg    = 0x02,
+        Min    = 0x04,
+        Max    = 0x08,
+        Margin = 0x10,
+        Vat    = 0x20,
+        Bands  = 0x40
+    };
+
+    struct Request {
+        GroupBy groupBy = GroupBy::None;
+        int metrics = Sum | Avg | Min | Max;
+        QVector<double> bandEdges;       // aufsteigend, Band i = [edge(i-1), edge(i))
+    };
+
+    // group_by, metrics, bands aus der URL — false + error bei ungültigen Werten
+    static bool parseRequest(const QUrlQuery &query, Request *request, QString *error);
+
+    static QJsonObject aggregate(const ProductSnapshot &snapshot, const Request &request);
+};
+
+#endif // PRODUCTSTATS_H
@@ -0,0 +1,310 @@
+#include "queryguard.h"
+#include "logger.h"
+#include "requestcontext.h"
+#include <QSqlDriver>
+#include <QSqlQuery>
+#include <QTcpSocket>
+#include <libpq-fe.h>
+#include <utility>
+
+static const int DefaultBudgetMs = 30000;
+
+// Budgets ohne DB_ROUTE_TIMEOUTS — die Auswertung liest die ganze Tabelle
+static const struct { const char *route; int ms; } DefaultRouteBudgets[] = {
+    { "GET /api/greeting",      2000 },
+    { "GET /api/tables",        5000 },
+    { "GET /api/table",        15000 },
+    { "GET /api/products",     10000 },
+    { "GET /api/products/{id}", 5000 },
+    { "GET /api/products/stats", 60000 },
+};
+
+// Zustand des aufrufenden Threads
+static thread_local quint64 currentTicket = 0;
+static thread_local QueryGuard::Reason lastReasonValue = QueryGuard::Reason::None;
+static thread_local QString lastMessageValue;
+// Zuletzt gesetzter statement_timeout je Verbindung (Name). Nach einem
+// Reconnect ist es eine neue Sitzung mit Default — Handle und Backend-PID
+// unterscheiden sie von der alten, auch wenn libpq die Adresse wiederverwendet.
+struct AppliedTimeout {
+    PGconn *pg = nullptr;
+    int backendPid = 0;
+    int budget = 0;
+};
+static thread_local QHash<QString, AppliedTimeout> appliedTimeouts;
+
+QueryGuard::QueryGuard(QObject *parent)
+    : QObject(parent)
+{
+    const int budget = qEnvironmentVariableIntValue("DB_STATEMENT_TIMEOUT_MS");
+    defaultBudget = budget > 0 ? budget : DefaultBudgetMs;
+
+    for (const auto &b : DefaultRouteBudgets)
+        routeBudgets.insert(b.route, b.ms);
+
+    // DB_ROUTE_TIMEOUTS="GET /api/table=5000;GET /api/products=2000"
+    for (const QString &entry : qEnvironmentVariable("DB_ROUTE_TIMEOUTS").split(';', Qt::SkipEmptyParts)) {
+        const qsizetype eq = entry.lastIndexOf('=');
+        bool ok = false;
+        const int ms = eq > 0 ? entry.mid(eq + 1).trimmed().toInt(&ok) : 0;
+        if (!ok || ms <= 0) {
+            qCWarning(lcDb) << "DB_ROUTE_TIMEOUTS: ungültiger Eintrag" << entry;
+            continue;
+        }
+        routeBudgets.insert(entry.left(eq).trimmed().toUtf8(), ms);
+    }
+
+    cancelPool.setMaxThreadCount(2);
+    cancelPool.setExpiryTimeout(30000);
+
+    deadlineTimer.setInterval(100);
+    connect(&deadlineTimer, &QTimer::timeout, this, &QueryGuard::sweepDeadlines);
+}
+
+int QueryGuard::budgetMs(const QByteArray &route) const
+{
+    return routeBudgets.value(route, defaultBudget);
+}
+
+quint64 QueryGuard::watch(const QByteArray &route, qint64 elapsedMs)
+{
+    // Budget gilt für den ganzen Request inkl. Wartezeit im Pool
+    Watched w;
+    w.deadline = QDeadlineTimer(qMax<qint64>(0, budgetMs(route) - elapsedMs));
+    quint64 ticket;
+    {
+        QMutexLocker lock(&mutex);
+        ticket = ++nextTicket;
+        watched.insert(ticket, w);
+    }
+    if (!deadlineTimer.isActive())
+        deadlineTimer.start();
+    return ticket;
+}
+
+quint64 QueryGuard::watch(const QByteArray &route, qint64 elapsedMs, QTcpSocket *socket)
+{
+    const quint64 ticket = watch(route, elapsedMs);
+
+    // Socket schon weg: gar nicht erst anfangen
+    if (!socket || socket->state() != QAbstractSocket::ConnectedState) {
+        cancel(ticket, Reason::Disconnect);
+        return ticket;
+    }
+
+    const QMetaObject::Connection c = connect(socket, &QTcpSocket::disconnected, this,
+                                              [this, ticket]() { cancel(ticket, Reason::Disconnect); });
+    QMutexLocker lock(&mutex);
+    watched[ticket].disconnected = c;
+    return ticket;
+}
+
+QueryGuard::Reason QueryGuard::unwatch(quint64 ticket)
+{
+    QMutexLocker lock(&mutex);
+    const Watched w = watched.take(ticket);
+    disconnect(w.disconnected);
+    return w.canceled;
+}
+
+void QueryGuard::cancel(quint64 ticket, Reason reason)
+{
+    QList<std::shared_ptr<PGcancel>> handles;
+    {
+        QMutexLocker lock(&mutex);
+        auto it = watched.find(ticket);
+        // Schon fertig oder schon abgebrochen
+        if (it == watched.end() || it->canceled != Reason::None)
+            return;
+        it->canceled = reason;
+        handles = it->handles;
+    }
+    qCDebug(lcDb) << "Abfrage abgebrochen:" << (reason == Reason::Disconnect ? "Client getrennt" : "Zeitbudget")
+                  << handles.size() << "laufend";
+    if (handles.isEmpty())
+        return;
+
+    // PQcancel schickt eine Abbruch-Anfrage über eine eigene Verbindung —
+    // außerhalb des Haupt-Threads; die geteilten Handles bleiben gültig,
+    // auch wenn der Worker inzwischen fertig ist
+    cancelPool.start([this, ticket, handles]() {
+        // Lock auch während PQcancel: Scope::~Scope wartet darauf, die
+        // Verbindung kann also nicht schon die Abfrage des nächsten
+        // Requests ausführen
+        QMutexLocker lock(&mutex);
+        for (const std::shared_ptr<PGcancel> &handle : handles) {
+            // Abfrage inzwischen fertig — nicht mehr abbrechen
+            const auto it = watched.constFind(ticket);
+            if (it == watched.cend() || !it->handles.contains(handle))
+                continue;
+            char error[256];
+            if (!PQcancel(handle.get(), error, sizeof(error))) {
+                qCWarning(lcDb) << "PQcancel fehlgeschlagen:" << error;
+                ++cancelFailures;
+            }
+        }
+    });
+}
+
+void QueryGuard::sweepDeadlines()
+{
+    QList<quint64> expired;
+    {
+        QMutexLocker lock(&mutex);
+        if (watched.isEmpty()) {
+            deadlineTimer.stop();
+            return;
+        }
+        for (auto it = watched.constBegin(); it != watched.constEnd(); ++it) {
+            if (it->canceled == Reason::None && it->deadline.hasExpired())
+                expired.append(it.key());
+        }
+    }
+    for (quint64 ticket : expired)
+        cancel(ticket, Reason::Deadline);
+}
+
+// ===== TICKET / SCOPE =====
+
+QueryGuard::Ticket::Ticket(quint64 ticket)
+    : previous(currentTicket)
+{
+    currentTicket = ticket;
+}
+
+QueryGuard::Ticket::~Ticket()
+{
+    currentTicket = previous;
+}
+
+QueryGuard::Scope::Scope(QueryGuard *guard, const QSqlDatabase &connection)
+    : m_guard(guard), m_ticket(currentTicket)
+{
+    if (!m_guard || connection.driverName() != "QPSQL")
+        return;
+
+    // Bereits abgebrochener Request: keine weitere Abfrage starten
+    if (m_ticket) {
+        QMutexLocker lock(&m_guard->mutex);
+        const auto it = m_guard->watched.constFind(m_ticket);
+        if (it != m_guard->watched.constEnd() && it->canceled != Reason::None) {
+            m_admitted = false;
+            ++m_guard->skipped;
+            lastReasonValue = it->canceled;
+            lastMessageValue = it->canceled == Reason::Disconnect
+                                   ? QStringLiteral("Abfrage abgebrochen (Client getrennt)")
+                                   : QStringLiteral("Zeitbudget des Requests überschritten");
+            return;
+        }
+    }
+
+    const QVariant handle = connection.driver()->handle();
+    if (!handle.isValid() || qstrcmp(handle.typeName(), "PGconn*") != 0)
+        return;
+    PGconn *pg = *static_cast<PGconn *const *>(handle.data());
+    if (!pg)
+        return;
+
+    // statement_timeout nur setzen, wenn sich das Budget geändert hat
+    const RequestContext *ctx = RequestContext::current();
+    const int budget = m_guard->budgetMs(ctx ? ctx->route() : QByteArray());
+    const AppliedTimeout current{ pg, PQbackendPID(pg), budget };
+    const AppliedTimeout applied = appliedTimeouts.value(connection.connectionName());
+    if (applied.pg != current.pg || applied.backendPid != current.backendPid || applied.budget != budget) {
+        QSqlQuery set(connection);
+        if (set.exec(QString("SET statement_timeout = %1").arg(budget))) {
+            appliedTimeouts.insert(connection.connectionName(), current);
+            QMutexLocker lock(&m_guard->mutex);
+            ++m_guard->timeoutSets;
+        }
+    }
+
+    if (m_ticket) {
+        if (PGcancel *handle = PQgetCancel(pg))
+            m_cancel = std::shared_ptr<PGcancel>(handle, PQfreeCancel);
+        QMutexLocker lock(&m_guard->mutex);
+        auto it = m_guard->watched.find(m_ticket);
+        if (it != m_guard->watched.end() && m_cancel)
+            it->handles.append(m_cancel);
+    }
+}
+
+QueryGuard::Scope::~Scope()
+{
+    if (!m_cancel)
+        return;
+    // Freigegeben wird mit der letzten Referenz (evtl. erst nach einem Abbruch)
+    QMutexLocker lock(&m_guard->mutex);
+    auto it = m_guard->watched.find(m_ticket);
+    if (it != m_guard->watched.end())
+        it->handles.removeOne(m_cancel);
+}
+
+void QueryGuard::Scope::failed(const QSqlError &error)
+{
+    // 57014 = query_canceled: eigener PQcancel oder statement_timeout
+    if (!m_guard || error.nativeErrorCode() != "57014")
+        return;
+
+    QMutexLocker lock(&m_guard->mutex);
+    const auto it = m_guard->watched.constFind(m_ticket);
+    const Reason canceled = m_ticket && it != m_guard->watched.constEnd() ? it->canceled : Reason::None;
+    switch (canceled) {
+    case Reason::Disconnect:
+        ++m_guard->canceledDisconnect;
+        lastMessageValue = QStringLiteral("Abfrage abgebrochen (Client getrennt)");
+        break;
+    case Reason::Deadline:
+        ++m_guard->canceledDeadline;
+        lastMessageValue = QStringLiteral("Zeitbudget des Requests überschritten");
+        break;
+    case Reason::None:
+    case Reason::Timeout:
+        ++m_guard->timedOut;
+        lastMessageValue = QStringLiteral("Zeitlimit der Abfrage überschritten");
+        break;
+    }
+    lastReasonValue = canceled == Reason::None ? Reason::Timeout : canceled;
+}
+
+void QueryGuard::resetLast()
+{
+    lastReasonValue = Reason::None;
+    lastMessageValue.clear();
+}
+
+QueryGuard::Reason QueryGuard::lastReason()
+{
+    return lastReasonValue;
+}
+
+QString QueryGuard::lastMessage()
+{
+    return lastMessageValue;
+}
+
+int QueryGuard::inFlight() const
+{
+    QMutexLocker lock(&mutex);
+    return int(watched.size());
+}
+
+QJsonObject QueryGuard::stats() const
+{
+    QMutexLocker lock(&mutex);
+    QJsonObject budgets;
+    for (auto it = routeBudgets.constBegin(); it != routeBudgets.constEnd(); ++it)
+        budgets[QString::fromUtf8(it.key())] = it.value();
+
+    QJsonObject s;
+    s["timedOut"]           = qint64(timedOut);
+    s["canceledDisconnect"] = qint64(canceledDisconnect);
+    s["canceledDeadline"]   = qint64(canceledDeadline);
+    s["skipped"]            = qint64(skipped);
+    s["cancelFailures"]     = qint64(cancelFailures);
+    s["timeoutSets"]        = qint64(timeoutSets);
+    s["watching"]           = int(watched.size());
+    s["defaultBudgetMs"]    = defaultBudget;
+    s["routeBudgetsMs"]     = budgets;
+    return s;
+}
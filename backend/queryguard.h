@@ -0,0 +1,129 @@
+#ifndef QUERYGUARD_H
+#define QUERYGUARD_H
+
+#include <QObject>
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMetaObject>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QThreadPool>
+#include <QTimer>
+#include <memory>
+
+class QTcpSocket;
+struct pg_cancel;
+
+// Zeitbudgets und Abbruch laufender Abfragen (nur PostgreSQL)
+//
+// Jede Route hat ein Budget (DB_STATEMENT_TIMEOUT_MS, pro Route über
+// DB_ROUTE_TIMEOUTS), das als statement_timeout auf der Verbindung gesetzt
+// wird — nur wenn es sich gegenüber der letzten Abfrage dort geändert hat.
+//
+// Lesende Routen, die im Worker-Pool laufen, werden zusätzlich beobachtet
+// (watch): trennt der Client die Verbindung oder läuft das Budget des
+// ganzen Requests ab, bricht PQcancel die gerade laufende Abfrage ab, und
+// weitere Abfragen des Requests starten gar nicht erst.
+class QueryGuard : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Reason { None, Timeout, Disconnect, Deadline };
+
+    explicit QueryGuard(QObject *parent = nullptr);
+
+    // Budget in ms für eine Route ("GET /api/table", auch für Batch-Sub-Requests)
+    int budgetMs(const QByteArray &route) const;
+
+    // Haupt-Thread: Request beobachten, liefert das Ticket für den Worker
+    quint64 watch(const QByteArray &route, qint64 elapsedMs, QTcpSocket *socket);
+    // Ohne Client (Erneuerung im Hintergrund): nur das Budget zählt
+    quint64 watch(const QByteArray &route, qint64 elapsedMs);
+    // Haupt-Thread: Request fertig — liefert den Abbruchgrund (None = normal)
+    Reason unwatch(quint64 ticket);
+
+    // Ticket des aufrufenden Threads, solange das Objekt lebt
+    class Ticket
+    {
+    public:
+        explicit Ticket(quint64 ticket);
+        ~Ticket();
+    private:
+        quint64 previous;
+    };
+
+    // Um jede Abfrage in Database: setzt statement_timeout, meldet das
+    // Cancel-Handle an, wertet Fehler aus
+    class Scope
+    {
+    public:
+        Scope(QueryGuard *guard, const QSqlDatabase &connection);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        // false: Request schon abgebrochen, Abfrage nicht ausführen
+        bool admitted() const { return m_admitted; }
+        // Nach fehlgeschlagenem exec: Abbruch/Timeout erkennen und zählen
+        void failed(const QSqlError &error);
+
+    private:
+        QueryGuard *m_guard;
+        quint64 m_ticket;
+        std::shared_ptr<pg_cancel> m_cancel;
+        bool m_admitted = true;
+    };
+
+    // Ergebnis der letzten Abfrage im aufrufenden Thread (None = kein Abbruch)
+    static void resetLast();
+    static Reason lastReason();
+    static QString lastMessage();
+
+    // Beobachtete Requests, die gerade laufen oder auf den Pool warten
+    int inFlight() const;
+
+    // Abgebrochene und abgelaufene Abfragen (für /metrics)
+    QJsonObject stats() const;
+
+private:
+    struct Watched {
+        Reason canceled = Reason::None;
+        QDeadlineTimer deadline;
+        // Geteilt: ein Abbruch kann noch laufen, wenn der Worker schon fertig ist
+        QList<std::shared_ptr<pg_cancel>> handles;
+        QMetaObject::Connection disconnected;
+    };
+
+    void cancel(quint64 ticket, Reason reason);
+    // Abgelaufene Budgets abbrechen (alle 100 ms, solange etwas beobachtet wird)
+    void sweepDeadlines();
+
+    int defaultBudget;
+    QHash<QByteArray, int> routeBudgets;
+
+    mutable QMutex mutex;
+    QHash<quint64, Watched> watched;
+    quint64 nextTicket = 0;
+    QTimer deadlineTimer;
+
+    // Zähler (unter mutex)
+    quint64 timedOut = 0;
+    quint64 canceledDisconnect = 0;
+    quint64 canceledDeadline = 0;
+    quint64 skipped = 0;
+    quint64 cancelFailures = 0;
+    quint64 timeoutSets = 0;
+
+    // PQcancel baut eine eigene Verbindung auf und wartet auf die Antwort —
+    // weder im Haupt-Thread noch im DB-Pool (dort laufen die Abfragen, die
+    // abgebrochen werden sollen). Zuletzt deklariert: wartet im Destruktor
+    // auf laufende Abbrüche, bevor mutex und Zähler verschwinden.
+    QThreadPool cancelPool;
+};
+
+#endif // QUERYGUARD_H
@@ -0,0 +1,509 @@
+// Replay: Traffic-Mitschnitt erneut gegen ein Backend schicken
+//
+// Liest die Records aus CAPTURE_FILE und sendet sie in derselben
+// Reihenfolge und mit denselben Abständen (oder um --speed skaliert) an
+// <base-url>. Requests, die beim Mitschnitt angemeldet waren, bekommen ein
+// frisches Token aus /api/login (--user/--password bzw. API_USER/
+// API_PASSWORD). Ergebnis: Latenzverteilung je Route als JSON (--out), die
+// --compare für zwei Builds gegenüberstellt. Mitschnitte ab Formatversion 2
+// liefern die Latenz des Originals und dessen Status zum Vergleich mit.
+
+#include "capturelog.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSet>
+#include <QSslError>
+#include <QTimer>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// Nicht wiederholen: Stream ohne Ende, Server beenden, Anmeldung (macht der Replay selbst)
+static const char *const SkippedRoutes[] = {
+    "GET /api/products/events",
+    "POST /api/shutdown",
+    "POST /api/login",
+};
+
+static bool loadCapture(const QString &path, QList<CaptureLog::Record> *records, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(CaptureLog::StreamVersion);
+
+    char magic[sizeof(CaptureLog::Magic)];
+    quint32 version = 0;
+    qint64 startedAt = 0;
+    if (in.readRawData(magic, sizeof(magic)) != int(sizeof(magic))
+        || memcmp(magic, CaptureLog::Magic, sizeof(magic)) != 0) {
+        *error = "Kein Traffic-Mitschnitt";
+        return false;
+    }
+    in >> version >> startedAt;
+    if (version < 1 || version > CaptureLog::FormatVersion) {
+        *error = QString("Formatversion %1 nicht unterstützt").arg(version);
+        return false;
+    }
+
+    while (!in.atEnd()) {
+        CaptureLog::Record r;
+        CaptureLog::readRecord(in, r, version);
+        // Abgeschnittener letzter Record (Backend beendet während des Schreibens)
+        if (in.status() != QDataStream::Ok)
+            break;
+        records->append(r);
+    }
+    return true;
+}
+
+// Perzentil aus sortierten Werten (nächster Rang)
+static double percentile(const QList<double> &sorted, double p)
+{
+    if (sorted.isEmpty())
+        return 0;
+    const qsizetype rank = qsizetype(std::ceil(p / 100.0 * sorted.size()));
+    return sorted.at(qBound<qsizetype>(0, rank - 1, sorted.size() - 1));
+}
+
+static QJsonObject distribution(QList<double> ms, int errors)
+{
+    std::sort(ms.begin(), ms.end());
+    double sum = 0;
+    for (double v : std::as_const(ms))
+        sum += v;
+
+    QJsonObject d;
+    d["count"]  = int(ms.size());
+    d["errors"] = errors;
+    d["mean"]   = ms.isEmpty() ? 0 : sum / ms.size();
+    d["p50"]    = percentile(ms, 50);
+    d["p90"]    = percentile(ms, 90);
+    d["p99"]    = percentile(ms, 99);
+    d["p999"]   = percentile(ms, 99.9);
+    d["max"]    = ms.isEmpty() ? 0 : ms.last();
+    return d;
+}
+
+class Replay
+{
+public:
+    QNetworkAccessManager nam;
+    QByteArray baseUrl;
+    double speed = 1.0;
+    int concurrency = 6;
+    QString user;
+    QString password;
+
+    QList<CaptureLog::Record> records;
+    QByteArray token;
+
+    // Ergebnisse
+    QHash<QByteArray, QList<double>> latencies;
+    QHash<QByteArray, int> errors;
+    QHash<QByteArray, QList<double>> capturedLatencies;   // Original (Formatversion 2)
+    QHash<QByteArray, int> statusChanged;                 // anderer Status als im Original
+    int skipped = 0;
+    int relogins = 0;
+    double maxLagMs = 0;
+    double sumLagMs = 0;
+    qint64 wallMs = 0;
+
+    // Anmelden (falls nötig) und abspielen — Ende per QCoreApplication::exit
+    void start(bool needsAuth);
+
+private:
+    // Anmeldung ist ein Schritt im Ablauf, kein verschachtelter Event-Loop:
+    // Requests mit 401 warten, bis das neue Token da ist
+    void login();
+    void loggedIn(QNetworkReply *reply);
+    void run();
+    void schedule();
+    void dispatch(qsizetype index, bool retried);
+    void finished(qsizetype index, QNetworkReply *reply, qint64 startedNs, bool retried);
+
+    QElapsedTimer clock;
+    qint64 firstOffsetUs = 0;
+    qsizetype next = 0;
+    int inFlight = 0;
+    int done = 0;
+    int toSend = 0;
+    bool started = false;
+    bool loggingIn = false;
+    QList<qsizetype> waitingForLogin;
+    QElapsedTimer sinceLogin;
+};
+
+void Replay::start(bool needsAuth)
+{
+    if (!needsAuth) {
+        run();
+        return;
+    }
+    if (user.isEmpty()) {
+        std::fprintf(stderr, "Login fehlgeschlagen: Kein Benutzer (--user oder API_USER)\n");
+        QMetaObject::invokeMethod(qApp, [] { QCoreApplication::exit(1); }, Qt::QueuedConnection);
+        return;
+    }
+    login();
+}
+
+void Replay::login()
+{
+    loggingIn = true;
+    QNetworkRequest request(QUrl::fromEncoded(baseUrl + "/api/login"));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    QJsonObject body;
+    body["username"] = user;
+    body["password"] = password;
+
+    QNetworkReply *reply = nam.post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
+    QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply]() { loggedIn(reply); });
+}
+
+void Replay::loggedIn(QNetworkReply *reply)
+{
+    reply->deleteLater();
+    loggingIn = false;
+
+    const QJsonObject response = QJsonDocument::fromJson(reply->readAll()).object();
+    const bool ok = reply->error() == QNetworkReply::NoError && response.contains("token");
+    if (ok) {
+        token = "Bearer " + response["token"].toString().toUtf8();
+        sinceLogin.start();
+    }
+
+    if (!started) {
+        if (!ok) {
+            std::fprintf(stderr, "Login fehlgeschlagen: %s\n",
+                         qPrintable(response.value("error").toString(reply->errorString())));
+            QCoreApplication::exit(1);
+            return;
+        }
+        run();
+        return;
+    }
+
+    if (ok)
+        ++relogins;
+    // Mit neuem (oder bei Fehler altem) Token einmal wiederholen
+    const QList<qsizetype> retry = std::exchange(waitingForLogin, {});
+    for (qsizetype index : retry)
+        dispatch(index, true);
+}
+
+void Replay::run()
+{
+    started = true;
+    for (const CaptureLog::Record &r : std::as_const(records)) {
+        if (std::find(std::begin(SkippedRoutes), std::end(SkippedRoutes), r.route) == std::end(SkippedRoutes))
+            ++toSend;
+    }
+    firstOffsetUs = records.isEmpty() ? 0 : records.first().offsetUs;
+    clock.start();
+    if (toSend == 0) {
+        QMetaObject::invokeMethod(qApp, [] { QCoreApplication::quit(); }, Qt::QueuedConnection);
+        return;
+    }
+    schedule();
+}
+
+void Replay::schedule()
+{
+    while (next < records.size()) {
+        const CaptureLog::Record &r = records.at(next);
+        if (std::find(std::begin(SkippedRoutes), std::end(SkippedRoutes), r.route) != std::end(SkippedRoutes)) {
+            ++skipped;
+            ++next;
+            continue;
+        }
+
+        if (speed <= 0) {
+            // So schnell wie möglich, höchstens concurrency gleichzeitig
+            if (inFlight >= concurrency)
+                return;
+        } else {
+            // Originalabstände, skaliert: fällig bei (offset - erster offset) / speed
+            const double dueMs = (r.offsetUs - firstOffsetUs) / 1000.0 / speed;
+            const double nowMs = clock.nsecsElapsed() / 1e6;
+            if (dueMs > nowMs) {
+                QTimer::singleShot(int(std::ceil(dueMs - nowMs)), Qt::PreciseTimer, [this]() { schedule(); });
+                return;
+            }
+            const double lag = nowMs - dueMs;
+            maxLagMs = qMax(maxLagMs, lag);
+            sumLagMs += lag;
+        }
+        dispatch(next++, false);
+    }
+}
+
+void Replay::dispatch(qsizetype index, bool retried)
+{
+    const CaptureLog::Record &r = records.at(index);
+    QNetworkRequest request(QUrl::fromEncoded(baseUrl + r.target));
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::ManualRedirectPolicy);
+    request.setRawHeader("X-Request-Id", "replay-" + QByteArray::number(index));
+    if (!r.accept.isEmpty())
+        request.setRawHeader("Accept", r.accept);
+    if (!r.contentType.isEmpty())
+        request.setRawHeader("Content-Type", r.contentType);
+    if (!r.ifMatch.isEmpty())
+        request.setRawHeader("If-Match", r.ifMatch);
+    if (!r.ifNoneMatch.isEmpty())
+        request.setRawHeader("If-None-Match", r.ifNoneMatch);
+    if (r.authorized && !token.isEmpty())
+        request.setRawHeader("Authorization", token);
+
+    ++inFlight;
+    const qint64 startedNs = clock.nsecsElapsed();
+    QNetworkReply *reply = nam.sendCustomRequest(request, r.method, r.body);
+    QObject::connect(reply, &QNetworkReply::finished, reply, [this, index, reply, startedNs, retried]() {
+        finished(index, reply, startedNs, retried);
+    });
+}
+
+void Replay::finished(qsizetype index, QNetworkReply *reply, qint64 startedNs, bool retried)
+{
+    const double ms = (clock.nsecsElapsed() - startedNs) / 1e6;
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    reply->deleteLater();
+    --inFlight;
+
+    const CaptureLog::Record &r = records.at(index);
+
+    // Token abgelaufen: neu anmelden (höchstens alle 5 s) und einmal wiederholen
+    if (status == 401 && r.authorized && !retried && !user.isEmpty()) {
+        if (loggingIn || !sinceLogin.isValid() || sinceLogin.elapsed() > 5000) {
+            waitingForLogin.append(index);
+            if (!loggingIn)
+                login();
+        } else {
+            dispatch(index, true);
+        }
+        return;
+    }
+
+    // 304/412 sind erwartete Antworten auf mitgeschnittene Bedingungen
+    if (status == 0 || status >= 500 || status == 401)
+        ++errors[r.route];
+    else
+        latencies[r.route].append(ms);
+    if (r.durationUs >= 0)
+        capturedLatencies[r.route].append(r.durationUs / 1000.0);
+    if (r.status > 0 && status != r.status)
+        ++statusChanged[r.route];
+
+    if (++done == toSend) {
+        wallMs = clock.elapsed();
+        QCoreApplication::quit();
+        return;
+    }
+    schedule();
+}
+
+static QJsonObject summarize(const Replay &replay, const QString &capture)
+{
+    QJsonObject routes;
+    QList<double> all;
+    int allErrors = 0;
+    QSet<QByteArray> names;
+    for (auto it = replay.latencies.constBegin(); it != replay.latencies.constEnd(); ++it)
+        names.insert(it.key());
+    for (auto it = replay.errors.constBegin(); it != replay.errors.constEnd(); ++it)
+        names.insert(it.key());
+    for (const QByteArray &route : std::as_const(names)) {
+        const QList<double> ms = replay.latencies.value(route);
+        const int errors = replay.errors.value(route);
+        routes[QString::fromUtf8(route)] = distribution(ms, errors);
+        all += ms;
+        allErrors += errors;
+    }
+
+    QJsonObject s;
+    s["capture"]   = capture;
+    s["baseUrl"]   = QString::fromUtf8(replay.baseUrl);
+    s["speed"]     = replay.speed;
+    s["skipped"]   = replay.skipped;
+    s["relogins"]  = replay.relogins;
+    s["wallMs"]    = replay.wallMs;
+    s["maxLagMs"]  = replay.maxLagMs;
+    s["meanLagMs"] = all.size() + allErrors > 0 ? replay.sumLagMs / (all.size() + allErrors) : 0;
+    s["all"]       = distribution(all, allErrors);
+    s["routes"]    = routes;
+
+    // Original aus dem Mitschnitt (ab Formatversion 2) zum Vergleich
+    QJsonObject captured;
+    QList<double> capturedAll;
+    int changed = 0;
+    for (auto it = replay.capturedLatencies.constBegin(); it != replay.capturedLatencies.constEnd(); ++it) {
+        QJsonObject d = distribution(it.value(), 0);
+        d["statusChanged"] = replay.statusChanged.value(it.key());
+        captured[QString::fromUtf8(it.key())] = d;
+        capturedAll += it.value();
+    }
+    for (int n : replay.statusChanged)
+        changed += n;
+    if (!captured.isEmpty()) {
+        s["captured"]      = captured;
+        s["capturedAll"]   = distribution(capturedAll, 0);
+        s["statusChanged"] = changed;
+    }
+    return s;
+}
+
+static void printSummary(const QJsonObject &s)
+{
+    std::printf("%-36s %7s %6s %9s %9s %9s %9s\n", "Route", "Anzahl", "Fehler", "p50 ms", "p90 ms", "p99 ms", "max ms");
+    auto line = [](const QString &name, const QJsonObject &d) {
+        std::printf("%-36s %7d %6d %9.2f %9.2f %9.2f %9.2f\n", qPrintable(name), d["count"].toInt(),
+                    d["errors"].toInt(), d["p50"].toDouble(), d["p90"].toDouble(), d["p99"].toDouble(),
+                    d["max"].toDouble());
+    };
+    const QJsonObject routes = s["routes"].toObject();
+    for (auto it = routes.constBegin(); it != routes.constEnd(); ++it)
+        line(it.key(), it.value().toObject());
+    line("gesamt", s["all"].toObject());
+    std::printf("\nDauer %lld ms, übersprungen %d, max. Verzögerung beim Senden %.1f ms\n",
+                static_cast<long long>(s["wallMs"].toInteger()), s["skipped"].toInt(), s["maxLagMs"].toDouble());
+    if (s.contains("capturedAll")) {
+        const QJsonObject original = s["capturedAll"].toObject();
+        std::printf("Original: p50 %.2f ms, p99 %.2f ms; anderer Status als im Original: %d\n",
+                    original["p50"].toDouble(), original["p99"].toDouble(), s["statusChanged"].toInt());
+    }
+}
+
+// Zwei Ergebnisse gegenüberstellen — Rückgabe 2, wenn p50 oder p99 einer
+// Route um mehr als threshold % schlechter ist
+static int compare(const QString &pathA, const QString &pathB, double threshold)
+{
+    auto load = [](const QString &path) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            std::fprintf(stderr, "%s: %s\n", qPrintable(path), qPrintable(file.errorString()));
+            return QJsonObject();
+        }
+        return QJsonDocument::fromJson(file.readAll()).object();
+    };
+    const QJsonObject a = load(pathA);
+    const QJsonObject b = load(pathB);
+    if (a.isEmpty() || b.isEmpty())
+        return 1;
+
+    QMap<QString, QPair<QJsonObject, QJsonObject>> rows;
+    const QJsonObject routesA = a["routes"].toObject();
+    const QJsonObject routesB = b["routes"].toObject();
+    for (auto it = routesA.constBegin(); it != routesA.constEnd(); ++it)
+        rows[it.key()].first = it.value().toObject();
+    for (auto it = routesB.constBegin(); it != routesB.constEnd(); ++it)
+        rows[it.key()].second = it.value().toObject();
+    rows["gesamt"] = { a["all"].toObject(), b["all"].toObject() };
+
+    auto delta = [](double before, double after) { return before > 0 ? (after - before) / before * 100.0 : 0.0; };
+
+    bool regression = false;
+    std::printf("%-36s %7s %9s %9s %8s %9s %9s %8s\n", "Route", "Anzahl", "p50 A", "p50 B", "Δ", "p99 A", "p99 B", "Δ");
+    for (auto it = rows.constBegin(); it != rows.constEnd(); ++it) {
+        const QJsonObject &ra = it.value().first;
+        const QJsonObject &rb = it.value().second;
+        const double p50 = delta(ra["p50"].toDouble(), rb["p50"].toDouble());
+        const double p99 = delta(ra["p99"].toDouble(), rb["p99"].toDouble());
+        const bool worse = !ra.isEmpty() && !rb.isEmpty() && (p50 > threshold || p99 > threshold);
+        regression = regression || worse;
+        std::printf("%-36s %7d %9.2f %9.2f %7.1f%% %9.2f %9.2f %7.1f%%%s\n", qPrintable(it.key()),
+                    rb["count"].toInt(), ra["p50"].toDouble(), rb["p50"].toDouble(), p50,
+                    ra["p99"].toDouble(), rb["p99"].toDouble(), p99, worse ? "  !" : "");
+    }
+    if (regression)
+        std::printf("\n! = mehr als %.0f %% langsamer\n", threshold);
+    return regression ? 2 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Traffic-Mitschnitt (CAPTURE_FILE) gegen ein Backend wiederholen");
+    parser.addHelpOption();
+    parser.addPositionalArgument("capture", "Mitschnitt-Datei");
+    parser.addPositionalArgument("base-url", "z.B. http://localhost:3000");
+    const QCommandLineOption speedOption("speed", "Tempo relativ zum Original, 0 = so schnell wie möglich", "faktor", "1");
+    const QCommandLineOption concurrencyOption("concurrency", "Gleichzeitige Requests bei --speed 0", "n", "6");
+    const QCommandLineOption userOption("user", "Benutzer für /api/login (Default API_USER)", "name");
+    const QCommandLineOption passwordOption("password", "Passwort (Default API_PASSWORD)", "passwort");
+    const QCommandLineOption outOption("out", "Ergebnis als JSON speichern", "datei");
+    const QCommandLineOption limitOption("limit", "Nur die ersten n Records", "n");
+    const QCommandLineOption insecureOption("insecure", "TLS-Zertifikat nicht prüfen (selbstsigniert)");
+    const QCommandLineOption compareOption("compare", "Zwei Ergebnis-Dateien vergleichen: --compare a.json b.json");
+    const QCommandLineOption thresholdOption("threshold", "Regression ab Δ in % (--compare)", "prozent", "10");
+    parser.addOptions({ speedOption, concurrencyOption, userOption, passwordOption, outOption,
+                        limitOption, insecureOption, compareOption, thresholdOption });
+    parser.process(app);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 2)
+        parser.showHelp(1);
+
+    if (parser.isSet(compareOption))
+        return compare(args.at(0), args.at(1), parser.value(thresholdOption).toDouble());
+
+    Replay replay;
+    QString error;
+    if (!loadCapture(args.at(0), &replay.records, &error)) {
+        std::fprintf(stderr, "%s: %s\n", qPrintable(args.at(0)), qPrintable(error));
+        return 1;
+    }
+    if (parser.isSet(limitOption))
+        replay.records = replay.records.mid(0, parser.value(limitOption).toInt());
+
+    replay.baseUrl = args.at(1).toUtf8();
+    while (replay.baseUrl.endsWith('/'))
+        replay.baseUrl.chop(1);
+    replay.speed = parser.value(speedOption).toDouble();
+    replay.concurrency = qMax(1, parser.value(concurrencyOption).toInt());
+    replay.user = parser.isSet(userOption) ? parser.value(userOption) : qEnvironmentVariable("API_USER");
+    replay.password = parser.isSet(passwordOption) ? parser.value(passwordOption) : qEnvironmentVariable("API_PASSWORD");
+    if (parser.isSet(insecureOption)) {
+        QObject::connect(&replay.nam, &QNetworkAccessManager::sslErrors,
+                         [](QNetworkReply *reply, const QList<QSslError> &) { reply->ignoreSslErrors(); });
+    }
+
+    const bool needsAuth = std::any_of(replay.records.cbegin(), replay.records.cend(),
+                                       [](const CaptureLog::Record &r) { return r.authorized; });
+
+    std::printf("%lld Records aus %s → %s (Tempo %s)\n\n", static_cast<long long>(replay.records.size()),
+                qPrintable(args.at(0)), replay.baseUrl.constData(),
+                replay.speed > 0 ? qPrintable(QString::number(replay.speed) + "x") : "max");
+
+    // Login, Abspielen und Wiederanmeldung laufen alle im selben Event-Loop
+    replay.start(needsAuth);
+    if (const int rc = app.exec())
+        return rc;
+
+    const QJsonObject summary = summarize(replay, args.at(0));
+    printSummary(summary);
+    if (parser.isSet(outOption)) {
+        QFile out(parser.value(outOption));
+        if (!out.open(QIODevice::WriteOnly) || out.write(QJsonDocument(summary).toJson()) < 0) {
+            std::fprintf(stderr, "%s: %s\n", qPrintable(out.fileName()), qPrintable(out.errorString()));
+            return 1;
+        }
+    }
+    return 0;
+}
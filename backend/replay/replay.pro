@@ -0,0 +1,26 @@
+# Replay eines Traffic-Mitschnitts (CAPTURE_FILE) gegen ein Backend
+#
+#   cd backend/replay && qmake && make
+#   ./traffic-replay capture.bin http://localhost:3000 --out alt.json
+#   ./traffic-replay --compare alt.json neu.json
+#
+# Liest das Format aus ../capturelog.h.
+
+QT += core network
+QT -= gui
+
+CONFIG += c++17 console release
+CONFIG -= app_bundle
+
+QMAKE_CXXFLAGS += -Wall -Wextra
+
+TARGET = traffic-replay
+TEMPLATE = app
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../capturelog.h
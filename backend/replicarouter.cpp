@@ -0,0 +1,197 @@
+#include "replicarouter.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QVarLengthArray>
+#include <limits>
+
+// Schreibzugriffe so lange merken — länger darf keine Replica zurückliegen
+static const qint64 SessionMemoryMs = 60000;
+
+ReplicaRouter::ReplicaRouter(const QList<Endpoint> &endpoints, qint64 maxLagMs, qint64 probeIntervalMs)
+    : endpoints(endpoints),
+      maxLagMs(qBound<qint64>(0, maxLagMs, SessionMemoryMs / 2)),
+      // Bleibt die Messung hängen, gilt der letzte Wert nicht ewig
+      staleAfterMs(qMax<qint64>(3 * probeIntervalMs, 3000)),
+      states(endpoints.size())
+{
+}
+
+QList<ReplicaRouter::Endpoint> ReplicaRouter::parse(const QString &spec, int defaultPort)
+{
+    QList<Endpoint> result;
+    for (const QString &entry : spec.split(',', Qt::SkipEmptyParts)) {
+        const QString e = entry.trimmed();
+        Endpoint ep;
+        const qsizetype colon = e.lastIndexOf(':');
+        bool ok = false;
+        const int port = colon > 0 ? e.mid(colon + 1).toInt(&ok) : 0;
+        ep.host = ok ? e.left(colon) : e;
+        ep.port = ok ? port : defaultPort;
+        if (!ep.host.isEmpty())
+            result.append(ep);
+    }
+    return result;
+}
+
+quint64 ReplicaRouter::parseLsn(const QString &text)
+{
+    const qsizetype slash = text.indexOf('/');
+    if (slash <= 0) return 0;
+    bool okHi = false, okLo = false;
+    const quint64 hi = text.left(slash).toULongLong(&okHi, 16);
+    const quint64 lo = text.mid(slash + 1).toULongLong(&okLo, 16);
+    return okHi && okLo ? (hi << 32) | (lo & 0xFFFFFFFFu) : 0;
+}
+
+QString ReplicaRouter::formatLsn(quint64 lsn)
+{
+    return QString::number(lsn >> 32, 16).toUpper() + '/' + QString::number(lsn & 0xFFFFFFFFu, 16).toUpper();
+}
+
+int ReplicaRouter::pick(const QString &session)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker lock(&mutex);
+
+    const auto wrote = session.isEmpty() ? lastWrite.cend() : lastWrite.constFind(session);
+    QVarLengthArray<int, 8> eligible;
+    bool blockedByWrite = false;
+    for (int i = 0; i < states.size(); ++i) {
+        const State &s = states.at(i);
+        if (!s.healthy || s.lagMs > maxLagMs || now - s.probedAt > staleAfterMs)
+            continue;
+        // Eigener Commit noch nicht eingespielt (oder Position unbekannt)
+        if (wrote != lastWrite.cend() && (wrote->lsn == 0 || s.replayLsn < wrote->lsn)) {
+            blockedByWrite = true;
+            continue;
+        }
+        eligible.append(i);
+    }
+
+    if (eligible.isEmpty()) {
+        ++primaryReads;
+        if (blockedByWrite) ++primaryForWrites;
+        return -1;
+    }
+    const int replica = eligible.at(int(next++ % quint64(eligible.size())));
+    ++states[replica].reads;
+    return replica;
+}
+
+quint64 ReplicaRouter::replayLsn(int replica) const
+{
+    QMutexLocker lock(&mutex);
+    return states.at(replica).replayLsn;
+}
+
+void ReplicaRouter::noteWrite(const QString &session, quint64 lsn)
+{
+    if (session.isEmpty()) return;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker lock(&mutex);
+    Write &w = lastWrite[session];
+    // Die Position nach dem neuesten Commit deckt auch alle früheren ab
+    w.lsn = lsn == 0 ? 0 : qMax(w.lsn, lsn);
+    w.at = now;
+}
+
+bool ReplicaRouter::hasRecentWrite(const QString &session) const
+{
+    if (session.isEmpty()) return false;
+    QMutexLocker lock(&mutex);
+    return lastWrite.contains(session);
+}
+
+void ReplicaRouter::reportLag(int replica, qint64 lagMs, quint64 replayLsn)
+{
+    QMutexLocker lock(&mutex);
+    State &s = states[replica];
+    s.probedAt = QDateTime::currentMSecsSinceEpoch();
+    s.lagMs = lagMs;
+    s.healthy = lagMs >= 0;
+    // Was bis zu dieser WAL-Position committet wurde, ist dort sichtbar
+    if (s.healthy)
+        s.replayLsn = replayLsn;
+    s.lastError = s.healthy ? QString() : QStringLiteral("nicht im Recovery-Modus");
+
+    // Alte Schreibzugriffe verwerfen, die Messung läuft regelmäßig
+    for (auto it = lastWrite.begin(); it != lastWrite.end();) {
+        if (s.probedAt - it->at > SessionMemoryMs)
+            it = lastWrite.erase(it);
+        else
+            ++it;
+    }
+}
+
+bool ReplicaRouter::reportFailure(int replica, const QString &error)
+{
+    QMutexLocker lock(&mutex);
+    State &s = states[replica];
+    const bool wasHealthy = s.healthy;
+    s.healthy = false;
+    s.lastError = error;
+    ++s.failures;
+    return wasHealthy;
+}
+
+void ReplicaRouter::noteRetry()
+{
+    QMutexLocker lock(&mutex);
+    ++retries;
+}
+
+quint64 ReplicaRouter::beginChange()
+{
+    QMutexLocker lock(&mutex);
+    changeLsn = std::numeric_limits<quint64>::max();
+    return ++changes;
+}
+
+void ReplicaRouter::resolveChange(quint64 change, quint64 lsn)
+{
+    QMutexLocker lock(&mutex);
+    // Inzwischen neuere Änderung: deren Position steht noch aus
+    if (change == changes && lsn != 0)
+        changeLsn = lsn;
+}
+
+bool ReplicaRouter::isCurrent(quint64 readLsn) const
+{
+    QMutexLocker lock(&mutex);
+    return readLsn >= changeLsn;
+}
+
+QJsonObject ReplicaRouter::stats() const
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker lock(&mutex);
+
+    QJsonArray replicas;
+    quint64 replicaReads = 0;
+    for (int i = 0; i < states.size(); ++i) {
+        const State &s = states.at(i);
+        QJsonObject r;
+        r["host"]       = endpoints.at(i).host;
+        r["port"]       = endpoints.at(i).port;
+        r["healthy"]    = s.healthy && now - s.probedAt <= staleAfterMs;
+        r["lagMs"]      = s.lagMs;
+        r["replayLsn"]  = formatLsn(s.replayLsn);
+        r["probeAgeMs"] = s.probedAt > 0 ? now - s.probedAt : -1;
+        r["reads"]      = qint64(s.reads);
+        r["failures"]   = qint64(s.failures);
+        if (!s.lastError.isEmpty())
+            r["lastError"] = s.lastError;
+        replicas.append(r);
+        replicaReads += s.reads;
+    }
+
+    QJsonObject o;
+    o["replicas"]          = replicas;
+    o["maxLagMs"]          = maxLagMs;
+    o["replicaReads"]      = qint64(replicaReads);
+    o["primaryReads"]      = qint64(primaryReads);
+    o["readYourWrites"]    = qint64(primaryForWrites);
+    o["retriedOnPrimary"]  = qint64(retries);
+    o["trackedSessions"]   = int(lastWrite.size());
+    return o;
+}
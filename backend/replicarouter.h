@@ -0,0 +1,108 @@
+#ifndef REPLICAROUTER_H
+#define REPLICAROUTER_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// Auswahl der Lese-Replica (DB_REPLICAS)
+//
+// Hält pro Replica den zuletzt gemessenen Replikationsrückstand und die
+// bis dahin eingespielte WAL-Position (pg_last_wal_replay_lsn). Lesezugriffe
+// gehen reihum an gesunde Replicas mit Rückstand unter
+// DB_REPLICA_MAX_LAG_MS. Read-your-writes: hat eine Session (Benutzer)
+// geschrieben, kommen für sie nur Replicas in Frage, deren eingespielte
+// Position mindestens die WAL-Position nach ihrem Commit erreicht hat —
+// sonst liest sie vom Primary. Zeiten taugen dafür nicht (Uhren, Messpausen).
+//
+// Für den Response-Cache zählt dasselbe instanzweit: nach einer Änderung an
+// den Daten (beginChange) ist ein Leseergebnis erst wieder teilbar, wenn es
+// vom Primary kam oder von Replicas, die die WAL-Position danach erreicht
+// haben (resolveChange); bis die Position bekannt ist, nur vom Primary.
+//
+// Die Messung selbst (Verbindungen, SQL) macht Database; diese Klasse ist
+// nur der thread-sichere Zustand.
+class ReplicaRouter
+{
+public:
+    struct Endpoint {
+        QString host;
+        int port = 5432;
+    };
+
+    ReplicaRouter(const QList<Endpoint> &endpoints, qint64 maxLagMs, qint64 probeIntervalMs);
+
+    // "host:port,host:port" — Port optional
+    static QList<Endpoint> parse(const QString &spec, int defaultPort);
+
+    int count() const { return endpoints.size(); }
+    Endpoint endpoint(int replica) const { return endpoints.at(replica); }
+
+    // Replica für einen Lesezugriff der Session oder -1 (= Primary)
+    int pick(const QString &session);
+    // Zuletzt gemessene eingespielte Position (Untergrenze)
+    quint64 replayLsn(int replica) const;
+
+    // "16/B374D848" → 64-Bit-Position; 0, wenn nicht lesbar
+    static quint64 parseLsn(const QString &text);
+    static QString formatLsn(quint64 lsn);
+
+    // Schreibzugriff der Session ist committet, lsn = WAL-Position danach
+    // (pg_current_wal_lsn); 0 = unbekannt → bis zum Vergessen nur Primary
+    void noteWrite(const QString &session, quint64 lsn);
+    // Session hat vor kurzem geschrieben (read-your-writes noch offen)
+    bool hasRecentWrite(const QString &session) const;
+
+    // Ergebnis einer Messung: lagMs < 0 = nicht nutzbar (z. B. keine Replica
+    // mehr, sondern selbst Primary). replayLsn = eingespielte WAL-Position.
+    void reportLag(int replica, qint64 lagMs, quint64 replayLsn);
+    // Verbindungs- oder Abfragefehler — bis zur nächsten erfolgreichen Messung
+    // gesperrt. true, wenn sie bis eben als gesund galt (einmal loggen).
+    bool reportFailure(int replica, const QString &error);
+    // Lesezugriff auf der Replica fehlgeschlagen, auf dem Primary wiederholt
+    void noteRetry();
+
+    // Daten geändert (Commit, NOTIFY) — liefert die Nummer für resolveChange
+    quint64 beginChange();
+    // WAL-Position des Primary nach der Änderung; ältere Nummern zählen nicht
+    void resolveChange(quint64 change, quint64 lsn);
+    // Lesezugriffe bis readLsn eingespielt (Primary = max) — aktuell genug?
+    bool isCurrent(quint64 readLsn) const;
+
+    // Zustand je Replica + Verteilung der Lesezugriffe (für /metrics)
+    QJsonObject stats() const;
+
+private:
+    struct State {
+        bool healthy = false;
+        qint64 lagMs = -1;
+        quint64 replayLsn = 0;          // bis hierhin eingespielt
+        qint64 probedAt = 0;
+        QString lastError;
+        quint64 reads = 0;
+        quint64 failures = 0;
+    };
+
+    QList<Endpoint> endpoints;
+    qint64 maxLagMs;
+    qint64 staleAfterMs;
+
+    mutable QMutex mutex;
+    QVector<State> states;
+    struct Write {
+        quint64 lsn = 0;
+        qint64 at = 0;                  // ms seit Epoch, nur zum Vergessen
+    };
+    QHash<QString, Write> lastWrite;    // Session → letzter Commit
+    quint64 next = 0;
+    quint64 primaryReads = 0;
+    quint64 primaryForWrites = 0;       // davon wegen read-your-writes
+    quint64 retries = 0;
+    quint64 changes = 0;
+    quint64 changeLsn = 0;              // max = Position noch unbekannt
+};
+
+#endif // REPLICAROUTER_H
@@ -0,0 +1,49 @@
+#include "requestcontext.h"
+#include "allocprofiler.h"
+#include "trafficcapture.h"
+#include <QHttpServerRequest>
+#include <atomic>
+
+static thread_local RequestContext *currentContext = nullptr;
+static std::atomic<quint64> requestCounter{0};
+
+RequestContext::RequestContext(const QHttpServerRequest &request, const char *route)
+    : m_route(route)
+{
+    // X-Request-Id von NGINX übernehmen, sonst eigene fortlaufende ID
+    m_id = request.headers().value("x-request-id").toByteArray();
+    if (m_id.isEmpty() || m_id.size() > 64)
+        m_id = QByteArray::number(requestCounter.fetch_add(1, std::memory_order_relaxed) + 1);
+
+    TrafficCapture::record(request, route);
+    m_previousAllocRoute = AllocProfiler::enterRoute(route);
+    m_timer.start();
+    m_previous = currentContext;
+    currentContext = this;
+}
+
+RequestContext::RequestContext(const QByteArray &requestId, const char *route, const QString &session)
+    : m_id(requestId), m_route(route), m_session(session)
+{
+    m_previousAllocRoute = AllocProfiler::enterRoute(route);
+    m_timer.start();
+    m_previous = currentContext;
+    currentContext = this;
+}
+
+RequestContext::~RequestContext()
+{
+    AllocProfiler::leaveRoute(m_previousAllocRoute);
+    currentContext = m_previous;
+}
+
+const RequestContext *RequestContext::current()
+{
+    return currentContext;
+}
+
+void RequestContext::setCurrentSession(const QString &session)
+{
+    if (currentContext)
+        currentContext->m_session = session;
+}
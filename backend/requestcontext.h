@@ -0,0 +1,46 @@
+#ifndef REQUESTCONTEXT_H
+#define REQUESTCONTEXT_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QString>
+
+class QHttpServerRequest;
+
+// Kontext des gerade bearbeiteten Requests (pro Thread)
+//
+// Wird am Anfang jedes Route-Handlers als lokales Objekt angelegt und
+// beim Verlassen wieder abgeräumt. Logging und Metriken lesen darüber
+// Request-ID und Route, ohne dass sie durch alle Aufrufe gereicht werden.
+class RequestContext
+{
+public:
+    RequestContext(const QHttpServerRequest &request, const char *route);
+    RequestContext(const QByteArray &requestId, const char *route, const QString &session = QString());
+    ~RequestContext();
+
+    RequestContext(const RequestContext &) = delete;
+    RequestContext &operator=(const RequestContext &) = delete;
+
+    // Aktiver Kontext des aufrufenden Threads oder nullptr
+    static const RequestContext *current();
+
+    // Angemeldeter Benutzer des aktiven Kontexts (nach checkAuth) — die
+    // Replica-Auswahl braucht ihn für read-your-writes
+    static void setCurrentSession(const QString &session);
+
+    QByteArray id() const { return m_id; }
+    QByteArray route() const { return m_route; }
+    QString session() const { return m_session; }
+    qint64 elapsedMs() const { return m_timer.elapsed(); }
+
+private:
+    QByteArray m_id;
+    QByteArray m_route;
+    QString m_session;
+    QElapsedTimer m_timer;
+    RequestContext *m_previous = nullptr;
+    int m_previousAllocRoute = 0;
+};
+
+#endif // REQUESTCONTEXT_H
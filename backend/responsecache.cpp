@@ -0,0 +1,238 @@
+#include "responsecache.h"
+#include "logger.h"
+#include <QCryptographicHash>
+#include <QHttpHeaders>
+#include <algorithm>
+
+// Größere Antworten würden den halben Cache verdrängen
+static const qint64 MaxEntryShare = 8;
+
+QHttpServerResponse ResponseCache::Hit::response() const
+{
+    QHttpServerResponse r(mimeType, body);
+    QHttpHeaders headers;
+    headers.append(QHttpHeaders::WellKnownHeader::ETag, etag);
+    headers.append("X-Cache", state == State::Stale ? "STALE" : "HIT");
+    headers.append(QHttpHeaders::WellKnownHeader::Age, QByteArray::number(ageMs / 1000));
+    r.setHeaders(std::move(headers));
+    return r;
+}
+
+ResponseCache::ResponseCache(qint64 maxBytes)
+    : maxBytes(maxBytes)
+{
+    clock.start();
+
+    // RESPONSE_CACHE_TTLS="GET /api/table=2000;GET /api/tables=60000/300000;GET /api/styles=0"
+    for (const QString &entry : qEnvironmentVariable("RESPONSE_CACHE_TTLS").split(';', Qt::SkipEmptyParts)) {
+        const qsizetype eq = entry.lastIndexOf('=');
+        const QStringList values = eq > 0 ? entry.mid(eq + 1).split('/') : QStringList();
+        bool ok = !values.isEmpty() && values.size() <= 2;
+        Policy p;
+        if (ok)
+            p.ttlMs = values.first().trimmed().toInt(&ok);
+        if (ok && values.size() == 2)
+            p.staleMs = values.last().trimmed().toInt(&ok);
+        if (!ok || p.ttlMs < 0 || p.staleMs < 0) {
+            qCWarning(lcHttp) << "RESPONSE_CACHE_TTLS: ungültiger Eintrag" << entry;
+            continue;
+        }
+        // Ohne Stale-Angabe: so lange wie die TTL
+        if (values.size() == 1)
+            p.staleMs = p.ttlMs;
+        overrides.insert(entry.left(eq).trimmed().toUtf8(), p);
+    }
+
+    if (isEnabled())
+        qCInfo(lcHttp) << "Response-Cache aktiv:" << maxBytes / (1024 * 1024) << "MB";
+}
+
+void ResponseCache::addRoute(const QByteArray &route, int ttlMs, int staleMs)
+{
+    // Nur beim Aufbau der Routen (vor dem ersten Request) — ohne Lock
+    policies.insert(route, overrides.value(route, Policy{ ttlMs, staleMs }));
+}
+
+bool ResponseCache::isCached(const QByteArray &route) const
+{
+    return isEnabled() && policies.value(route).ttlMs > 0;
+}
+
+QByteArray ResponseCache::key(const QByteArray &route, const QUrlQuery &query, const QByteArray &variant)
+{
+    // ?b=2&a=1 und ?a=1&b=2 teilen sich einen Eintrag
+    QList<QPair<QString, QString>> items = query.queryItems(QUrl::FullyDecoded);
+    std::sort(items.begin(), items.end());
+    QUrlQuery normalized;
+    normalized.setQueryItems(items);
+    return route + '\n' + variant + '\n' + normalized.toString(QUrl::FullyEncoded).toUtf8();
+}
+
+QByteArray ResponseCache::etag(const QByteArray &body)
+{
+    return "W/\"" + QCryptographicHash::hash(body, QCryptographicHash::Md5).toHex() + "\"";
+}
+
+ResponseCache::Hit ResponseCache::lookup(const QByteArray &route, const QByteArray &key)
+{
+    QMutexLocker lock(&mutex);
+    Hit hit;
+    hit.epoch = epoch;
+    RouteStats &s = routeStats[route];
+
+    const auto found = index.constFind(key);
+    if (found == index.cend()) {
+        ++s.misses;
+        return hit;
+    }
+    const EntryList::iterator entry = *found;
+    const qint64 age = clock.elapsed() - entry->storedAt;
+    if (age > qint64(entry->policy.ttlMs) + entry->policy.staleMs) {
+        drop(entry);
+        ++s.misses;
+        return hit;
+    }
+
+    lru.splice(lru.begin(), lru, entry);
+    hit.ageMs = age;
+    hit.mimeType = entry->mimeType;
+    hit.body = entry->body;
+    hit.etag = entry->etag;
+    if (age <= entry->policy.ttlMs) {
+        hit.state = State::Fresh;
+        ++s.hits;
+    } else {
+        hit.state = State::Stale;
+        ++s.stale;
+        // Nur ein Request erneuert, alle anderen bekommen die alte Antwort
+        if (!entry->refreshing) {
+            entry->refreshing = true;
+            hit.refresh = true;
+            ++refreshes;
+        }
+    }
+    return hit;
+}
+
+void ResponseCache::store(const QByteArray &route, const QByteArray &key, const QByteArray &tag,
+                          quint64 startEpoch, const QHttpServerResponse &response)
+{
+    if (!isEnabled())
+        return;
+    const Policy policy = policies.value(route);
+    const QByteArray body = response.data();
+    // Einmal beim Ablegen statt bei jedem Treffer
+    const QByteArray bodyETag = response.statusCode() == QHttpServerResponse::StatusCode::Ok
+                                    ? etag(body) : QByteArray();
+    const qint64 bytes = qint64(sizeof(Entry)) + key.size() + tag.size() + body.size() + bodyETag.size();
+
+    QMutexLocker lock(&mutex);
+    const auto found = index.constFind(key);
+    if (response.statusCode() != QHttpServerResponse::StatusCode::Ok || startEpoch != epoch
+        || policy.ttlMs <= 0 || bytes > maxBytes / MaxEntryShare) {
+        // Alte Antwort bleibt bis zum Ende des Stale-Fensters, nächster Versuch später
+        if (found != index.cend())
+            (*found)->refreshing = false;
+        return;
+    }
+    if (found != index.cend())
+        drop(*found);
+
+    Entry e;
+    e.key = key;
+    e.tag = tag;
+    e.mimeType = response.mimeType();
+    e.body = body;
+    e.etag = bodyETag;
+    e.storedAt = clock.elapsed();
+    e.policy = policy;
+    e.bytes = bytes;
+    lru.push_front(std::move(e));
+    index.insert(key, lru.begin());
+    usedBytes += bytes;
+    ++stores;
+
+    while (usedBytes > maxBytes && !lru.empty()) {
+        drop(std::prev(lru.end()));
+        ++evictions;
+    }
+}
+
+void ResponseCache::abandon(const QByteArray &key)
+{
+    if (!isEnabled())
+        return;
+    QMutexLocker lock(&mutex);
+    const auto found = index.constFind(key);
+    if (found != index.cend())
+        (*found)->refreshing = false;
+}
+
+void ResponseCache::invalidate(const QByteArray &tag)
+{
+    if (!isEnabled())
+        return;
+    QMutexLocker lock(&mutex);
+    // Laufende Misses/Erneuerungen dürfen ihren alten Stand nicht mehr ablegen
+    ++epoch;
+    for (auto it = lru.begin(); it != lru.end();) {
+        auto next = std::next(it);
+        if (it->tag == tag) {
+            drop(it);
+            ++invalidated;
+        }
+        it = next;
+    }
+}
+
+void ResponseCache::clear()
+{
+    if (!isEnabled())
+        return;
+    QMutexLocker lock(&mutex);
+    ++epoch;
+    invalidated += quint64(index.size());
+    lru.clear();
+    index.clear();
+    usedBytes = 0;
+}
+
+void ResponseCache::drop(EntryList::iterator entry)
+{
+    // Aufrufer hält mutex
+    usedBytes -= entry->bytes;
+    index.remove(entry->key);
+    lru.erase(entry);
+}
+
+QJsonObject ResponseCache::stats() const
+{
+    QMutexLocker lock(&mutex);
+    QJsonObject s;
+    s["enabled"]     = isEnabled();
+    s["maxBytes"]    = maxBytes;
+    s["bytes"]       = usedBytes;
+    s["entries"]     = qint64(index.size());
+    s["stores"]      = qint64(stores);
+    s["refreshes"]   = qint64(refreshes);
+    s["evictions"]   = qint64(evictions);
+    s["invalidated"] = qint64(invalidated);
+
+    quint64 hits = 0, lookups = 0;
+    QJsonObject routes;
+    for (auto it = routeStats.cbegin(); it != routeStats.cend(); ++it) {
+        const RouteStats &r = it.value();
+        const quint64 total = r.hits + r.stale + r.misses;
+        QJsonObject o;
+        o["hits"]     = qint64(r.hits);
+        o["stale"]    = qint64(r.stale);
+        o["misses"]   = qint64(r.misses);
+        o["hitRatio"] = total ? double(r.hits + r.stale) / double(total) : 0.0;
+        routes[QString::fromUtf8(it.key())] = o;
+        hits += r.hits + r.stale;
+        lookups += total;
+    }
+    s["hitRatio"] = lookups ? double(hits) / double(lookups) : 0.0;
+    s["routes"]   = routes;
+    return s;
+}
@@ -0,0 +1,118 @@
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QHttpServerResponse>
+#include <QJsonObject>
+#include <QMutex>
+#include <QUrlQuery>
+#include <list>
+
+// Microcache für lesende Routen (RESPONSE_CACHE_MB, Default 32, 0 = aus)
+//
+// Fertig serialisierte Antworten (nur 200) je Route + normalisierter Query
+// + Format. Jede Route wird in setupRoutes() mit TTL und Stale-Fenster
+// angemeldet; RESPONSE_CACHE_TTLS überschreibt das pro Route, 0 schaltet
+// sie ab. Innerhalb der TTL kommt die Antwort direkt aus dem Speicher,
+// danach bis zum Ende des Stale-Fensters noch die alte Antwort, während
+// genau ein Request sie im Hintergrund erneuert (stale-while-revalidate).
+//
+// Einträge können ein Tag tragen (z.B. die Tabelle); Schreibzugriffe
+// verwerfen per invalidate(tag). Antworten, die vor einer Invalidierung
+// begonnen und danach fertig wurden, werden nicht mehr übernommen.
+// Der Speicher ist begrenzt, verdrängt wird der am längsten ungenutzte
+// Eintrag. Thread-sicher — Worker im DB-Pool schreiben direkt hinein.
+class ResponseCache
+{
+public:
+    enum class State { Miss, Fresh, Stale };
+
+    struct Hit {
+        State state = State::Miss;
+        bool refresh = false;     // Aufrufer soll im Hintergrund erneuern
+        quint64 epoch = 0;        // für store() nach Miss/Erneuerung
+        qint64 ageMs = 0;
+        QByteArray mimeType;
+        QByteArray body;
+        QByteArray etag;          // beim Ablegen einmal berechnet
+
+        // Antwort mit ETag und X-Cache: HIT bzw. STALE
+        QHttpServerResponse response() const;
+    };
+
+    explicit ResponseCache(qint64 maxBytes);
+
+    bool isEnabled() const { return maxBytes > 0; }
+
+    // Route anmelden (RESPONSE_CACHE_TTLS hat Vorrang)
+    void addRoute(const QByteArray &route, int ttlMs, int staleMs);
+    bool isCached(const QByteArray &route) const;
+
+    // Schlüssel: Route, Query-Parameter sortiert, Format (json/cbor)
+    static QByteArray key(const QByteArray &route, const QUrlQuery &query, const QByteArray &variant);
+    // Schwaches ETag über den Body (auch für nicht gecachte Antworten)
+    static QByteArray etag(const QByteArray &body);
+
+    Hit lookup(const QByteArray &route, const QByteArray &key);
+    // Ergebnis übernehmen; Fehlerantworten beenden nur eine laufende Erneuerung
+    void store(const QByteArray &route, const QByteArray &key, const QByteArray &tag,
+               quint64 epoch, const QHttpServerResponse &response);
+
+    // Erneuerung ohne Ergebnis beenden (nächster Versuch nach dem nächsten Treffer)
+    void abandon(const QByteArray &key);
+
+    // Alle Einträge mit diesem Tag verwerfen
+    void invalidate(const QByteArray &tag);
+    // Alles verwerfen (Schema-Änderung, verpasste Notifications)
+    void clear();
+
+    // Treffer je Route, Speicher, Verdrängungen (für /metrics)
+    QJsonObject stats() const;
+
+private:
+    struct Policy {
+        int ttlMs = 0;
+        int staleMs = 0;
+    };
+
+    struct Entry {
+        QByteArray key;
+        QByteArray tag;
+        QByteArray mimeType;
+        QByteArray body;
+        QByteArray etag;
+        qint64 storedAt = 0;
+        Policy policy;
+        qint64 bytes = 0;
+        bool refreshing = false;
+    };
+    using EntryList = std::list<Entry>;
+
+    struct RouteStats {
+        quint64 hits = 0;
+        quint64 stale = 0;
+        quint64 misses = 0;
+    };
+
+    void drop(EntryList::iterator entry);
+
+    const qint64 maxBytes;
+    QHash<QByteArray, Policy> overrides;      // aus RESPONSE_CACHE_TTLS
+    QHash<QByteArray, Policy> policies;
+
+    mutable QMutex mutex;
+    QElapsedTimer clock;
+    EntryList lru;                            // vorne = zuletzt benutzt
+    QHash<QByteArray, EntryList::iterator> index;
+    QHash<QByteArray, RouteStats> routeStats;
+    qint64 usedBytes = 0;
+    quint64 epoch = 0;
+    quint64 stores = 0;
+    quint64 refreshes = 0;
+    quint64 evictions = 0;
+    quint64 invalidated = 0;
+};
+
+#endif // RESPONSECACHE_H
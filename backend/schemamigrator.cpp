@@ -0,0 +1,386 @@
+#include "schemamigrator.h"
+#include "logger.h"
+#include <QDebug>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <algorithm>
+#include <iterator>
+
+// Schlüssel für pg_advisory_xact_lock — serialisiert Migrationen, wenn
+// mehrere Backend-Instanzen gleichzeitig starten
+static const qint64 MigrationLockKey = 0x5765624170704D67;  // "WebAppMg"
+
+// Oracle kennt kein IF NOT EXISTS. Bestandsdatenbanken (DDL aus MIGRATION.md,
+// noch ohne schema_version) haben Tabelle, Indizes und row_version schon —
+// diese Fehler heißen "bereits angewendet":
+//   ORA-00955  Name wird bereits verwendet
+//   ORA-01408  Spaltenliste bereits indiziert (gleicher Index, anderer Name)
+//   ORA-01430  Spalte existiert bereits (ALTER TABLE … ADD)
+static bool oracleAlreadyExists(const QSqlError &error)
+{
+    static const int codes[] = { 955, 1408, 1430 };
+    QString native = error.nativeErrorCode();
+    native.remove("ORA-", Qt::CaseInsensitive);
+    const int code = native.toInt();
+    return std::find(std::begin(codes), std::end(codes), code) != std::end(codes);
+}
+
+SchemaMigrator::SchemaMigrator(const QSqlDatabase &database)
+    : db(database), oracle(database.driverName() == "QOCI")
+{
+}
+
+// ===== MIGRATIONEN =====
+//
+// Neue Migrationen immer nur hinten anhängen, bestehende nie ändern.
+// PostgreSQL und Oracle müssen dieselben Versionsnummern führen
+// (Struktur siehe sql/init-postgres.sql bzw. sql/init-oracle.sql).
+
+QList<SchemaMigrator::Migration> SchemaMigrator::postgresMigrations()
+{
+    return {
+        { 1, "Tabelle product", {
+            // IF NOT EXISTS: übernimmt Bestandsdatenbanken ohne schema_version
+            R"(
+            CREATE TABLE IF NOT EXISTS product (
+                product_id   SERIAL PRIMARY KEY,
+                product_number VARCHAR(20) UNIQUE NOT NULL,
+                gtin         BIGINT,
+                name         VARCHAR(100) NOT NULL,
+                unit         VARCHAR(2) NOT NULL DEFAULT 'ST',
+                category_id  INTEGER,
+                supplier_id  INTEGER,
+                purchase_price NUMERIC(10,2),
+                sales_price  NUMERIC(10,2) NOT NULL,
+                vat_code     SMALLINT NOT NULL DEFAULT 2,
+                description  VARCHAR(500),
+                active       SMALLINT NOT NULL DEFAULT 1,
+                created_at   TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                updated_at   TIMESTAMP,
+                updated_by   VARCHAR(25)
+            )
+            )"
+        }},
+        { 2, "Indizes product", {
+            "CREATE INDEX IF NOT EXISTS idx_product_number ON product(product_number)",
+            "CREATE INDEX IF NOT EXISTS idx_gtin ON product(gtin)",
+            "CREATE INDEX IF NOT EXISTS idx_category ON product(category_id)"
+        }},
+        { 3, "Beispielprodukte", {
+            // Nur in eine leere Tabelle einfügen (wie bisher initProductTable)
+            R"(
+            INSERT INTO product
+                (product_number, gtin, name, unit, purchase_price, sales_price, vat_code, description)
+            SELECT * FROM (VALUES
+                ('P001', 4008400401584, 'Mineralwasser Classic 0,5l', 'ST', 0.29, 0.49, 1,
+                 'Natuerliches Mineralwasser, 0,5 Liter PET-Flasche'),
+                ('P002', 4001690019002, 'Kartoffelchips Salz 150g', 'ST', 0.79, 1.29, 1,
+                 'Kartoffelchips mit Meersalz, 150g Tuete'),
+                ('P003', 4006591000011, 'Langkornreis 1kg', 'ST', 1.29, 1.99, 1,
+                 'Parboiled Langkornreis, 1 kg Packung'),
+                ('P004', 7622210951939, 'Vollmilch-Schokolade 100g', 'ST', 0.89, 1.49, 1,
+                 'Zartschmelzende Vollmilch-Schokolade, 100g Tafel'),
+                ('P005', 4026608000020, 'Vollkornbrot 500g', 'ST', 1.49, 2.29, 1,
+                 'Saftiges Vollkornbrot, 500g, in Scheiben')
+            ) AS v
+            WHERE NOT EXISTS (SELECT 1 FROM product)
+            )"
+        }},
+        { 4, "NOTIFY-Trigger product (Änderungsstrom)", {
+            // Payload: {"op":"insert|update|delete","id":..,"row":{..}} — Zeilen
+            // sind klein genug für das 8000-Byte-Limit von pg_notify
+            R"(
+            CREATE OR REPLACE FUNCTION product_notify() RETURNS trigger AS $$
+            BEGIN
+                PERFORM pg_notify('product_changes', json_build_object(
+                    'op',  lower(TG_OP),
+                    'id',  CASE WHEN TG_OP = 'DELETE' THEN OLD.product_id ELSE NEW.product_id END,
+                    'row', CASE WHEN TG_OP = 'DELETE' THEN NULL ELSE row_to_json(NEW) END
+                )::text);
+                RETURN NULL;
+            END;
+            $$ LANGUAGE plpgsql
+            )",
+            "DROP TRIGGER IF EXISTS product_notify_trg ON product",
+            "CREATE TRIGGER product_notify_trg AFTER INSERT OR UPDATE OR DELETE ON product "
+            "FOR EACH ROW EXECUTE FUNCTION product_notify()"
+        }},
+        { 5, "Zeilenversion product (optimistisches Sperren)", {
+            // Konstanter Default: ab PostgreSQL 11 ohne Umschreiben der Tabelle
+            "ALTER TABLE product ADD COLUMN IF NOT EXISTS row_version INTEGER NOT NULL DEFAULT 1"
+        }},
+        { 6, "NOTIFY product mit Zeilenversion (Cache-Kohärenz)", {
+            // Wie Migration 4, zusätzlich "version" — auch bei delete (alte Version)
+            R"(
+            CREATE OR REPLACE FUNCTION product_notify() RETURNS trigger AS $$
+            BEGIN
+                PERFORM pg_notify('product_changes', json_build_object(
+                    'op',      lower(TG_OP),
+                    'id',      CASE WHEN TG_OP = 'DELETE' THEN OLD.product_id ELSE NEW.product_id END,
+                    'version', CASE WHEN TG_OP = 'DELETE' THEN OLD.row_version ELSE NEW.row_version END,
+                    'row',     CASE WHEN TG_OP = 'DELETE' THEN NULL ELSE row_to_json(NEW) END
+                )::text);
+                RETURN NULL;
+            END;
+            $$ LANGUAGE plpgsql
+            )"
+        }},
+        { 7, "Trigger Zeilenversion product", {
+            // Jedes UPDATE zählt hoch — auch Schreibzugriffe an der Anwendung
+            // vorbei; BEFORE läuft vor dem NOTIFY-Trigger (neue Version im Payload)
+            R"(
+            CREATE OR REPLACE FUNCTION product_row_version() RETURNS trigger AS $$
+            BEGIN
+                NEW.row_version := OLD.row_version + 1;
+                RETURN NEW;
+            END;
+            $$ LANGUAGE plpgsql
+            )",
+            "DROP TRIGGER IF EXISTS product_row_version_trg ON product",
+            "CREATE TRIGGER product_row_version_trg BEFORE UPDATE ON product "
+            "FOR EACH ROW EXECUTE FUNCTION product_row_version()"
+        }}
+    };
+}
+
+QList<SchemaMigrator::Migration> SchemaMigrator::oracleMigrations()
+{
+    // Bestandsdatenbanken aus MIGRATION.md: CREATE-Fehler "existiert bereits"
+    // übergeht apply() (oracleAlreadyExists)
+    return {
+        { 1, "Tabelle product", {
+            R"(
+            CREATE TABLE product (
+                product_id     NUMBER(9) GENERATED BY DEFAULT AS IDENTITY PRIMARY KEY,
+                product_number VARCHAR2(20) UNIQUE NOT NULL,
+                gtin           NUMBER(14),
+                name           VARCHAR2(100) NOT NULL,
+                unit           VARCHAR2(2) DEFAULT 'ST' NOT NULL,
+                category_id    NUMBER(9),
+                supplier_id    NUMBER(9),
+                purchase_price NUMBER(10,2),
+                sales_price    NUMBER(10,2) NOT NULL,
+                vat_code       NUMBER(1) DEFAULT 2 NOT NULL,
+                description    VARCHAR2(500),
+                active         NUMBER(1) DEFAULT 1 NOT NULL,
+                created_at     TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                updated_at     TIMESTAMP,
+                updated_by     VARCHAR2(25)
+            )
+            )"
+        }},
+        { 2, "Indizes product", {
+            // product_number ist durch UNIQUE bereits indiziert
+            "CREATE INDEX idx_gtin ON product(gtin)",
+            "CREATE INDEX idx_category ON product(category_id)"
+        }},
+        { 3, "Beispielprodukte", {
+            R"(
+            INSERT INTO product
+                (product_number, gtin, name, unit, purchase_price, sales_price, vat_code, description)
+            SELECT * FROM (
+                SELECT 'P001', 4008400401584, 'Mineralwasser Classic 0,5l', 'ST', 0.29, 0.49, 1,
+                       'Natuerliches Mineralwasser, 0,5 Liter PET-Flasche' FROM DUAL UNION ALL
+                SELECT 'P002', 4001690019002, 'Kartoffelchips Salz 150g', 'ST', 0.79, 1.29, 1,
+                       'Kartoffelchips mit Meersalz, 150g Tuete' FROM DUAL UNION ALL
+                SELECT 'P003', 4006591000011, 'Langkornreis 1kg', 'ST', 1.29, 1.99, 1,
+                       'Parboiled Langkornreis, 1 kg Packung' FROM DUAL UNION ALL
+                SELECT 'P004', 7622210951939, 'Vollmilch-Schokolade 100g', 'ST', 0.89, 1.49, 1,
+                       'Zartschmelzende Vollmilch-Schokolade, 100g Tafel' FROM DUAL UNION ALL
+                SELECT 'P005', 4026608000020, 'Vollkornbrot 500g', 'ST', 1.49, 2.29, 1,
+                       'Saftiges Vollkornbrot, 500g, in Scheiben' FROM DUAL
+            )
+            WHERE NOT EXISTS (SELECT 1 FROM product)
+            )"
+        }},
+        // Oracle hat kein LISTEN/NOTIFY — Version nur zur Gleichführung
+        { 4, "NOTIFY-Trigger product (nur PostgreSQL)", {} },
+        { 5, "Zeilenversion product (optimistisches Sperren)", {
+            // Die DDL in MIGRATION.md enthält row_version schon (ORA-01430)
+            "ALTER TABLE product ADD (row_version NUMBER(9) DEFAULT 1 NOT NULL)"
+        }},
+        { 6, "NOTIFY product mit Zeilenversion (nur PostgreSQL)", {} },
+        { 7, "Trigger Zeilenversion product", {
+            R"(
+            CREATE OR REPLACE TRIGGER product_row_version_trg
+            BEFORE UPDATE ON product
+            FOR EACH ROW
+            BEGIN
+                :NEW.row_version := :OLD.row_version + 1;
+            END;
+            )"
+        }}
+    };
+}
+
+QList<SchemaMigrator::Migration> SchemaMigrator::migrations() const
+{
+    return oracle ? oracleMigrations() : postgresMigrations();
+}
+
+int SchemaMigrator::latestVersion() const
+{
+    const QList<Migration> list = migrations();
+    return list.isEmpty() ? 0 : list.last().version;
+}
+
+// ===== ABLAUF =====
+
+int SchemaMigrator::currentVersion() const
+{
+    // Erst prüfen, ob schema_version existiert — ein Fehler bei MAX(version)
+    // ist sonst nicht von einer leeren Datenbank zu unterscheiden
+    QSqlQuery exists(db);
+    const char *existsSql = oracle
+        ? "SELECT COUNT(*) FROM user_tables WHERE table_name = 'SCHEMA_VERSION'"
+        : "SELECT COUNT(*) FROM pg_tables WHERE schemaname = current_schema() AND tablename = 'schema_version'";
+    if (!exists.exec(existsSql) || !exists.next()) {
+        qCCritical(lcDb) << "Schema-Version nicht lesbar:" << exists.lastError().text();
+        return -1;
+    }
+    if (exists.value(0).toInt() == 0)
+        return 0;
+
+    QSqlQuery q(db);
+    if (!q.exec("SELECT MAX(version) FROM schema_version") || !q.next()) {
+        qCCritical(lcDb) << "Schema-Version nicht lesbar:" << q.lastError().text();
+        return -1;
+    }
+    // Leere Tabelle: NULL → 0
+    return q.value(0).toInt();
+}
+
+bool SchemaMigrator::migrate()
+{
+    // Fast Path: eine einzige Abfrage
+    int version = currentVersion();
+    if (version < 0)
+        return false;   // Nicht migrieren, wenn der Stand unbekannt ist
+    const int latest = latestVersion();
+    if (version >= latest) {
+        qCInfo(lcDb) << "Schema aktuell (Version" << version << ")";
+        return true;
+    }
+
+    qCInfo(lcDb) << "Schema-Migration von Version" << version << "auf" << latest;
+
+    if (!createVersionTable())
+        return false;
+
+    for (const Migration &m : migrations()) {
+        if (m.version <= version) continue;
+        if (!apply(m))
+            return false;
+        version = m.version;
+    }
+
+    qCInfo(lcDb) << "Schema-Migration abgeschlossen (Version" << version << ")";
+    return true;
+}
+
+bool SchemaMigrator::createVersionTable()
+{
+    QSqlQuery q(db);
+    if (oracle) {
+        if (!q.exec("CREATE TABLE schema_version ("
+                    "  version     NUMBER(9) PRIMARY KEY,"
+                    "  description VARCHAR2(200),"
+                    "  applied_at  TIMESTAMP DEFAULT CURRENT_TIMESTAMP)")
+            && !oracleAlreadyExists(q.lastError())) {
+            qCCritical(lcDb) << "schema_version anlegen fehlgeschlagen:" << q.lastError().text();
+            return false;
+        }
+        return true;
+    }
+
+    if (!q.exec("CREATE TABLE IF NOT EXISTS schema_version ("
+                "  version     INTEGER PRIMARY KEY,"
+                "  description VARCHAR(200),"
+                "  applied_at  TIMESTAMP DEFAULT CURRENT_TIMESTAMP)")) {
+        qCCritical(lcDb) << "schema_version anlegen fehlgeschlagen:" << q.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool SchemaMigrator::lockForMigration()
+{
+    // Oracle: DDL committet implizit, ein Transaktions-Lock hält nicht.
+    // Parallele Erststarts dort bitte vermeiden (siehe MIGRATION.md).
+    if (oracle) return true;
+
+    QSqlQuery q(db);
+    q.prepare("SELECT pg_advisory_xact_lock(:key)");
+    q.bindValue(":key", MigrationLockKey);
+    if (!q.exec()) {
+        qCCritical(lcDb) << "Migrations-Lock fehlgeschlagen:" << q.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool SchemaMigrator::apply(const Migration &migration)
+{
+    db.transaction();
+
+    if (!lockForMigration()) {
+        db.rollback();
+        return false;
+    }
+
+    // Nach dem Lock erneut prüfen — eine andere Instanz kann schneller gewesen sein
+    QSqlQuery check(db);
+    check.prepare("SELECT COUNT(*) FROM schema_version WHERE version = :v");
+    check.bindValue(":v", migration.version);
+    if (check.exec() && check.next() && check.value(0).toInt() > 0) {
+        db.commit();
+        return true;
+    }
+
+    for (const QString &sql : migration.statements) {
+        QSqlQuery q(db);
+        if (!q.exec(sql)) {
+            if (oracle && oracleAlreadyExists(q.lastError())) {
+                qCInfo(lcDb) << "  Migration" << migration.version << ": Objekt existiert bereits —"
+                             << q.lastError().nativeErrorCode();
+                continue;
+            }
+            qCCritical(lcDb) << "Migration" << migration.version << "(" << migration.description
+                        << ") fehlgeschlagen:" << q.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+
+    QSqlQuery ins(db);
+    ins.prepare("INSERT INTO schema_version (version, description) VALUES (:v, :d)");
+    ins.bindValue(":v", migration.version);
+    ins.bindValue(":d", migration.description);
+    if (!ins.exec()) {
+        qCCritical(lcDb) << "schema_version aktualisieren fehlgeschlagen:" << ins.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    // Andere Instanzen verwerfen ihre Caches — zugestellt erst mit dem Commit
+    if (!oracle) {
+        QSqlQuery notify(db);
+        notify.prepare("SELECT pg_notify('schema_changes', :v)");
+        notify.bindValue(":v", QString::number(migration.version));
+        if (!notify.exec()) {
+            qCCritical(lcDb) << "Migration" << migration.version << "NOTIFY fehlgeschlagen:"
+                        << notify.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+
+    if (!db.commit()) {
+        qCCritical(lcDb) << "Migration" << migration.version << "Commit fehlgeschlagen:"
+                    << db.lastError().text();
+        return false;
+    }
+
+    qCInfo(lcDb) << "  Migration" << migration.version << "angewendet:" << migration.description;
+    return true;
+}
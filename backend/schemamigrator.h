@@ -0,0 +1,48 @@
+#ifndef SCHEMAMIGRATOR_H
+#define SCHEMAMIGRATOR_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+// Versionierte Schema-Migrationen (PostgreSQL + Oracle)
+//
+// Jede Migration hat eine fortlaufende Versionsnummer und wird genau einmal
+// ausgeführt. Der Stand steht in der Tabelle schema_version. Beim Start
+// genügt im Normalfall eine einzige Abfrage (MAX(version)), um festzustellen,
+// dass nichts zu tun ist.
+class SchemaMigrator
+{
+public:
+    struct Migration {
+        int version;
+        QString description;
+        QStringList statements;
+    };
+
+    explicit SchemaMigrator(const QSqlDatabase &database);
+
+    // Schema auf den neuesten Stand bringen — false bei Fehler
+    bool migrate();
+
+    // Aktuelle Version in der DB (0 = noch keine Migration, -1 = Fehler)
+    int currentVersion() const;
+
+    // Höchste bekannte Version für den aktuellen Treiber
+    int latestVersion() const;
+
+private:
+    QSqlDatabase db;
+    bool oracle = false;
+
+    QList<Migration> migrations() const;
+    static QList<Migration> postgresMigrations();
+    static QList<Migration> oracleMigrations();
+
+    bool createVersionTable();
+    bool lockForMigration();
+    bool apply(const Migration &migration);
+};
+
+#endif // SCHEMAMIGRATOR_H
@@ -1,14 +1,43 @@
 #include "server.h"
+#include "logger.h"
+#include "requestcontext.h"
+#include "columnarresult.h"
+#include "productstats.h"
+#include "allocprofiler.h"
+#include "queryguard.h"
+#include "tableexport.h"
+#include "staticassets.h"
+#include "trafficcapture.h"
+#include "catalogsnapshot.h"
+#include "responsecache.h"
 #include <QCoreApplication>
 #include <QDebug>
 #include <QTcpServer>
 #include <QUrlQuery>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHostAddress>
 #include <QDateTime>
 #include <QJsonArray>
+#include <QCborStreamWriter>
+#include <QFuture>
+#include <QtConcurrent>
+#include <limits>
 
 Server::Server(Database *database, AuthManager *auth, QObject *parent)
     : QObject(parent), db(database), authManager(auth)
 {
+    writeBatcher = new WriteBatcher(db, this);
+    health = new HealthMonitor(db, writeBatcher, this);
+    // Traffic-Mitschnitt für replay/traffic-replay (nur mit CAPTURE_FILE)
+    capture = TrafficCapture::fromEnvironment(this);
+    // Frontend ohne NGINX ausliefern (Single-Box), leer = aus
+    staticAssets = std::make_unique<StaticAssets>(qEnvironmentVariable("STATIC_DIR"),
+                                                  qEnvironmentVariable("STATIC_INDEX", "frontend.html"));
+    // Microcache für lesende Routen, 0 = aus
+    const int cacheMb = qEnvironmentVariableIsSet("RESPONSE_CACHE_MB")
+                            ? qMax(0, qEnvironmentVariableIntValue("RESPONSE_CACHE_MB")) : 32;
+    responseCache = std::make_unique<ResponseCache>(qint64(cacheMb) * 1024 * 1024);
     setupRoutes();
 }
 
@@ -18,119 +47,359 @@ Server::~Server()
 
 void Server::setupRoutes()
 {
+    // Response-Cache: TTL und Stale-Fenster in ms (RESPONSE_CACHE_TTLS überschreibt)
+    // Greeting nicht: die Antwort trägt einen aktuellen Zeitstempel
+    responseCache->addRoute("GET /api/styles", 60000, 600000);
+    responseCache->addRoute("GET /api/tables", 30000, 120000);
+    responseCache->addRoute("GET /api/table", 5000, 30000);
+
     // Health Check — KEIN Auth nötig
-    httpServer.route("/health", [this]() {
+    httpServer.route("/health", [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /health");
         return handleHealth();
     });
 
+    // Liveness/Readiness für Load Balancer — KEIN Auth, aus dem Speicher
+    httpServer.route("/health/live", QHttpServerRequest::Method::Get,
+                     [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /health/live");
+        return handleHealthLive();
+    });
+    httpServer.route("/health/ready", QHttpServerRequest::Method::Get,
+                     [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /health/ready");
+        return handleHealthReady();
+    });
+
+    // Metriken — KEIN Auth nötig, solange NGINX davor steht (leitet /metrics nicht weiter)
+    httpServer.route("/metrics", QHttpServerRequest::Method::Get,
+                     [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /metrics");
+        QString authError = checkInternal(request);
+        if (!authError.isEmpty()) return unauthorizedResponse(authError);
+        return handleMetrics();
+    });
+
+    // Allokationen pro Route — intern wie /metrics, ?reset=1 setzt zurück
+    httpServer.route("/debug/alloc", QHttpServerRequest::Method::Get,
+                     [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /debug/alloc");
+        QString authError = checkInternal(request);
+        if (!authError.isEmpty()) return unauthorizedResponse(authError);
+        return handleDebugAlloc(QUrlQuery(request.url()));
+    });
+
     // Login — KEIN Auth nötig
     httpServer.route("/api/login", QHttpServerRequest::Method::Post,
                      [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "POST /api/login");
         return handleLogin(request);
     });
 
     // API: Greeting — Auth erforderlich
     httpServer.route("/api/greeting", QHttpServerRequest::Method::Get,
                      [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /api/greeting");
         QString authError = checkAuth(request);
         if (!authError.isEmpty()) return unauthorizedResponse(authError);
-        return handleGetGreeting(request);
+        const QUrlQuery query(request.url());
+        return withETag(request, handleGetGreeting(query));
     });
 
     // API: Styles — Auth erforderlich
     httpServer.route("/api/styles", QHttpServerRequest::Method::Get,
                      [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /api/styles");
         QString authError = checkAuth(request);
         if (!authError.isEmpty()) return unauthorizedResponse(authError);
-        return handleGetStyles();
+        return cached(request, QByteArray(), [this]() { return handleGetStyles(); });
     });
 
     // API: Tabellenliste — Auth erforderlich
     httpServer.route("/api/tables", QHttpServerRequest::Method::Get,
                      [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /api/tables");
         QString authError = checkAuth(request);
         if (!authError.isEmpty()) return unauthorizedResponse(authError);
-        return handleGetTables();
+        const Encoding encoding = preferredEncoding(request);
+        return cached(request, QByteArray(), [this, encoding]() { return handleGetTables(encoding); });
     });
 
-    // API: Tabellendaten — Auth erforderlich
+    // API: Tabellendaten — Auth erforderlich; im Worker-Pool, abbrechbar
     httpServer.route("/api/table", QHttpServerRequest::Method::Get,
-                     [this](const QHttpServerRequest &request) {
+                     [this](const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "GET /api/table");
         QString authError = checkAuth(request);
-        if (!authError.isEmpty()) return unauthorizedResponse(authError);
-        return handleGetTableData(request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        const QUrlQuery query(request.url());
+        const Encoding encoding = preferredEncoding(request);
+        // Tag = Tabelle: Schreibzugriffe auf product verwerfen ihre Einträge
+        runCached(request, responder, query.queryItemValue("name").toUtf8(),
+                  [this, query, encoding]() { return handleGetTableData(query, encoding); });
+    });
+
+    // API: Tabellen-Export (CSV/NDJSON, gestreamt) — Auth erforderlich
+    httpServer.route("/api/table/export", QHttpServerRequest::Method::Get,
+                     [this](const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "GET /api/table/export");
+        QString authError = checkAuth(request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        handleTableExport(request, responder);
     });
 
     // API: Shutdown — Auth erforderlich
     httpServer.route("/api/shutdown", QHttpServerRequest::Method::Post,
                      [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "POST /api/shutdown");
         QString authError = checkAuth(request);
         if (!authError.isEmpty()) return unauthorizedResponse(authError);
         return handleShutdown(request);
     });
 
-    // ===== PRODUCT API =====
+    // API: Batch — mehrere Sub-Requests, eine Auth-Prüfung
+    httpServer.route("/api/batch", QHttpServerRequest::Method::Post,
+                     [this](const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "POST /api/batch");
+        QString authError = checkAuth(request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        handleBatch(request, responder);
+    });
 
-    // GET /api/products — alle Produkte laden
-    httpServer.route("/api/products", QHttpServerRequest::Method::Get,
+    // API: Logging-Kategorien abfragen/umschalten — Auth erforderlich
+    httpServer.route("/api/logging", QHttpServerRequest::Method::Get,
                      [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /api/logging");
         QString authError = checkAuth(request);
         if (!authError.isEmpty()) return unauthorizedResponse(authError);
-        return handleGetProducts(request);
+        return handleGetLogging();
     });
 
-    // POST /api/products — neues Produkt anlegen
-    httpServer.route("/api/products", QHttpServerRequest::Method::Post,
+    httpServer.route("/api/logging", QHttpServerRequest::Method::Post,
                      [this](const QHttpServerRequest &request) {
+        RequestContext ctx(request, "POST /api/logging");
         QString authError = checkAuth(request);
         if (!authError.isEmpty()) return unauthorizedResponse(authError);
-        return handleCreateProduct(request);
+        return handleSetLogging(request);
+    });
+
+    // ===== PRODUCT API =====
+
+    // GET /api/products?after=<id>&limit=<n> — Produkte laden (optional seitenweise)
+    httpServer.route("/api/products", QHttpServerRequest::Method::Get,
+                     [this](const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "GET /api/products");
+        QString authError = checkAuth(request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        const QUrlQuery query(request.url());
+        const Encoding encoding = preferredEncoding(request);
+        runGuarded(request, responder, [this, query, encoding]() { return handleGetProducts(query, encoding); });
+    });
+
+    // GET /api/products/stats?group_by=category_id&metrics=sum,avg,min,max,margin — Auswertung
+    httpServer.route("/api/products/stats", QHttpServerRequest::Method::Get,
+                     [this](const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "GET /api/products/stats");
+        QString authError = checkAuth(request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        handleProductStats(request, responder);
+    });
+
+    // GET /api/products/events — Änderungsstrom (Server-Sent Events)
+    httpServer.route("/api/products/events", QHttpServerRequest::Method::Get,
+                     [this](const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "GET /api/products/events");
+        QString authError = checkAuth(request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        handleProductEvents(request, responder);
+    });
+
+    // Schreibzugriffe laufen über den WriteBatcher (Group Commit), die
+    // Antwort kommt nach dem Commit des Batches
+
+    // POST /api/products — neues Produkt anlegen
+    httpServer.route("/api/products", QHttpServerRequest::Method::Post,
+                     [this](const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "POST /api/products");
+        QString authError = checkAuth(request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        qCDebug(lcHttp) << "POST /api/products";
+        WriteBatcher::Mutation m;
+        m.kind = WriteBatcher::Kind::Insert;
+        m.updatedBy = getUsernameFromRequest(request);
+        queueProductWrite(m, request.body(), QByteArray(), responder);
     });
 
     // PUT /api/products/<id> — Produkt aktualisieren
     httpServer.route("/api/products/<arg>", QHttpServerRequest::Method::Put,
+                     [this](int productId, const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "PUT /api/products/{id}");
+        QString authError = checkAuth(request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        qCDebug(lcHttp) << "PUT /api/products/" << productId;
+        WriteBatcher::Mutation m;
+        m.kind = WriteBatcher::Kind::Update;
+        m.productId = productId;
+        m.updatedBy = getUsernameFromRequest(request);
+        queueProductWrite(m, request.body(), QByteArray(), responder);
+    });
+
+    // GET /api/products/<id> — einzelnes Produkt, ETag = row_version
+    httpServer.route("/api/products/<arg>", QHttpServerRequest::Method::Get,
                      [this](int productId, const QHttpServerRequest &request) {
+        RequestContext ctx(request, "GET /api/products/{id}");
         QString authError = checkAuth(request);
         if (!authError.isEmpty()) return unauthorizedResponse(authError);
-        return handleUpdateProduct(productId, request);
+        return handleGetProduct(productId, request);
+    });
+
+    // PATCH /api/products/<id> — nur übergebene Felder, If-Match gegen row_version
+    httpServer.route("/api/products/<arg>", QHttpServerRequest::Method::Patch,
+                     [this](int productId, const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "PATCH /api/products/{id}");
+        QString authError = checkAuth(request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        const QByteArray ifMatch = request.headers().value(QHttpHeaders::WellKnownHeader::IfMatch).toByteArray();
+        qCDebug(lcHttp) << "PATCH /api/products/" << productId << "If-Match:" << ifMatch;
+        WriteBatcher::Mutation m;
+        m.kind = WriteBatcher::Kind::Patch;
+        m.productId = productId;
+        m.updatedBy = getUsernameFromRequest(request);
+        queueProductWrite(m, request.body(), ifMatch, responder);
     });
 
     // DELETE /api/products/<id> — Produkt löschen
     httpServer.route("/api/products/<arg>", QHttpServerRequest::Method::Delete,
-                     [this](int productId, const QHttpServerRequest &request) {
+                     [this](int productId, const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        RequestContext ctx(request, "DELETE /api/products/{id}");
         QString authError = checkAuth(request);
-        if (!authError.isEmpty()) return unauthorizedResponse(authError);
-        return handleDeleteProduct(productId, request);
+        if (!authError.isEmpty()) {
+            responder.sendResponse(unauthorizedResponse(authError));
+            return;
+        }
+        qCDebug(lcHttp) << "DELETE /api/products/" << productId;
+        WriteBatcher::Mutation m;
+        m.kind = WriteBatcher::Kind::Delete;
+        m.productId = productId;
+        m.updatedBy = getUsernameFromRequest(request);
+        queueProductWrite(m, QByteArray(), QByteArray(), responder);
     });
 
-    // Catch-All für 404
-    httpServer.route("/", []() {
-        QJsonObject response;
-        response["error"] = "Not Found";
-        response["message"] = "API Endpoints: POST /api/login, GET /api/greeting, GET /api/styles, GET /api/tables, GET /api/table?name=X, POST /api/shutdown";
-        return QHttpServerResponse("application/json",
-                                   QJsonDocument(response).toJson(),
-                                   QHttpServerResponse::StatusCode::NotFound);
+    // Catch-All: statische Dateien (STATIC_DIR), sonst 404
+    httpServer.route("/", [this](const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        handleStaticOrNotFound(request, responder);
+    });
+    httpServer.setMissingHandler(this, [this](const QHttpServerRequest &request, QHttpServerResponder &responder) {
+        handleStaticOrNotFound(request, responder);
     });
 }
 
+void Server::handleStaticOrNotFound(const QHttpServerRequest &request, QHttpServerResponder &responder)
+{
+    if (request.method() == QHttpServerRequest::Method::Get && staticAssets->isEnabled()) {
+        RequestContext ctx(request, "GET /static");
+        if (staticAssets->serve(request, responder))
+            return;
+    }
+
+    QJsonObject response;
+    response["error"] = "Not Found";
+    response["message"] = "API Endpoints: POST /api/login, GET /api/greeting, GET /api/styles, GET /api/tables, GET /api/table?name=X, POST /api/shutdown";
+    responder.sendResponse(QHttpServerResponse("application/json",
+                                               QJsonDocument(response).toJson(),
+                                               QHttpServerResponse::StatusCode::NotFound));
+}
+
 bool Server::start(quint16 port)
 {
-    tcpServer = new QTcpServer(this);
+    tcpServer = new ConnectionTracker(this);
+    if (capture) {
+        // Status und Dauer je Request, sobald die Antwort beginnt
+        connect(tcpServer, &ConnectionTracker::responseStarted, capture, &TrafficCapture::responded);
+        connect(tcpServer, &ConnectionTracker::connectionClosed, capture, &TrafficCapture::connectionClosed);
+    }
 
     if (!tcpServer->listen(QHostAddress::Any, port)) {
-        qCritical() << "Server konnte nicht auf Port" << port << "starten";
+        qCCritical(lcHttp) << "Server konnte nicht auf Port" << port << "starten";
         return false;
     }
 
     httpServer.bind(tcpServer);
 
-    qInfo() << "HTTP Server läuft auf Port" << port;
+    // Änderungsstrom: Trigger auf product → pg_notify → SSE an alle Clients
+    const QString connInfo = db->libpqConnInfo("webapp-listen");
+    if (!connInfo.isEmpty()) {
+        changeListener = new NotifyListener(connInfo, this);
+        changeListener->listen("product_changes");
+        changeListener->listen("schema_changes");
+        connect(changeListener, &NotifyListener::notification, this,
+                [this](const QString &channel, const QByteArray &payload) {
+            if (channel == "product_changes") {
+                productEvents.publish("product", payload);
+                productNotified(payload);
+            } else if (channel == "schema_changes") {
+                qCInfo(lcHttp) << "Schema-Migration" << payload << "auf einer anderen Instanz — Caches verworfen";
+                ++coherenceSchemaChanges;
+                resyncCaches();
+            }
+        });
+        // Nach Verbindungsverlust können Events fehlen → Clients laden neu,
+        // lokale Caches werden komplett verworfen
+        connect(changeListener, &NotifyListener::reconnected,
+                &productEvents, &EventStream::publishResync);
+        connect(changeListener, &NotifyListener::reconnected, this, [this]() {
+            qCInfo(lcHttp) << "LISTEN-Verbindung wieder da — Caches verworfen";
+            resyncCaches();
+        });
+
+        coherenceTimer.setSingleShot(true);
+        coherenceTimer.setInterval(0);
+        connect(&coherenceTimer, &QTimer::timeout, this, &Server::productsChanged);
+        changeListener->start();
+    }
+
+    setupCatalogSnapshot();
+
+    qCInfo(lcHttp) << "HTTP Server läuft auf Port" << port;
     return true;
 }
 
 // ===== AUTH =====
 
+QString Server::checkInternal(const QHttpServerRequest &request) const
+{
+    // Single-Box: das Backend ist selbst der öffentliche Endpunkt
+    if (!staticAssets->isEnabled() || request.remoteAddress().isLoopback())
+        return QString();
+    return checkAuth(request);
+}
+
 QString Server::checkAuth(const QHttpServerRequest &request) const
 {
     // Authorization Header auslesen
@@ -163,6 +432,7 @@ QString Server::checkAuth(const QHttpServerRequest &request) const
         return "Token ungültig oder abgelaufen";
     }
 
+    RequestContext::setCurrentSession(username);
     return {};  // Leer = OK
 }
 
@@ -170,7 +440,7 @@ QString Server::checkAuth(const QHttpServerRequest &request) const
 
 QHttpServerResponse Server::handleLogin(const QHttpServerRequest &request)
 {
-    qDebug() << "POST /api/login";
+    qCDebug(lcHttp) << "POST /api/login";
 
     // JSON Body parsen
     QJsonDocument doc = QJsonDocument::fromJson(request.body());
@@ -190,7 +460,7 @@ QHttpServerResponse Server::handleLogin(const QHttpServerRequest &request)
 
     // Credentials prüfen
     if (!authManager->authenticate(username, password)) {
-        qWarning() << "Auth: Login fehlgeschlagen für User:" << username;
+        qCWarning(lcAuth) << "Auth: Login fehlgeschlagen für User:" << username;
         return errorResponse("Ungültige Anmeldedaten",
                              QHttpServerResponse::StatusCode::Unauthorized);
     }
@@ -204,21 +474,20 @@ QHttpServerResponse Server::handleLogin(const QHttpServerRequest &request)
     response["expiresIn"] = authManager->tokenLifetime();
     response["message"] = "Login erfolgreich";
 
-    qInfo() << "Auth: Login erfolgreich für User:" << username;
+    qCInfo(lcAuth) << "Auth: Login erfolgreich für User:" << username;
     return jsonResponse(response);
 }
 
 // ===== ROUTE HANDLERS =====
 
-QHttpServerResponse Server::handleGetGreeting(const QHttpServerRequest &request)
+QHttpServerResponse Server::handleGetGreeting(const QUrlQuery &query)
 {
-    QUrlQuery query(request.url());
     QString language = query.queryItemValue("lang");
     if (language.isEmpty()) {
         language = "de";
     }
 
-    qDebug() << "GET /api/greeting - Language:" << language;
+    qCDebug(lcHttp) << "GET /api/greeting - Language:" << language;
 
     QString greeting = db->getGreeting(language);
 
@@ -234,20 +503,25 @@ QHttpServerResponse Server::handleShutdown(const QHttpServerRequest &request)
 {
     Q_UNUSED(request);
 
-    qWarning() << "POST /api/shutdown - Server wird heruntergefahren!";
+    qCWarning(lcHttp) << "POST /api/shutdown - Server wird heruntergefahren!";
+
+    // Erst aus dem Load Balancer nehmen (ready → 503), dann beenden
+    const int drainMs = qEnvironmentVariableIsSet("HEALTH_DRAIN_MS")
+                            ? qMax(0, qEnvironmentVariableIntValue("HEALTH_DRAIN_MS")) : 2000;
+    health->startDrain();
 
     QJsonObject response;
     response["status"] = "shutting down";
-    response["message"] = "Server wird in 2 Sekunden beendet";
+    response["message"] = QString("Server wird in %1 Sekunden beendet").arg(drainMs / 1000.0);
 
-    QTimer::singleShot(2000, qApp, &QCoreApplication::quit);
+    QTimer::singleShot(drainMs, qApp, &QCoreApplication::quit);
 
     return jsonResponse(response);
 }
 
 QHttpServerResponse Server::handleGetStyles()
 {
-    qDebug() << "GET /api/styles";
+    qCDebug(lcHttp) << "GET /api/styles";
 
     QJsonArray styles;
 
@@ -270,12 +544,25 @@ QHttpServerResponse Server::handleGetStyles()
     return jsonResponse(response);
 }
 
-QHttpServerResponse Server::handleGetTables()
+QHttpServerResponse Server::handleGetTables(Encoding encoding)
 {
-    qDebug() << "GET /api/tables";
+    qCDebug(lcHttp) << "GET /api/tables";
 
     QStringList tables = db->getTables();
 
+    if (encoding == Encoding::Cbor) {
+        QByteArray out;
+        QCborStreamWriter w(&out);
+        w.startMap(1);
+        w.append(QLatin1StringView("tables"));
+        w.startArray(tables.size());
+        for (const QString &t : tables)
+            w.append(t);
+        w.endArray();
+        w.endMap();
+        return cborResponse(out);
+    }
+
     QJsonArray arr;
     for (const QString &t : tables)
         arr.append(t);
@@ -285,36 +572,365 @@ QHttpServerResponse Server::handleGetTables()
     return jsonResponse(response);
 }
 
-QHttpServerResponse Server::handleGetTableData(const QHttpServerRequest &request)
+QHttpServerResponse Server::handleGetTableData(const QUrlQuery &query, Encoding encoding)
 {
-    QUrlQuery query(request.url());
+    // Default 200 Zeilen, der Tabellen-Browser fordert mehr an
+    static const int MaxTableRows = 10000;
+
     QString tableName = query.queryItemValue("name");
-    qDebug() << "GET /api/table - name:" << tableName;
+    int limit = query.hasQueryItem("limit") ? query.queryItemValue("limit").toInt() : 200;
+    if (limit <= 0) limit = 200;
+    if (limit > MaxTableRows) limit = MaxTableRows;
+    qCDebug(lcHttp) << "GET /api/table - name:" << tableName << "limit:" << limit;
 
     if (tableName.isEmpty()) {
         return errorResponse("Parameter 'name' fehlt",
                              QHttpServerResponse::StatusCode::BadRequest);
     }
 
-    QJsonObject data = db->getTableData(tableName);
+    if (query.queryItemValue("layout") == "columnar") {
+        ColumnarResult result;
+        QString error;
+        if (!db->readTableColumnar(tableName, limit, result, &error))
+            return errorResponse(error, readErrorStatus(QHttpServerResponse::StatusCode::NotFound));
+
+        if (encoding == Encoding::Cbor) {
+            QByteArray out;
+            QCborStreamWriter w(&out);
+            w.startMap();
+            w.append(QLatin1StringView("table"));
+            w.append(tableName);
+            result.writeCbor(w);
+            w.endMap();
+            return cborResponse(out);
+        }
+        QJsonObject data;
+        data["table"] = tableName;
+        result.addToJson(data);
+        return jsonResponse(data);
+    }
+
+    if (encoding == Encoding::Cbor) {
+        QString error;
+        const QByteArray data = db->getTableDataCbor(tableName, limit, &error);
+        if (!error.isEmpty())
+            return errorResponse(error, readErrorStatus(QHttpServerResponse::StatusCode::NotFound));
+        return cborResponse(data);
+    }
+
+    QJsonObject data = db->getTableData(tableName, limit);
     if (data.contains("error")) {
         return errorResponse(data["error"].toString(),
-                             QHttpServerResponse::StatusCode::NotFound);
+                             readErrorStatus(QHttpServerResponse::StatusCode::NotFound));
     }
 
     return jsonResponse(data);
 }
 
+void Server::handleTableExport(const QHttpServerRequest &request, QHttpServerResponder &responder)
+{
+    const QUrlQuery query(request.url());
+    const QString tableName = query.queryItemValue("name");
+    const QString format = query.hasQueryItem("format") ? query.queryItemValue("format") : "csv";
+    qCDebug(lcHttp) << "GET /api/table/export - name:" << tableName << "format:" << format;
+
+    if (tableName.isEmpty()) {
+        responder.sendResponse(errorResponse("Parameter 'name' fehlt",
+                                             QHttpServerResponse::StatusCode::BadRequest));
+        return;
+    }
+    if (format != "csv" && format != "ndjson") {
+        responder.sendResponse(errorResponse("Parameter 'format' muss csv oder ndjson sein",
+                                             QHttpServerResponse::StatusCode::BadRequest));
+        return;
+    }
+
+    const QString connInfo = db->libpqConnInfo("webapp-export");
+    if (connInfo.isEmpty()) {
+        responder.sendResponse(errorResponse("Export nicht verfügbar (nur PostgreSQL)",
+                                             QHttpServerResponse::StatusCode::NotImplemented));
+        return;
+    }
+
+    // Dieselbe Whitelist wie /api/table (SQL-Injection-Schutz)
+    if (!db->getTables().contains(tableName)) {
+        responder.sendResponse(errorResponse("Tabelle nicht gefunden: " + tableName,
+                                             QHttpServerResponse::StatusCode::NotFound));
+        return;
+    }
+
+    // Läuft im Event-Loop weiter und löscht sich am Ende selbst
+    new TableExport(connInfo, tableName,
+                    format == "csv" ? TableExport::Format::Csv : TableExport::Format::Ndjson,
+                    std::move(responder), tcpServer->socketFor(request), this);
+}
+
 QHttpServerResponse Server::handleHealth()
 {
+    // Ergebnis der letzten Hintergrund-Prüfung statt isOpen() — merkt auch
+    // einen toten DB-Server; Status bleibt 200 wie bisher
     QJsonObject response;
     response["status"] = "ok";
-    response["database"] = db->isConnected() ? "connected" : "disconnected";
+    response["database"] = health->databaseReachable() ? "connected" : "disconnected";
+    response["ready"] = health->isReady();
     response["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
 
     return jsonResponse(response);
 }
 
+QHttpServerResponse Server::handleHealthLive()
+{
+    // Antwortet der Event-Loop, lebt der Prozess — unabhängig von der DB
+    return QHttpServerResponse("application/json", health->liveBody());
+}
+
+QHttpServerResponse Server::handleHealthReady()
+{
+    return QHttpServerResponse("application/json", health->readyBody(),
+                               health->isReady() ? QHttpServerResponse::StatusCode::Ok
+                                                 : QHttpServerResponse::StatusCode::ServiceUnavailable);
+}
+
+// ===== BATCH =====
+
+static const int MaxBatchSize = 20;
+
+void Server::handleBatch(const QHttpServerRequest &request, QHttpServerResponder &responder)
+{
+    // Body: {"requests": [{"id": "greeting", "method": "GET", "path": "/api/greeting",
+    //                      "query": {"lang": "de"}, "body": {...}}, ...]}
+    // GETs dürfen "ifNoneMatch" mitgeben → Ergebnis 304 ohne Body, wenn unverändert;
+    // PATCH "ifMatch" wie der If-Match-Header → 412 bei veralteter row_version
+    qCDebug(lcHttp) << "POST /api/batch";
+
+    QJsonDocument doc = QJsonDocument::fromJson(request.body());
+    if (doc.isNull() || !doc.isObject() || !doc.object()["requests"].isArray()) {
+        responder.sendResponse(errorResponse("JSON mit Array 'requests' erwartet",
+                                             QHttpServerResponse::StatusCode::BadRequest));
+        return;
+    }
+
+    const QJsonArray subs = doc.object()["requests"].toArray();
+    if (subs.size() > MaxBatchSize) {
+        responder.sendResponse(errorResponse(QString("Maximal %1 Sub-Requests pro Batch").arg(MaxBatchSize),
+                                             QHttpServerResponse::StatusCode::BadRequest));
+        return;
+    }
+
+    // Gemeinsame Angaben aller Sub-Requests (Request-ID, Session, Socket)
+    const GuardedRead base = guardedRead(RequestContext::current()->route(), QUrlQuery(), Encoding::Json,
+                                         tcpServer->socketFor(request), nullptr);
+
+    QList<QFuture<GuardedResult>> futures;
+    futures.reserve(subs.size());
+    for (qsizetype i = 0; i < subs.size(); ++i) {
+        const QJsonObject sub = subs[i].toObject();
+        const QString method = sub["method"].toString("GET").toUpper();
+        const QString path = sub["path"].toString();
+
+        QUrlQuery query;
+        if (sub["query"].isObject()) {
+            const QJsonObject q = sub["query"].toObject();
+            for (auto it = q.begin(); it != q.end(); ++it)
+                query.addQueryItem(it.key(), it.value().toVariant().toString());
+        } else {
+            query.setQuery(sub["query"].toString());
+        }
+
+        QByteArray body;
+        if (sub["body"].isObject())
+            body = QJsonDocument(sub["body"].toObject()).toJson(QJsonDocument::Compact);
+        else if (sub["body"].isArray())
+            body = QJsonDocument(sub["body"].toArray()).toJson(QJsonDocument::Compact);
+        else
+            body = sub["body"].toString().toUtf8();
+
+        futures.append(dispatchSubRequest(base, method, path, query, body, sub["ifMatch"].toString().toUtf8()));
+    }
+
+    auto pending = std::make_shared<QHttpServerResponder>(std::move(responder));
+    const QPointer<QTcpSocket> socket = base.socket;
+    QtFuture::whenAll(futures.begin(), futures.end())
+        .then(this, [pending, socket, subs](const QList<QFuture<GuardedResult>> &done) {
+        // Client weg: niemand mehr da, der die Antwort liest
+        if (!socket || socket->state() != QAbstractSocket::ConnectedState)
+            return;
+
+        QList<GuardedResult> results;
+        results.reserve(done.size());
+        for (const QFuture<GuardedResult> &f : done)
+            results.append(f.result());
+
+        // Bedingte GETs: ETag wie bei den Einzel-Routen
+        QList<QByteArray> etags(subs.size());
+        for (qsizetype i = 0; i < subs.size(); ++i) {
+            const QJsonObject sub = subs[i].toObject();
+            if (sub["method"].toString("GET").toUpper() != "GET" || results[i].status != 200)
+                continue;
+            // Treffer aus dem Response-Cache bringen ihr ETag schon mit
+            etags[i] = results[i].headers.value(QHttpHeaders::WellKnownHeader::ETag).toByteArray();
+            if (etags[i].isEmpty())
+                etags[i] = ResponseCache::etag(results[i].body);
+            if (sub["ifNoneMatch"].toString().toUtf8() == etags[i]) {
+                results[i].status = 304;
+                results[i].body.clear();
+            }
+        }
+
+        // Antwort ohne erneutes Parsen zusammensetzen: JSON-Bodies werden roh eingebettet
+        QByteArray out = "{\"results\":[";
+        for (qsizetype i = 0; i < results.size(); ++i) {
+            const QJsonObject sub = subs[i].toObject();
+            QJsonObject meta;
+            meta["id"] = sub.contains("id") ? sub["id"] : QJsonValue(int(i));
+            meta["status"] = results[i].status;
+            if (!etags[i].isEmpty())
+                meta["etag"] = QString::fromUtf8(etags[i]);
+            QByteArray metaJson = QJsonDocument(meta).toJson(QJsonDocument::Compact);
+            metaJson.chop(1);   // schließende Klammer
+
+            QByteArray bodyJson;
+            if (results[i].status == 304) {
+                bodyJson = "null";
+            } else if (results[i].mimeType.startsWith("application/json") && !results[i].body.isEmpty()) {
+                bodyJson = results[i].body.trimmed();
+            } else {
+                bodyJson = QJsonDocument(QJsonArray{ QString::fromUtf8(results[i].body) }).toJson(QJsonDocument::Compact);
+                bodyJson = bodyJson.mid(1, bodyJson.size() - 2);
+            }
+
+            if (i > 0) out += ',';
+            out += metaJson + ",\"body\":" + bodyJson + '}';
+        }
+        out += "],\"count\":" + QByteArray::number(results.size()) + '}';
+
+        pending->sendResponse(QHttpServerResponse("application/json", out));
+    });
+}
+
+QFuture<Server::GuardedResult> Server::dispatchSubRequest(const GuardedRead &base, const QString &method,
+                                                          const QString &path, const QUrlQuery &query,
+                                                          const QByteArray &body, const QByteArray &ifMatch)
+{
+    // Gleiche Handler und Wege wie die regulären Routen — Login, Shutdown und
+    // verschachtelte Batches sind bewusst nicht erreichbar
+    if (method == "GET") {
+        const QByteArray route = "GET " + path.toUtf8();
+        auto read = [&](std::function<QHttpServerResponse()> handler) {
+            return guardedRead(route, query, Encoding::Json, base.socket, std::move(handler));
+        };
+        if (path == "/api/greeting")
+            return dispatchGuarded(read([this, query]() { return handleGetGreeting(query); }));
+        if (path == "/api/styles")
+            return cachedRead(read([this]() { return handleGetStyles(); }), QByteArray());
+        if (path == "/api/tables")
+            return cachedRead(read([this]() { return handleGetTables(); }), QByteArray());
+        if (path == "/api/table")
+            return cachedRead(read([this, query]() { return handleGetTableData(query); }),
+                              query.queryItemValue("name").toUtf8());
+        if (path == "/api/products")
+            return dispatchGuarded(read([this, query]() { return handleGetProducts(query); }));
+    } else if (method == "POST" && path == "/api/products") {
+        // Schreibzugriffe über den WriteBatcher — committet in Batch-Reihenfolge
+        WriteBatcher::Mutation m;
+        m.kind = WriteBatcher::Kind::Insert;
+        m.updatedBy = base.session;
+        return submitProductWrite(m, body, QByteArray());
+    } else if (path.startsWith("/api/products/")) {
+        bool ok = false;
+        WriteBatcher::Mutation m;
+        m.productId = path.mid(QStringLiteral("/api/products/").size()).toInt(&ok);
+        m.updatedBy = base.session;
+        if (ok && method == "PUT")    { m.kind = WriteBatcher::Kind::Update; return submitProductWrite(m, body, QByteArray()); }
+        if (ok && method == "PATCH")  { m.kind = WriteBatcher::Kind::Patch;  return submitProductWrite(m, body, ifMatch); }
+        if (ok && method == "DELETE") { m.kind = WriteBatcher::Kind::Delete; return submitProductWrite(m, QByteArray(), QByteArray()); }
+    }
+
+    return QtFuture::makeReadyValueFuture(GuardedResult::from(
+        errorResponse("Sub-Request nicht unterstützt: " + method + " " + path,
+                      QHttpServerResponse::StatusCode::NotFound)));
+}
+
+// ===== LOGGING + METRIKEN =====
+
+QHttpServerResponse Server::handleGetLogging()
+{
+    QJsonObject response;
+    response["rules"] = AsyncLogger::filterRules();
+    response["logging"] = AsyncLogger::stats();
+    return jsonResponse(response);
+}
+
+QHttpServerResponse Server::handleSetLogging(const QHttpServerRequest &request)
+{
+    // Body: {"rules": "webapp.db.debug=false;webapp.http.debug=true"}
+    QJsonDocument doc = QJsonDocument::fromJson(request.body());
+    if (doc.isNull() || !doc.isObject() || !doc.object().contains("rules"))
+        return errorResponse("JSON mit Feld 'rules' erwartet", QHttpServerResponse::StatusCode::BadRequest);
+
+    const QString rules = doc.object()["rules"].toString();
+    AsyncLogger::setFilterRules(rules);
+    qCInfo(lcHttp) << "Logging-Regeln gesetzt:" << rules;
+
+    return handleGetLogging();
+}
+
+QHttpServerResponse Server::handleMetrics()
+{
+    QJsonObject response;
+    response["logging"] = AsyncLogger::stats();
+    response["events"] = productEvents.stats();
+    response["writeBatch"] = writeBatcher->stats();
+    response["queries"] = db->queryGuard()->stats();
+    response["exports"] = TableExport::stats();
+    if (staticAssets->isEnabled())
+        response["static"] = staticAssets->stats();
+    if (capture)
+        response["capture"] = capture->stats();
+    response["responseCache"] = responseCache->stats();
+    QJsonObject coalescing;
+    coalescing["leaders"]   = qint64(coalesceLeaders);
+    coalescing["followers"] = qint64(coalesceFollowers);
+    coalescing["reruns"]    = qint64(coalesceReruns);
+    coalescing["inFlight"]  = qint64(inFlightReads.size());
+    response["coalescing"] = coalescing;
+    QJsonObject coherence;
+    coherence["listening"]     = changeListener && changeListener->isConnected();
+    coherence["notifications"] = qint64(coherenceNotifications);
+    coherence["skipped"]       = qint64(coherenceSkipped);
+    coherence["resyncs"]       = qint64(coherenceResyncs);
+    coherence["schemaChanges"] = qint64(coherenceSchemaChanges);
+    response["coherence"] = coherence;
+    response["health"] = health->stats();
+    const QJsonObject replicas = db->replicaStats();
+    if (!replicas.isEmpty())
+        response["replicas"] = replicas;
+
+    QJsonObject stats;
+    stats["rebuilds"] = qint64(statsRebuilds);
+    if (statsSnapshot) {
+        stats["rows"] = statsSnapshot->rowCount();
+        stats["buildMs"] = statsSnapshot->buildMs;
+        stats["builtAt"] = statsSnapshot->builtAt.toString(Qt::ISODateWithMs);
+    }
+    if (!catalogPath.isEmpty()) {
+        QJsonObject catalog = catalogStats;
+        catalog["dirty"] = catalogDirty;
+        stats["catalog"] = catalog;
+    }
+    response["productStats"] = stats;
+    response["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    return jsonResponse(response);
+}
+
+QHttpServerResponse Server::handleDebugAlloc(const QUrlQuery &query)
+{
+    if (!AllocProfiler::compiledIn())
+        return errorResponse("Allokations-Profiling nicht einkompiliert (qmake CONFIG+=alloc_profiling)",
+                             QHttpServerResponse::StatusCode::NotFound);
+    return jsonResponse(AllocProfiler::report(query.queryItemValue("reset") == "1"));
+}
+
 // ===== PRODUCT HANDLER =====
 
 QString Server::getUsernameFromRequest(const QHttpServerRequest &request) const
@@ -330,57 +946,679 @@ QString Server::getUsernameFromRequest(const QHttpServerRequest &request) const
     return {};
 }
 
-QHttpServerResponse Server::handleGetProducts(const QHttpServerRequest &request)
+QHttpServerResponse Server::handleGetProducts(const QUrlQuery &query, Encoding encoding)
 {
-    Q_UNUSED(request);
-    qDebug() << "GET /api/products";
-    QJsonObject data = db->getProducts();
+    // Seitengröße begrenzen, damit ein Request nicht die ganze Tabelle zieht
+    static const int MaxPageSize = 1000;
+
+    const int afterId = query.queryItemValue("after").toInt();
+    int limit = query.queryItemValue("limit").toInt();
+    if (limit < 0) limit = 0;
+    if (limit > MaxPageSize) limit = MaxPageSize;
+
+    qCDebug(lcHttp) << "GET /api/products - after:" << afterId << "limit:" << limit;
+
+    if (query.queryItemValue("layout") == "columnar") {
+        ColumnarResult result;
+        QString error;
+        bool hasMore = false;
+        if (!db->readProductsColumnar(afterId, limit, result, &hasMore, &error))
+            return errorResponse(error, readErrorStatus(QHttpServerResponse::StatusCode::InternalServerError));
+
+        // product_id ist die erste Spalte
+        const QVariant nextAfter = result.lastValue(0);
+        if (encoding == Encoding::Cbor) {
+            QByteArray out;
+            QCborStreamWriter w(&out);
+            w.startMap();
+            result.writeCbor(w);
+            w.append(QLatin1StringView("count"));
+            w.append(qint64(result.rowCount()));
+            if (limit > 0) {
+                w.append(QLatin1StringView("hasMore"));
+                w.append(hasMore);
+                if (nextAfter.isValid()) {
+                    w.append(QLatin1StringView("nextAfter"));
+                    w.append(nextAfter.toLongLong());
+                }
+            }
+            w.endMap();
+            return cborResponse(out);
+        }
+        QJsonObject data;
+        result.addToJson(data);
+        data["count"] = result.rowCount();
+        if (limit > 0) {
+            data["hasMore"] = hasMore;
+            if (nextAfter.isValid())
+                data["nextAfter"] = nextAfter.toLongLong();
+        }
+        return jsonResponse(data);
+    }
+
+    if (encoding == Encoding::Cbor) {
+        QString error;
+        const QByteArray data = db->getProductsCbor(afterId, limit, &error);
+        if (!error.isEmpty())
+            return errorResponse(error, readErrorStatus(QHttpServerResponse::StatusCode::InternalServerError));
+        return cborResponse(data);
+    }
+
+    QJsonObject data = db->getProducts(afterId, limit);
     if (data.contains("error"))
-        return errorResponse(data["error"].toString());
+        return errorResponse(data["error"].toString(),
+                             readErrorStatus(QHttpServerResponse::StatusCode::InternalServerError));
     return jsonResponse(data);
 }
 
-QHttpServerResponse Server::handleCreateProduct(const QHttpServerRequest &request)
+void Server::handleProductStats(const QHttpServerRequest &request, QHttpServerResponder &responder)
 {
-    qDebug() << "POST /api/products";
-    QJsonDocument doc = QJsonDocument::fromJson(request.body());
-    if (doc.isNull() || !doc.isObject())
-        return errorResponse("Ungültiger JSON-Body", QHttpServerResponse::StatusCode::BadRequest);
+    const QUrlQuery query(request.url());
+    ProductStats::Request statsRequest;
+    QString error;
+    if (!ProductStats::parseRequest(query, &statsRequest, &error)) {
+        responder.sendResponse(errorResponse(error, QHttpServerResponse::StatusCode::BadRequest));
+        return;
+    }
 
-    QString username = getUsernameFromRequest(request);
-    QJsonObject result = db->insertProduct(doc.object(), username);
+    qCDebug(lcHttp) << "GET /api/products/stats - group_by:" << query.queryItemValue("group_by")
+                    << "metrics:" << query.queryItemValue("metrics");
+
+    // Schnappschuss laden und aggregieren im DB-Pool — der Event-Loop wartet nicht
+    const RequestContext *ctx = RequestContext::current();
+    const QByteArray requestId = ctx->id();
+    const QString session = ctx->session();
+    QFuture<GuardedResult> result = productSnapshot().then(this, [this, statsRequest, requestId, session](
+                                                                      const StatsBuild &build) {
+        if (!build.snapshot)
+            return QtFuture::makeReadyValueFuture(GuardedResult::from(errorResponse(build.error)));
+        // Eigene Referenz: der Schnappschuss bleibt gültig, auch wenn er
+        // währenddessen verworfen wird
+        const std::shared_ptr<const ProductSnapshot> snapshot = build.snapshot;
+        return QtConcurrent::run(db->pool(), [this, snapshot, statsRequest, requestId, session]() {
+            RequestContext worker(requestId, "GET /api/products/stats", session);
+            return GuardedResult::from(jsonResponse(ProductStats::aggregate(*snapshot, statsRequest)));
+        });
+    }).unwrap();
+    respondWhenDone(result, request, responder);
+}
 
-    if (result.contains("error"))
-        return errorResponse(result["error"].toString(), QHttpServerResponse::StatusCode::BadRequest);
-    return jsonResponse(result, QHttpServerResponse::StatusCode::Created);
+QFuture<Server::StatsBuild> Server::productSnapshot()
+{
+    // Ohne NOTIFY (Oracle) wird der Schnappschuss spätestens nach 5 min erneuert
+    static const qint64 MaxSnapshotAgeSecs = 300;
+
+    // Warmstart: der Stand der Katalog-Datei gilt, bis das Nachziehen fertig ist
+    if (statsSnapshot && (catalogCatchingUp
+                          || statsSnapshot->builtAt.secsTo(QDateTime::currentDateTimeUtc()) <= MaxSnapshotAgeSecs))
+        return QtFuture::makeReadyValueFuture(StatsBuild{ statsSnapshot, QString() });
+    // Läuft schon ein Aufbau auf aktuellem Stand: mitwarten statt selbst scannen
+    if (statsBuilding && statsBuildGeneration == statsGeneration)
+        return statsBuild.wait();
+
+    const RequestContext *ctx = RequestContext::current();
+    const QByteArray requestId = ctx->id();
+    const QString session = ctx->session();
+    const quint64 generation = statsGeneration;
+    Database *database = db;
+    statsBuilding = true;
+    statsBuildGeneration = generation;
+    statsBuild = SharedResult<StatsBuild>();
+    QFuture<StatsBuild> result = statsBuild.wait();
+    QtConcurrent::run(db->pool(), [database, requestId, session]() {
+        RequestContext worker(requestId, "GET /api/products/stats", session);
+        StatsBuild build;
+        auto snapshot = std::make_shared<ProductSnapshot>();
+        if (database->loadProductSnapshot(*snapshot, &build.error))
+            build.snapshot = std::move(snapshot);
+        return build;
+    }).then(this, [this, generation, waiting = statsBuild](const StatsBuild &build) mutable {
+        if (statsBuildGeneration == generation)
+            statsBuilding = false;
+        // Währenddessen verworfen: Ergebnis beantwortet die wartenden
+        // Abrufe, wird aber nicht für spätere übernommen
+        if (build.snapshot && generation == statsGeneration) {
+            qCInfo(lcHttp) << "Produkt-Schnappschuss geladen:" << build.snapshot->rowCount() << "Zeilen in"
+                           << build.snapshot->buildMs << "ms";
+            statsSnapshot = build.snapshot;
+            ++statsRebuilds;
+        }
+        waiting.finish(build);
+    });
+    return result;
 }
 
-QHttpServerResponse Server::handleUpdateProduct(int productId, const QHttpServerRequest &request)
+void Server::invalidateStatsSnapshot()
 {
-    qDebug() << "PUT /api/products/" << productId;
-    QJsonDocument doc = QJsonDocument::fromJson(request.body());
-    if (doc.isNull() || !doc.isObject())
-        return errorResponse("Ungültiger JSON-Body", QHttpServerResponse::StatusCode::BadRequest);
+    statsSnapshot.reset();
+    ++statsGeneration;
+    catalogDirty = true;
+}
+
+void Server::productsChanged()
+{
+    invalidateStatsSnapshot();
+    responseCache->invalidate("product");
+    // Wer ab jetzt liest, hängt sich nicht mehr an Abfragen von vor der Änderung
+    inFlightReads.clear();
+    // Replicas, die die Änderung noch nicht haben, füllen den Cache nicht wieder
+    db->noteDataChanged();
+}
 
-    QString username = getUsernameFromRequest(request);
-    QJsonObject result = db->updateProduct(productId, doc.object(), username);
+// Gemerkte eigene Schreibzugriffe (product_id → row_version)
+static const qsizetype MaxLocalVersions = 10000;
+// Selbst gelöscht: passt zu jeder Notification "delete" dieser ID
+static const qint64 DeletedVersion = std::numeric_limits<qint64>::max();
 
-    if (result.contains("error"))
-        return errorResponse(result["error"].toString(), QHttpServerResponse::StatusCode::BadRequest);
-    return jsonResponse(result);
+void Server::productNotified(const QByteArray &payload)
+{
+    ++coherenceNotifications;
+    // Eigene Schreibzugriffe sind beim Commit schon lokal verworfen worden
+    const QJsonObject change = QJsonDocument::fromJson(payload).object();
+    const qint64 version = change["version"].toInteger(-1);
+    const qint64 known = localVersions.value(change["id"].toInteger(-1), -1);
+    // Löschen trägt die alte Version — eigenes nur, wenn wir die Zeile gelöscht haben
+    const bool own = change["op"].toString() == "delete" ? known == DeletedVersion
+                                                         : version >= 0 && known >= version;
+    if (own) {
+        ++coherenceSkipped;
+        return;
+    }
+    // Ein Batch auf einer anderen Instanz schickt viele Notifications auf einmal
+    if (!coherenceTimer.isActive())
+        coherenceTimer.start();
 }
 
-QHttpServerResponse Server::handleDeleteProduct(int productId, const QHttpServerRequest &request)
+void Server::rememberLocalWrite(qint64 productId, qint64 version)
 {
-    Q_UNUSED(request);
-    qDebug() << "DELETE /api/products/" << productId;
-    QJsonObject result = db->deleteProduct(productId);
+    // Neue IDs hinten anstellen; wer erneut geschrieben wird, behält seinen
+    // Platz — fällt er zu früh heraus, verwirft seine Notification eben noch einmal
+    if (!localVersions.contains(productId))
+        localVersionOrder.enqueue(productId);
+    localVersions.insert(productId, version);
+    while (localVersionOrder.size() > MaxLocalVersions)
+        localVersions.remove(localVersionOrder.dequeue());
+}
+
+void Server::resyncCaches()
+{
+    coherenceTimer.stop();
+    localVersions.clear();
+    localVersionOrder.clear();
+    responseCache->clear();
+    productsChanged();
+    ++coherenceResyncs;
+}
+
+void Server::setupCatalogSnapshot()
+{
+    catalogPath = qEnvironmentVariable("CATALOG_SNAPSHOT_FILE");
+    if (catalogPath.isEmpty())
+        return;
+    catalogStats["file"] = catalogPath;
+
+    auto catalog = std::make_shared<CatalogSnapshot>();
+    QString error;
+    QElapsedTimer timer;
+    timer.start();
+    if (catalog->open(catalogPath, &error)) {
+        // Sofort bedienbar, ohne die Datenbank anzufassen
+        auto warm = std::make_shared<ProductSnapshot>();
+        warm->reserve(catalog->rowCount());
+        for (qint64 i = 0; i < catalog->rowCount(); ++i)
+            catalog->appendTo(*warm, i);
+        warm->finish(timer.elapsed());
+        // So alt wie die Datei, nicht wie der Start (snapshotAt, Altersgrenze)
+        warm->builtAt = catalog->createdAt();
+        statsSnapshot = warm;
+        catalogCatchingUp = true;
+        catalogDirty = false;
+        catalogStats["warmStartRows"] = catalog->rowCount();
+        catalogStats["warmStartMs"] = warm->buildMs;
+        catalogStats["fileCreatedAt"] = catalog->createdAt().toString(Qt::ISODate);
+        qCInfo(lcHttp) << "Katalog-Schnappschuss geladen:" << catalog->rowCount() << "Zeilen vom"
+                       << catalog->createdAt().toString(Qt::ISODate) << "in" << warm->buildMs << "ms";
+
+        // Nachziehen im Worker-Pool; das Mapping lebt, bis es fertig ist
+        struct CatchUp {
+            std::shared_ptr<ProductSnapshot> snapshot;
+            qint64 changed = 0;
+            bool ok = false;
+            QString error;
+        };
+        Database *database = db;
+        const quint64 generation = statsGeneration;
+        QtConcurrent::run(db->pool(), [database, catalog]() {
+            CatchUp r;
+            r.snapshot = std::make_shared<ProductSnapshot>();
+            r.ok = database->catchUpProductSnapshot(*catalog, *r.snapshot, &r.changed, &r.error);
+            return r;
+        }).then(this, [this, generation](const CatchUp &r) {
+            catalogCatchingUp = false;
+            if (!r.ok) {
+                // Stand der Datei nicht weiter ausliefern — nächster Abruf lädt aus der DB
+                qCWarning(lcHttp) << "Katalog nachziehen fehlgeschlagen:" << r.error;
+                if (generation == statsGeneration)
+                    statsSnapshot.reset();
+                return;
+            }
+            catalogStats["catchUpChanged"] = r.changed;
+            catalogStats["catchUpMs"] = r.snapshot->buildMs;
+            if (r.changed > 0)
+                catalogDirty = true;
+            // Zwischendurch invalidiert: dann lädt der nächste Abruf ohnehin frisch
+            if (generation == statsGeneration)
+                statsSnapshot = r.snapshot;
+            qCInfo(lcHttp) << "Katalog nachgezogen:" << r.changed << "geänderte Zeilen in"
+                           << r.snapshot->buildMs << "ms";
+        });
+    } else if (QFile::exists(catalogPath)) {
+        qCWarning(lcHttp) << "Katalog-Schnappschuss unbrauchbar:" << error << "— wird neu geschrieben";
+    } else {
+        qCInfo(lcHttp) << "Noch kein Katalog-Schnappschuss unter" << catalogPath;
+    }
+
+    const int secs = qEnvironmentVariableIntValue("CATALOG_SNAPSHOT_SECS");
+    catalogTimer.setInterval((secs > 0 ? secs : 600) * 1000);
+    connect(&catalogTimer, &QTimer::timeout, this, &Server::writeCatalogSnapshot);
+    catalogTimer.start();
+}
+
+void Server::writeCatalogSnapshot()
+{
+    if (!catalogDirty || catalogWriting)
+        return;
+    // Änderungen während des Schreibens setzen catalogDirty wieder
+    catalogWriting = true;
+    catalogDirty = false;
+
+    struct Written {
+        qint64 rows = 0;
+        qint64 ms = 0;
+        bool ok = false;
+        QString error;
+    };
+    Database *database = db;
+    const QString path = catalogPath;
+    QtConcurrent::run(db->pool(), [database, path]() {
+        Written r;
+        QElapsedTimer timer;
+        timer.start();
+        r.ok = database->writeCatalogSnapshot(path, &r.rows, &r.error);
+        r.ms = timer.elapsed();
+        return r;
+    }).then(this, [this](const Written &r) {
+        catalogWriting = false;
+        if (!r.ok) {
+            catalogDirty = true;
+            qCWarning(lcHttp) << "Katalog-Schnappschuss schreiben fehlgeschlagen:" << r.error;
+            return;
+        }
+        catalogStats["writes"] = catalogStats["writes"].toInteger() + 1;
+        catalogStats["lastWriteRows"] = r.rows;
+        catalogStats["lastWriteMs"] = r.ms;
+        catalogStats["lastWriteAt"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        qCInfo(lcHttp) << "Katalog-Schnappschuss geschrieben:" << r.rows << "Zeilen in" << r.ms << "ms";
+    });
+}
+
+void Server::handleProductEvents(const QHttpServerRequest &request, QHttpServerResponder &responder)
+{
+    qCDebug(lcHttp) << "GET /api/products/events";
+
+    if (!changeListener) {
+        responder.sendResponse(errorResponse("Änderungsstrom nicht verfügbar (nur PostgreSQL)",
+                                             QHttpServerResponse::StatusCode::ServiceUnavailable));
+        return;
+    }
+
+    QHttpHeaders headers;
+    headers.append(QHttpHeaders::WellKnownHeader::ContentType, "text/event-stream");
+    headers.append(QHttpHeaders::WellKnownHeader::CacheControl, "no-cache");
+    headers.append("X-Accel-Buffering", "no");   // NGINX: nicht puffern
+    responder.writeBeginChunked(headers);
+
+    const quint64 lastEventId = request.headers().value("last-event-id").toByteArray().toULongLong();
+    productEvents.subscribe(std::move(responder), tcpServer->socketFor(request), lastEventId);
+}
+
+// Starkes ETag aus der Zeilenversion: "<row_version>"
+static QByteArray versionETag(qint64 version)
+{
+    return '"' + QByteArray::number(version) + '"';
+}
+
+static QHttpServerResponse withVersionETag(QHttpServerResponse &&response, qint64 version)
+{
+    QHttpHeaders headers = response.headers();
+    headers.replaceOrAppend(QHttpHeaders::WellKnownHeader::ETag, versionETag(version));
+    response.setHeaders(std::move(headers));
+    return std::move(response);
+}
+
+QHttpServerResponse Server::handleGetProduct(int productId, const QHttpServerRequest &request)
+{
+    qCDebug(lcHttp) << "GET /api/products/" << productId;
+    const QJsonObject result = db->getProduct(productId);
+    if (result.contains("error")) {
+        return errorResponse(result["error"].toString(), result["notFound"].toBool()
+                                 ? QHttpServerResponse::StatusCode::NotFound
+                                 : QHttpServerResponse::StatusCode::InternalServerError);
+    }
+
+    const qint64 version = result["row_version"].toInteger();
+    const QByteArray ifNoneMatch = request.headers().value(QHttpHeaders::WellKnownHeader::IfNoneMatch).toByteArray();
+    if (!ifNoneMatch.isEmpty() && ifNoneMatch.contains(versionETag(version)))
+        return withVersionETag(QHttpServerResponse(QHttpServerResponse::StatusCode::NotModified), version);
+    return withVersionETag(jsonResponse(result), version);
+}
 
-    if (result.contains("error"))
-        return errorResponse(result["error"].toString(), QHttpServerResponse::StatusCode::NotFound);
+bool Server::parseProductWrite(WriteBatcher::Mutation &mutation, const QByteArray &body,
+                               const QByteArray &ifMatch, QHttpServerResponse *error)
+{
+    if (mutation.kind != WriteBatcher::Kind::Delete) {
+        QJsonDocument doc = QJsonDocument::fromJson(body);
+        if (doc.isNull() || !doc.isObject()) {
+            *error = errorResponse("Ungültiger JSON-Body", QHttpServerResponse::StatusCode::BadRequest);
+            return false;
+        }
+        mutation.data = doc.object();
+    }
+
+    // If-Match: "<row_version>" (auch W/"…"); fehlt oder "*" → ohne Versionsprüfung
+    const QByteArray tag = ifMatch.trimmed();
+    if (mutation.kind == WriteBatcher::Kind::Patch && !tag.isEmpty() && tag != "*") {
+        QByteArray value = tag.startsWith("W/") ? tag.mid(2) : tag;
+        if (value.size() >= 2 && value.startsWith('"') && value.endsWith('"'))
+            value = value.mid(1, value.size() - 2);
+        bool ok = false;
+        mutation.expectedVersion = value.toLongLong(&ok);
+        if (!ok || mutation.expectedVersion < 0) {
+            *error = errorResponse("If-Match passt zu keiner Version",
+                                   QHttpServerResponse::StatusCode::PreconditionFailed);
+            return false;
+        }
+    }
+    return true;
+}
+
+QHttpServerResponse Server::productWriteResponse(WriteBatcher::Kind kind, const QJsonObject &result)
+{
+    if (result.contains("error")) {
+        const QString message = result["error"].toString();
+        switch (kind) {
+        case WriteBatcher::Kind::Insert:
+        case WriteBatcher::Kind::Update:
+            return errorResponse(message, QHttpServerResponse::StatusCode::BadRequest);
+        case WriteBatcher::Kind::Patch:
+            if (result["conflict"].toBool()) {
+                // Aktuelle Version mitgeben, damit der Client neu laden kann
+                return withVersionETag(errorResponse(message, QHttpServerResponse::StatusCode::PreconditionFailed),
+                                       result["row_version"].toInteger());
+            }
+            return errorResponse(message, result["notFound"].toBool()
+                                     ? QHttpServerResponse::StatusCode::NotFound
+                                     : QHttpServerResponse::StatusCode::BadRequest);
+        case WriteBatcher::Kind::Delete:
+            break;
+        }
+        return errorResponse(message, QHttpServerResponse::StatusCode::NotFound);
+    }
+
+    productsChanged();
+    // Die eigene Notification dazu muss nichts mehr verwerfen
+    const qint64 productId = result["product_id"].toInteger(-1);
+    if (kind == WriteBatcher::Kind::Delete && productId >= 0)
+        rememberLocalWrite(productId, DeletedVersion);
+    else if (productId >= 0 && result.contains("row_version"))
+        rememberLocalWrite(productId, result["row_version"].toInteger());
+    switch (kind) {
+    case WriteBatcher::Kind::Insert:
+        return jsonResponse(result, QHttpServerResponse::StatusCode::Created);
+    case WriteBatcher::Kind::Update:
+    case WriteBatcher::Kind::Patch:
+        return withVersionETag(jsonResponse(result), result["row_version"].toInteger());
+    case WriteBatcher::Kind::Delete:
+        break;
+    }
     return jsonResponse(result);
 }
 
+void Server::queueProductWrite(WriteBatcher::Mutation mutation, const QByteArray &body,
+                               const QByteArray &ifMatch, QHttpServerResponder &responder)
+{
+    // Antwort erst, wenn der Batch committet ist — der Responder wandert in die Continuation
+    auto pending = std::make_shared<QHttpServerResponder>(std::move(responder));
+    submitProductWrite(std::move(mutation), body, ifMatch).then(this, [pending](const GuardedResult &result) {
+        pending->sendResponse(result.response());
+    });
+}
+
+QFuture<Server::GuardedResult> Server::submitProductWrite(WriteBatcher::Mutation mutation, const QByteArray &body,
+                                                          const QByteArray &ifMatch)
+{
+    QHttpServerResponse error(QHttpServerResponse::StatusCode::BadRequest);
+    if (!parseProductWrite(mutation, body, ifMatch, &error))
+        return QtFuture::makeReadyValueFuture(GuardedResult::from(error));
+
+    const WriteBatcher::Kind kind = mutation.kind;
+    return writeBatcher->submit(mutation).then(this, [this, kind](const QJsonObject &result) {
+        return GuardedResult::from(productWriteResponse(kind, result));
+    });
+}
+
+// ===== ABBRECHBARE LESEZUGRIFFE =====
+
+Server::GuardedResult Server::GuardedResult::from(const QHttpServerResponse &response)
+{
+    GuardedResult r;
+    r.status = int(response.statusCode());
+    r.mimeType = response.mimeType();
+    r.body = response.data();
+    r.headers = response.headers();
+    return r;
+}
+
+QHttpServerResponse Server::GuardedResult::response() const
+{
+    QHttpServerResponse r(mimeType, body, QHttpServerResponse::StatusCode(status));
+    if (!headers.isEmpty())
+        r.setHeaders(headers);
+    return r;
+}
+
+Server::GuardedRead Server::guardedRead(const QByteArray &route, const QUrlQuery &query, Encoding encoding,
+                                        QTcpSocket *socket, std::function<QHttpServerResponse()> handler) const
+{
+    const RequestContext *ctx = RequestContext::current();
+    GuardedRead read;
+    read.requestId = ctx->id();
+    read.route = route;
+    read.session = ctx->session();
+    read.cacheKey = ResponseCache::key(route, query, encoding == Encoding::Cbor ? "cbor" : "json");
+    // Dieselben Parameter ergeben dasselbe SQL und dieselbe Antwort. Wer eben
+    // geschrieben hat, liest evtl. vom Primary statt von einer Replica — nicht teilen.
+    read.key = read.cacheKey;
+    if (db->hasRecentWrite(read.session))
+        read.key += '\n' + read.session.toUtf8();
+    read.socket = socket;
+    read.elapsedAtStart = ctx->elapsedMs();
+    read.waiting.start();
+    read.handler = std::move(handler);
+    return read;
+}
+
+void Server::runGuarded(const QHttpServerRequest &request, QHttpServerResponder &responder,
+                        std::function<QHttpServerResponse()> handler)
+{
+    const GuardedRead read = guardedRead(RequestContext::current()->route(), QUrlQuery(request.url()),
+                                         preferredEncoding(request), tcpServer->socketFor(request),
+                                         std::move(handler));
+    respondWhenDone(dispatchGuarded(read), request, responder);
+}
+
+void Server::respondWhenDone(QFuture<GuardedResult> result, const QHttpServerRequest &request,
+                             QHttpServerResponder &responder)
+{
+    const QByteArray ifNoneMatch = request.headers().value(QHttpHeaders::WellKnownHeader::IfNoneMatch).toByteArray();
+    const QPointer<QTcpSocket> socket = tcpServer->socketFor(request);
+    auto pending = std::make_shared<QHttpServerResponder>(std::move(responder));
+    result.then(this, [this, pending, socket, ifNoneMatch](const GuardedResult &r) {
+        // Client weg: niemand mehr da, der die Antwort liest
+        if (r.disconnected || !socket || socket->state() != QAbstractSocket::ConnectedState)
+            return;
+        pending->sendResponse(withETag(ifNoneMatch, r.response()));
+    });
+}
+
+QFuture<Server::GuardedResult> Server::dispatchGuarded(const GuardedRead &read)
+{
+    const auto running = inFlightReads.find(read.key);
+    if (running == inFlightReads.end())
+        return startGuarded(read);
+
+    // Gleiche Abfrage läuft schon: auf ihr Ergebnis warten, ohne Worker
+    ++coalesceFollowers;
+    return running->result.wait().then(this, [this, read](const GuardedResult &result) {
+        // Client des Leaders hat getrennt und seine Abfrage abgebrochen — selbst lesen
+        if (result.disconnected
+            && (read.background || (read.socket && read.socket->state() == QAbstractSocket::ConnectedState))) {
+            ++coalesceReruns;
+            return dispatchGuarded(read);
+        }
+        return QtFuture::makeReadyValueFuture(result);
+    }).unwrap();
+}
+
+QFuture<Server::GuardedResult> Server::startGuarded(const GuardedRead &read)
+{
+    ++coalesceLeaders;
+    QueryGuard *guard = db->queryGuard();
+    const qint64 elapsedMs = read.elapsedAtStart + read.waiting.elapsed();
+    const quint64 ticket = read.background ? guard->watch(read.route, elapsedMs)
+                                           : guard->watch(read.route, elapsedMs, read.socket);
+    const quint64 id = ++nextReadId;
+
+    const std::function<QHttpServerResponse()> handler = read.handler;
+    const QByteArray requestId = read.requestId;
+    const QByteArray route = read.route;
+    const QString session = read.session;
+    // Ein QFuture trägt nur eine Continuation — Mitläufer warten über SharedResult
+    SharedResult<GuardedResult> shared;
+    QFuture<GuardedResult> result = shared.wait();
+    Database *database = db;
+    QtConcurrent::run(db->pool(), [=]() {
+        RequestContext worker(requestId, route.constData(), session);
+        QueryGuard::Ticket scope(ticket);
+        Database::beginReadTracking();
+        GuardedResult result = GuardedResult::from(handler());
+        result.current = database->readsAreCurrent();
+        return result;
+    }).then(this, [this, key = read.key, guard, ticket, id, shared](GuardedResult result) mutable {
+        // Nur den eigenen Eintrag — nach einer Änderung kann schon ein neuer laufen
+        const auto entry = inFlightReads.constFind(key);
+        if (entry != inFlightReads.cend() && entry->id == id)
+            inFlightReads.erase(entry);
+        result.disconnected = guard->unwatch(ticket) == QueryGuard::Reason::Disconnect;
+        shared.finish(result);
+    });
+    inFlightReads.insert(read.key, InFlightRead{ id, shared });
+    return result;
+}
+
+// ===== RESPONSE-CACHE =====
+
+QByteArray Server::cacheKey(const QHttpServerRequest &request) const
+{
+    return ResponseCache::key(RequestContext::current()->route(), QUrlQuery(request.url()),
+                              preferredEncoding(request) == Encoding::Cbor ? "cbor" : "json");
+}
+
+QHttpServerResponse Server::cached(const QHttpServerRequest &request, const QByteArray &tag,
+                                   std::function<QHttpServerResponse()> handler)
+{
+    const RequestContext *ctx = RequestContext::current();
+    const QByteArray route = ctx->route();
+    // Wer eben geschrieben hat, liest am Cache vorbei (read-your-writes)
+    if (!responseCache->isCached(route) || db->hasRecentWrite(ctx->session()))
+        return withETag(request, handler());
+
+    const QByteArray key = cacheKey(request);
+    const ResponseCache::Hit hit = responseCache->lookup(route, key);
+    if (hit.state == ResponseCache::State::Miss) {
+        Database::beginReadTracking();
+        QHttpServerResponse response = handler();
+        if (db->readsAreCurrent())
+            responseCache->store(route, key, tag, hit.epoch, response);
+        return withETag(request, std::move(response));
+    }
+    if (hit.refresh)
+        revalidate(guardedRead(route, QUrlQuery(request.url()), preferredEncoding(request), nullptr,
+                               std::move(handler)), tag, hit.epoch);
+    return withETag(request, hit.response());
+}
+
+void Server::runCached(const QHttpServerRequest &request, QHttpServerResponder &responder,
+                       const QByteArray &tag, std::function<QHttpServerResponse()> handler)
+{
+    const GuardedRead read = guardedRead(RequestContext::current()->route(), QUrlQuery(request.url()),
+                                         preferredEncoding(request), tcpServer->socketFor(request),
+                                         std::move(handler));
+    respondWhenDone(cachedRead(read, tag), request, responder);
+}
+
+QFuture<Server::GuardedResult> Server::cachedRead(const GuardedRead &read, const QByteArray &tag)
+{
+    // Wer eben geschrieben hat, liest am Cache vorbei (read-your-writes)
+    if (!responseCache->isCached(read.route) || db->hasRecentWrite(read.session))
+        return dispatchGuarded(read);
+
+    const ResponseCache::Hit hit = responseCache->lookup(read.route, read.cacheKey);
+    if (hit.state != ResponseCache::State::Miss) {
+        if (hit.refresh)
+            revalidate(read, tag, hit.epoch);
+        return QtFuture::makeReadyValueFuture(GuardedResult::from(hit.response()));
+    }
+
+    return dispatchGuarded(read).then(this, [this, route = read.route, key = read.cacheKey, tag,
+                                             epoch = hit.epoch](const GuardedResult &result) {
+        storeRead(route, key, tag, epoch, result);
+        return result;
+    });
+}
+
+void Server::revalidate(GuardedRead read, const QByteArray &tag, quint64 epoch)
+{
+    // Der Request ist längst beantwortet (alte Antwort) — Ergebnis nur für den Cache.
+    // Trennt der Client, läuft die Erneuerung trotzdem weiter
+    read.socket = nullptr;
+    read.background = true;
+    dispatchGuarded(read).then(this, [this, route = read.route, key = read.cacheKey, tag,
+                                      epoch](const GuardedResult &result) {
+        storeRead(route, key, tag, epoch, result);
+    });
+}
+
+void Server::storeRead(const QByteArray &route, const QByteArray &key, const QByteArray &tag, quint64 epoch,
+                       const GuardedResult &result)
+{
+    // Replica liegt hinter der letzten Änderung: nicht für alle ablegen,
+    // eine laufende Erneuerung endet (alte Antwort bleibt, nächster Versuch später)
+    if (!result.current) {
+        responseCache->abandon(key);
+        return;
+    }
+    // Abgebrochen (504) oder Fehler: store() übernimmt nur 200
+    responseCache->store(route, key, tag, epoch, result.response());
+}
+
+QHttpServerResponse::StatusCode Server::readErrorStatus(QHttpServerResponse::StatusCode fallback)
+{
+    return QueryGuard::lastReason() != QueryGuard::Reason::None
+               ? QHttpServerResponse::StatusCode::GatewayTimeout
+               : fallback;
+}
+
 // ===== HILFSFUNKTIONEN =====
 
 QHttpServerResponse Server::jsonResponse(const QJsonObject &data,
@@ -391,6 +1629,66 @@ QHttpServerResponse Server::jsonResponse(const QJsonObject &data,
                                status);
 }
 
+QHttpServerResponse Server::cborResponse(const QByteArray &data,
+                                         QHttpServerResponse::StatusCode status)
+{
+    return QHttpServerResponse("application/cbor", data, status);
+}
+
+Server::Encoding Server::preferredEncoding(const QHttpServerRequest &request)
+{
+    // Nur explizit angefordertes CBOR, alles andere (auch */*) bleibt JSON
+    const QByteArray accept = request.headers().value(QHttpHeaders::WellKnownHeader::Accept).toByteArray();
+    for (const QByteArray &range : accept.split(',')) {
+        const QList<QByteArray> parts = range.split(';');
+        if (parts.first().trimmed().toLower() != "application/cbor")
+            continue;
+        double q = 1.0;
+        for (qsizetype i = 1; i < parts.size(); ++i) {
+            const QByteArray param = parts.at(i).trimmed();
+            if (param.startsWith("q="))
+                q = param.mid(2).toDouble();
+        }
+        return q > 0 ? Encoding::Cbor : Encoding::Json;
+    }
+    return Encoding::Json;
+}
+
+QHttpServerResponse Server::withETag(const QHttpServerRequest &request, QHttpServerResponse &&response)
+{
+    return withETag(request.headers().value(QHttpHeaders::WellKnownHeader::IfNoneMatch).toByteArray(),
+                    std::move(response));
+}
+
+QHttpServerResponse Server::withETag(const QByteArray &ifNoneMatch, QHttpServerResponse &&response)
+{
+    if (response.statusCode() != QHttpServerResponse::StatusCode::Ok)
+        return std::move(response);
+
+    // ETag aus dem Body: unveränderte Daten kosten nur einen 304 ohne Body.
+    // Cache-Treffer bringen es schon mit
+    QByteArray etag = response.headers().value(QHttpHeaders::WellKnownHeader::ETag).toByteArray();
+    if (etag.isEmpty())
+        etag = ResponseCache::etag(response.data());
+
+    if (!ifNoneMatch.isEmpty() && ifNoneMatch.contains(etag)) {
+        QHttpServerResponse notModified(QHttpServerResponse::StatusCode::NotModified);
+        QHttpHeaders headers;
+        headers.append(QHttpHeaders::WellKnownHeader::ETag, etag);
+        headers.append(QHttpHeaders::WellKnownHeader::Vary, "Accept");
+        notModified.setHeaders(std::move(headers));
+        return notModified;
+    }
+
+    QHttpHeaders headers = response.headers();
+    headers.replaceOrAppend(QHttpHeaders::WellKnownHeader::ETag, etag);
+    headers.replaceOrAppend(QHttpHeaders::WellKnownHeader::CacheControl, "no-cache");
+    // Alle Routen mit ETag liefern JSON oder CBOR je nach Accept
+    headers.replaceOrAppend(QHttpHeaders::WellKnownHeader::Vary, "Accept");
+    response.setHeaders(std::move(headers));
+    return std::move(response);
+}
+
 QHttpServerResponse Server::errorResponse(const QString &message,
                                           QHttpServerResponse::StatusCode status)
 {
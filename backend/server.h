@@ -2,13 +2,34 @@
 #define SERVER_H
 
 #include <QObject>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QHash>
+#include <QPointer>
+#include <QQueue>
+#include <QTcpSocket>
 #include <QHttpServer>
 #include <QHttpServerResponse>
+#include <QHttpHeaders>
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QTimer>
+#include <QUrlQuery>
 #include "database.h"
 #include "authmanager.h"
+#include "connectiontracker.h"
+#include "eventstream.h"
+#include "notifylistener.h"
+#include "writebatcher.h"
+#include "healthmonitor.h"
+#include "sharedresult.h"
+#include <functional>
+#include <memory>
+
+class StaticAssets;
+class ResponseCache;
+class TrafficCapture;
+struct ProductSnapshot;
 
 class Server : public QObject
 {
@@ -23,38 +44,220 @@ public:
 
 private:
     QHttpServer httpServer;
-    QTcpServer *tcpServer = nullptr;
+    ConnectionTracker *tcpServer = nullptr;
     Database *db;
     AuthManager *authManager;
 
+    // Group Commit für Produkt-Schreibzugriffe
+    WriteBatcher *writeBatcher = nullptr;
+
+    // DB-Prüfung im Hintergrund, Liveness/Readiness aus dem Speicher
+    HealthMonitor *health = nullptr;
+
+    // Frontend-Dateien aus STATIC_DIR (ohne NGINX)
+    std::unique_ptr<StaticAssets> staticAssets;
+
+    // Microcache für lesende Routen (RESPONSE_CACHE_MB)
+    std::unique_ptr<ResponseCache> responseCache;
+
+    // Mitschnitt aller Requests (CAPTURE_FILE), sonst nullptr
+    TrafficCapture *capture = nullptr;
+
+    // Änderungsstrom product (LISTEN/NOTIFY → SSE) und Cache-Kohärenz
+    // zwischen Instanzen: product_changes (id + version) und schema_changes
+    NotifyListener *changeListener = nullptr;
+    EventStream productEvents;
+    QTimer coherenceTimer;                  // mehrere Notifications → einmal verwerfen
+    QHash<qint64, qint64> localVersions;    // eigene Schreibzugriffe: product_id → row_version
+    QQueue<qint64> localVersionOrder;       // FIFO dazu, die ältesten fallen heraus
+    quint64 coherenceNotifications = 0;
+    quint64 coherenceSkipped = 0;
+    quint64 coherenceResyncs = 0;
+    quint64 coherenceSchemaChanges = 0;
+    void productNotified(const QByteArray &payload);
+    // Eigenen Schreibzugriff merken (Löschen: Version = DeletedVersion)
+    void rememberLocalWrite(qint64 productId, qint64 version);
+    // Alles verwerfen: nach Reconnect (Notifications verpasst) oder Schema-Änderung
+    void resyncCaches();
+
+    // Schnappschuss für /api/products/stats — bei Änderungen an product
+    // (eigene Schreibzugriffe, NOTIFY) verworfen und beim nächsten Abruf neu geladen
+    std::shared_ptr<const ProductSnapshot> statsSnapshot;
+    quint64 statsRebuilds = 0;
+    quint64 statsGeneration = 0;         // zählt Invalidierungen
+    void invalidateStatsSnapshot();
+
+    // Aufbau im DB-Pool; gleichzeitige Abrufe teilen sich einen laufenden
+    // Aufbau, solange seitdem nichts verworfen wurde
+    struct StatsBuild {
+        std::shared_ptr<const ProductSnapshot> snapshot;
+        QString error;
+    };
+    SharedResult<StatsBuild> statsBuild;
+    bool statsBuilding = false;
+    quint64 statsBuildGeneration = 0;
+    QFuture<StatsBuild> productSnapshot();
+
+    // product hat sich geändert (eigener Schreibzugriff oder NOTIFY):
+    // Schnappschuss, Response-Cache und laufende Lesezugriffe verwerfen
+    void productsChanged();
+
+    // Warmstart: Katalog-Datei (CATALOG_SNAPSHOT_FILE) beim Start mappen,
+    // daraus sofort den Schnappschuss bauen, dann per row_version nachziehen;
+    // alle CATALOG_SNAPSHOT_SECS neu schreiben, wenn sich etwas geändert hat
+    QString catalogPath;
+    QTimer catalogTimer;
+    bool catalogDirty = true;
+    bool catalogWriting = false;
+    bool catalogCatchingUp = false;     // Warmstart-Stand gilt, bis das Nachziehen fertig ist
+    QJsonObject catalogStats;
+    void setupCatalogSnapshot();
+    void writeCatalogSnapshot();
+
+    // Antwortformat per Accept-Header: JSON (Standard) oder CBOR
+    enum class Encoding { Json, Cbor };
+    static Encoding preferredEncoding(const QHttpServerRequest &request);
+
     // Route Handlers
     void setupRoutes();
     QHttpServerResponse handleLogin(const QHttpServerRequest &request);
-    QHttpServerResponse handleGetGreeting(const QHttpServerRequest &request);
+    QHttpServerResponse handleGetGreeting(const QUrlQuery &query);
     QHttpServerResponse handleGetStyles();
-    QHttpServerResponse handleGetTables();
-    QHttpServerResponse handleGetTableData(const QHttpServerRequest &request);
+    QHttpServerResponse handleGetTables(Encoding encoding = Encoding::Json);
+    QHttpServerResponse handleGetTableData(const QUrlQuery &query, Encoding encoding = Encoding::Json);
     QHttpServerResponse handleShutdown(const QHttpServerRequest &request);
     QHttpServerResponse handleHealth();
+    QHttpServerResponse handleHealthLive();
+    QHttpServerResponse handleHealthReady();
+    QHttpServerResponse handleMetrics();
+    QHttpServerResponse handleDebugAlloc(const QUrlQuery &query);
+    QHttpServerResponse handleGetLogging();
+    QHttpServerResponse handleSetLogging(const QHttpServerRequest &request);
 
     // Product CRUD Handlers
-    QHttpServerResponse handleGetProducts(const QHttpServerRequest &request);
-    QHttpServerResponse handleCreateProduct(const QHttpServerRequest &request);
-    QHttpServerResponse handleUpdateProduct(int productId, const QHttpServerRequest &request);
-    QHttpServerResponse handleDeleteProduct(int productId, const QHttpServerRequest &request);
+    QHttpServerResponse handleGetProducts(const QUrlQuery &query, Encoding encoding = Encoding::Json);
+    void handleProductStats(const QHttpServerRequest &request, QHttpServerResponder &responder);
+    QHttpServerResponse handleGetProduct(int productId, const QHttpServerRequest &request);
+
+    // Produkt-Schreibzugriffe: Body/If-Match → Mutation (false + fertige Fehlerantwort)
+    bool parseProductWrite(WriteBatcher::Mutation &mutation, const QByteArray &body,
+                           const QByteArray &ifMatch, QHttpServerResponse *error);
+    // Ergebnis von insertProduct()/updateProduct()/… → HTTP-Antwort
+    QHttpServerResponse productWriteResponse(WriteBatcher::Kind kind, const QJsonObject &result);
+    // Über den WriteBatcher, Antwort nach dem Commit
+    void queueProductWrite(WriteBatcher::Mutation mutation, const QByteArray &body,
+                           const QByteArray &ifMatch, QHttpServerResponder &responder);
+    void handleProductEvents(const QHttpServerRequest &request, QHttpServerResponder &responder);
+    // Ganze Tabelle per COPY TO STDOUT als CSV/NDJSON streamen
+    void handleTableExport(const QHttpServerRequest &request, QHttpServerResponder &responder);
+    // Datei aus STATIC_DIR oder 404 (Catch-All)
+    void handleStaticOrNotFound(const QHttpServerRequest &request, QHttpServerResponder &responder);
+
+    // QHttpServerResponse ist nicht kopierbar — über Futures gehen Status, Typ, Header und Body
+    struct GuardedResult {
+        int status = 200;
+        QByteArray mimeType;
+        QByteArray body;
+        QHttpHeaders headers;
+        bool disconnected = false;    // Client weg, Abfrage abgebrochen
+        bool current = true;          // vom Primary bzw. aktueller Replica gelesen (Response-Cache)
+
+        static GuardedResult from(const QHttpServerResponse &response);
+        QHttpServerResponse response() const;
+    };
+
+    // Ein Lesezugriff, losgelöst vom Route-Handler (auch für Wiederholungen
+    // und Batch-Sub-Requests)
+    struct GuardedRead {
+        QByteArray requestId;
+        QByteArray route;             // "GET /api/table" — Budget, Cache-Policy
+        QString session;
+        QByteArray cacheKey;          // Route + Query + Format
+        QByteArray key;               // Coalescing (cacheKey, ggf. + Session)
+        QPointer<QTcpSocket> socket;
+        bool background = false;      // ohne Client (Cache-Erneuerung): nur das Budget
+        qint64 elapsedAtStart = 0;
+        QElapsedTimer waiting;
+        std::function<QHttpServerResponse()> handler;
+    };
+    GuardedRead guardedRead(const QByteArray &route, const QUrlQuery &query, Encoding encoding,
+                            QTcpSocket *socket, std::function<QHttpServerResponse()> handler) const;
+
+    // Lesender Handler im DB-Worker-Pool, beobachtet vom QueryGuard: trennt
+    // der Client oder läuft das Budget der Route ab, wird die laufende
+    // Abfrage abgebrochen. Antwort mit ETag wie bei den synchronen Routen.
+    // Gleiche Lesezugriffe (Route, Query, Format), die gleichzeitig kommen,
+    // teilen sich eine Abfrage und ihre fertige Antwort (Coalescing).
+    void runGuarded(const QHttpServerRequest &request, QHttpServerResponder &responder,
+                    std::function<QHttpServerResponse()> handler);
+    // Ergebnis über den Responder schicken, sofern der Client noch da ist
+    void respondWhenDone(QFuture<GuardedResult> result, const QHttpServerRequest &request,
+                         QHttpServerResponder &responder);
+
+    struct InFlightRead {
+        quint64 id = 0;
+        SharedResult<GuardedResult> result;   // Leader und alle Mitläufer
+    };
+    QHash<QByteArray, InFlightRead> inFlightReads;
+    quint64 nextReadId = 0;
+    quint64 coalesceLeaders = 0;
+    quint64 coalesceFollowers = 0;
+    quint64 coalesceReruns = 0;
+    // An eine laufende gleiche Abfrage anhängen oder selbst starten
+    QFuture<GuardedResult> dispatchGuarded(const GuardedRead &read);
+    QFuture<GuardedResult> startGuarded(const GuardedRead &read);
+
+    // Antwort aus dem Response-Cache, sonst handler() (Ergebnis wird übernommen);
+    // veraltete Einträge erneuert ein Worker im Hintergrund. tag = Invalidierung
+    QHttpServerResponse cached(const QHttpServerRequest &request, const QByteArray &tag,
+                               std::function<QHttpServerResponse()> handler);
+    // Dasselbe für runGuarded()-Routen: Miss läuft abbrechbar im Worker-Pool
+    void runCached(const QHttpServerRequest &request, QHttpServerResponder &responder,
+                   const QByteArray &tag, std::function<QHttpServerResponse()> handler);
+    QFuture<GuardedResult> cachedRead(const GuardedRead &read, const QByteArray &tag);
+    // Veralteten Eintrag über den QueryGuard-Weg neu laden (Ticket, Budget, Coalescing)
+    void revalidate(GuardedRead read, const QByteArray &tag, quint64 epoch);
+    // Ergebnis übernehmen — nicht, wenn es von einer zurückliegenden Replica kam
+    void storeRead(const QByteArray &route, const QByteArray &key, const QByteArray &tag, quint64 epoch,
+                   const GuardedResult &result);
+    QByteArray cacheKey(const QHttpServerRequest &request) const;
+    // Fehlerstatus eines Lesezugriffs: 504 bei Abbruch/Zeitlimit, sonst fallback
+    static QHttpServerResponse::StatusCode readErrorStatus(QHttpServerResponse::StatusCode fallback);
+
+    // Schreibzugriff über den WriteBatcher, Ergebnis nach dem Commit
+    QFuture<GuardedResult> submitProductWrite(WriteBatcher::Mutation mutation, const QByteArray &body,
+                                              const QByteArray &ifMatch);
+
+    // Batch: mehrere Sub-Requests mit einer Auth-Prüfung in einem Roundtrip.
+    // Sub-Requests laufen über dieselben Wege wie die Einzel-Routen
+    // (QueryGuard, Response-Cache, Coalescing, WriteBatcher), die Antwort
+    // kommt, wenn alle fertig sind — der Event-Loop wartet nie.
+    void handleBatch(const QHttpServerRequest &request, QHttpServerResponder &responder);
+    QFuture<GuardedResult> dispatchSubRequest(const GuardedRead &base, const QString &method,
+                                              const QString &path, const QUrlQuery &query,
+                                              const QByteArray &body, const QByteArray &ifMatch);
 
     // Username aus Bearer-Token extrahieren
     QString getUsernameFromRequest(const QHttpServerRequest &request) const;
 
     // Auth-Prüfung — gibt leeren String zurück wenn gültig, sonst Fehlermeldung
     QString checkAuth(const QHttpServerRequest &request) const;
+    // Interne Routen (/metrics, /debug/alloc): hinter NGINX offen, das sie nicht
+    // weiterleitet. Ohne NGINX (STATIC_DIR) nur vom Loopback oder mit Token
+    QString checkInternal(const QHttpServerRequest &request) const;
 
     // Hilfsfunktionen
     QHttpServerResponse jsonResponse(const QJsonObject &data,
                                      QHttpServerResponse::StatusCode status = QHttpServerResponse::StatusCode::Ok);
+    QHttpServerResponse cborResponse(const QByteArray &data,
+                                     QHttpServerResponse::StatusCode status = QHttpServerResponse::StatusCode::Ok);
     QHttpServerResponse errorResponse(const QString &message,
                                       QHttpServerResponse::StatusCode status = QHttpServerResponse::StatusCode::InternalServerError);
     QHttpServerResponse unauthorizedResponse(const QString &message = "Nicht autorisiert");
+
+    // ETag setzen bzw. 304, wenn If-None-Match passt
+    QHttpServerResponse withETag(const QHttpServerRequest &request, QHttpServerResponse &&response);
+    QHttpServerResponse withETag(const QByteArray &ifNoneMatch, QHttpServerResponse &&response);
 };
 
 #endif // SERVER_H
@@ -0,0 +1,42 @@
+#ifndef SHAREDRESULT_H
+#define SHAREDRESULT_H
+
+#include <QFuture>
+#include <QList>
+#include <QPromise>
+#include <memory>
+#include <utility>
+
+// Ergebnis einer laufenden Arbeit für mehrere Abnehmer
+//
+// Ein QFuture trägt nur eine Continuation — eine zweite ersetzt die erste.
+// Wer auf dieselbe Arbeit wartet, bekommt deshalb per wait() ein eigenes
+// Future; finish() beantwortet alle auf einmal. Kopien teilen sich die
+// Wartenden, nur im Thread des Besitzers (Event-Loop) benutzen.
+template <typename T>
+class SharedResult
+{
+public:
+    QFuture<T> wait()
+    {
+        auto promise = std::make_shared<QPromise<T>>();
+        promise->start();
+        waiters->append(promise);
+        return promise->future();
+    }
+
+    void finish(const T &value)
+    {
+        const QList<std::shared_ptr<QPromise<T>>> done = std::exchange(*waiters, {});
+        for (const auto &promise : done) {
+            promise->addResult(value);
+            promise->finish();
+        }
+    }
+
+private:
+    std::shared_ptr<QList<std::shared_ptr<QPromise<T>>>> waiters =
+        std::make_shared<QList<std::shared_ptr<QPromise<T>>>>();
+};
+
+#endif // SHAREDRESULT_H
@@ -0,0 +1,238 @@
+#include "staticassets.h"
+#include "logger.h"
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHttpHeaders>
+#include <QRegularExpression>
+#include <QUrlQuery>
+
+// Größere Dateien gehen über einen QIODevice gestückelt raus (im Tempo des
+// Sockets), kleinere in einem Stück
+static const qint64 StreamThresholdBytes = 256 * 1024;
+
+// Nur diese Typen werden ausgeliefert — Quelltexte im selben Verzeichnis nicht
+static const struct { const char *suffix; const char *mimeType; } MimeTypes[] = {
+    { "html", "text/html; charset=utf-8" },
+    { "js",   "text/javascript; charset=utf-8" },
+    { "mjs",  "text/javascript; charset=utf-8" },
+    { "wasm", "application/wasm" },
+    { "css",  "text/css; charset=utf-8" },
+    { "json", "application/json" },
+    { "svg",  "image/svg+xml" },
+    { "png",  "image/png" },
+    { "ico",  "image/x-icon" },
+    { "woff2", "font/woff2" },
+};
+
+static QByteArray mimeTypeFor(const QString &suffix)
+{
+    for (const auto &m : MimeTypes) {
+        if (suffix == QLatin1StringView(m.suffix))
+            return m.mimeType;
+    }
+    return {};
+}
+
+StaticAssets::StaticAssets(const QString &root, const QString &indexFile)
+    : index("/" + indexFile)
+{
+    if (root.isEmpty())
+        return;
+    const QDir dir(root);
+    if (!dir.exists()) {
+        qCWarning(lcHttp) << "STATIC_DIR existiert nicht:" << root;
+        return;
+    }
+
+    // frontend.a1b2c3d4.js, app.0f3e9c2b7d.wasm, …
+    static const QRegularExpression hashedName("\\.[0-9a-f]{8,}\\.[a-z0-9]+$");
+
+    qint64 totalBytes = 0;
+    QDirIterator it(dir.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QFileInfo info(it.nextFileInfo());
+        const QByteArray mimeType = mimeTypeFor(info.suffix().toLower());
+        if (mimeType.isEmpty())
+            continue;
+
+        Asset asset;
+        asset.mimeType = mimeType;
+        if (!mapFile(info.absoluteFilePath(), &asset.identity.data))
+            continue;
+        mapFile(info.absoluteFilePath() + ".br", &asset.br.data);
+        mapFile(info.absoluteFilePath() + ".gz", &asset.gzip.data);
+
+        const QByteArray hash = QCryptographicHash::hash(asset.identity.data, QCryptographicHash::Sha256).toHex();
+        asset.version = hash.left(16);
+        asset.hashedName = hashedName.match(info.fileName()).hasMatch();
+        // Starke ETags, je Kodierung verschieden
+        asset.identity.etag = '"' + asset.version + '"';
+        asset.br.etag = '"' + asset.version + "-br\"";
+        asset.gzip.etag = '"' + asset.version + "-gz\"";
+
+        totalBytes += asset.identity.data.size();
+        assets.insert("/" + dir.relativeFilePath(info.absoluteFilePath()), asset);
+    }
+
+    // Erst jetzt: die Verweise brauchen die Versionen aller Dateien
+    for (auto a = assets.begin(); a != assets.end(); ++a) {
+        if (a->mimeType.startsWith("text/html"))
+            rewriteHtml(*a);
+    }
+
+    qCInfo(lcHttp) << "Statische Dateien aus" << dir.absolutePath() << ":" << assets.size()
+                   << "Dateien," << totalBytes / 1024 << "KB";
+}
+
+StaticAssets::~StaticAssets() = default;
+
+bool StaticAssets::mapFile(const QString &path, QByteArray *data)
+{
+    auto file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly))
+        return false;
+    const qint64 size = file->size();
+    if (size == 0) {
+        *data = QByteArray("");
+        return true;
+    }
+    uchar *mapped = file->map(0, size);
+    if (!mapped) {
+        qCWarning(lcHttp) << "Datei konnte nicht gemappt werden:" << path << file->errorString();
+        return false;
+    }
+    // Kein Kopieren: das QByteArray zeigt ins Mapping, solange die Datei offen ist
+    *data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), size);
+    files.push_back(std::move(file));
+    return true;
+}
+
+void StaticAssets::rewriteHtml(Asset &asset)
+{
+    // src="qtloader.js" → src="qtloader.js?v=<hash>": die Skripte dürfen
+    // dann für immer im Cache bleiben, nur das HTML wird revalidiert.
+    // Vorkomprimierte HTML-Varianten passen danach nicht mehr.
+    static const QRegularExpression ref("(src|href)=\"([^\"?#:]+)\"");
+    const QString html = QString::fromUtf8(asset.identity.data);
+    QString out;
+    qsizetype last = 0;
+    auto matches = ref.globalMatch(html);
+    while (matches.hasNext()) {
+        const QRegularExpressionMatch m = matches.next();
+        const auto target = assets.constFind("/" + QDir::cleanPath(m.captured(2)));
+        if (target == assets.constEnd())
+            continue;
+        out += QStringView(html).mid(last, m.capturedEnd(2) - last);
+        out += "?v=" + QString::fromLatin1(target->version);
+        last = m.capturedEnd(2);
+    }
+    if (last == 0)
+        return;
+    out += QStringView(html).mid(last);
+
+    asset.identity.data = out.toUtf8();
+    asset.br = Variant();
+    asset.gzip = Variant();
+}
+
+bool StaticAssets::serve(const QHttpServerRequest &request, QHttpServerResponder &responder)
+{
+    QString path = request.url().path();
+    if (path == "/" || path.isEmpty())
+        path = index;
+    const auto it = assets.constFind(path);
+    if (it == assets.constEnd())
+        return false;
+    const Asset &asset = *it;
+
+    // Accept-Encoding: br vor gzip, q=0 schließt aus
+    bool acceptBr = false, acceptGzip = false;
+    const QByteArray acceptEncoding = request.headers().value(QHttpHeaders::WellKnownHeader::AcceptEncoding).toByteArray();
+    for (const QByteArray &part : acceptEncoding.split(',')) {
+        const QList<QByteArray> params = part.split(';');
+        const QByteArray coding = params.first().trimmed().toLower();
+        const QByteArray q = params.size() > 1 ? params.at(1).trimmed() : QByteArray();
+        if (q.startsWith("q=") && q.mid(2).toDouble() == 0.0)
+            continue;
+        if (coding == "br")
+            acceptBr = true;
+        else if (coding == "gzip")
+            acceptGzip = true;
+    }
+
+    const Variant *variant = &asset.identity;
+    QByteArray contentEncoding;
+    if (acceptBr && !asset.br.data.isNull()) {
+        variant = &asset.br;
+        contentEncoding = "br";
+        ++servedBr;
+    } else if (acceptGzip && !asset.gzip.data.isNull()) {
+        variant = &asset.gzip;
+        contentEncoding = "gzip";
+        ++servedGzip;
+    }
+    ++served;
+
+    QHttpHeaders headers;
+    // Wie location / in nginx.conf: SharedArrayBuffer für WASM-Threads
+    headers.append("Cross-Origin-Opener-Policy", "same-origin");
+    headers.append("Cross-Origin-Embedder-Policy", "require-corp");
+    headers.append("X-Content-Type-Options", "nosniff");
+    headers.append(QHttpHeaders::WellKnownHeader::ETag, variant->etag);
+    if (!asset.br.data.isNull() || !asset.gzip.data.isNull())
+        headers.append(QHttpHeaders::WellKnownHeader::Vary, "Accept-Encoding");
+
+    const bool versioned = asset.hashedName
+                           || QUrlQuery(request.url()).queryItemValue("v").toLatin1() == asset.version;
+    headers.append(QHttpHeaders::WellKnownHeader::CacheControl,
+                   versioned ? "public, max-age=31536000, immutable" : "no-cache");
+
+    const QByteArray ifNoneMatch = request.headers().value(QHttpHeaders::WellKnownHeader::IfNoneMatch).toByteArray();
+    if (!ifNoneMatch.isEmpty() && ifNoneMatch.contains(variant->etag)) {
+        ++notModified;
+        responder.write(headers, QHttpServerResponder::StatusCode::NotModified);
+        return true;
+    }
+
+    headers.append(QHttpHeaders::WellKnownHeader::ContentType, asset.mimeType);
+    if (!contentEncoding.isEmpty())
+        headers.append(QHttpHeaders::WellKnownHeader::ContentEncoding, contentEncoding);
+
+    if (variant->data.size() < StreamThresholdBytes) {
+        responder.write(variant->data, headers);
+        return true;
+    }
+
+    // QBuffer über dem Mapping: der Responder liest stückweise nach, sobald
+    // der Socket Platz hat — kein Kopieren der ganzen Datei in den Socket-Puffer
+    auto *buffer = new QBuffer;
+    buffer->setData(variant->data);
+    buffer->open(QIODevice::ReadOnly);
+    responder.write(buffer, headers);
+    return true;
+}
+
+QJsonObject StaticAssets::stats() const
+{
+    qint64 bytes = 0;
+    int precompressed = 0;
+    for (const Asset &a : assets) {
+        bytes += a.identity.data.size();
+        if (!a.br.data.isNull() || !a.gzip.data.isNull())
+            ++precompressed;
+    }
+
+    QJsonObject s;
+    s["files"]         = int(assets.size());
+    s["bytes"]         = bytes;
+    s["precompressed"] = precompressed;
+    s["served"]        = qint64(served);
+    s["servedBr"]      = qint64(servedBr);
+    s["servedGzip"]    = qint64(servedGzip);
+    s["notModified"]   = qint64(notModified);
+    return s;
+}
@@ -0,0 +1,66 @@
+#ifndef STATICASSETS_H
+#define STATICASSETS_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QHttpServerRequest>
+#include <QHttpServerResponder>
+#include <QJsonObject>
+#include <QString>
+#include <memory>
+#include <vector>
+
+class QFile;
+
+// Statische Dateien des WASM-Frontends (STATIC_DIR), ohne NGINX davor
+//
+// Beim Start werden alle Dateien mit bekanntem Typ gemappt (QFile::map)
+// und gehasht; vorkomprimierte Varianten (<datei>.br, <datei>.gz) hängen
+// an ihrer Ursprungsdatei und werden per Accept-Encoding gewählt. Die
+// Antwort liest direkt aus dem Mapping, große Dateien gehen gestückelt im
+// Tempo des Sockets raus. ETag = Inhalts-Hash; Dateien mit Hash im Namen
+// oder mit passendem ?v=<hash> sind "immutable" — im HTML werden die
+// Verweise auf andere Assets beim Laden um ?v=<hash> ergänzt.
+class StaticAssets
+{
+public:
+    // Leeres root → deaktiviert
+    explicit StaticAssets(const QString &root, const QString &indexFile = "frontend.html");
+    ~StaticAssets();
+
+    bool isEnabled() const { return !assets.isEmpty(); }
+
+    // false: keine solche Datei (Aufrufer antwortet mit 404)
+    bool serve(const QHttpServerRequest &request, QHttpServerResponder &responder);
+
+    // Dateien, Größen, ausgelieferte Varianten (für /metrics)
+    QJsonObject stats() const;
+
+private:
+    struct Variant {
+        QByteArray data;      // zeigt ins Mapping (oder umgeschriebenes HTML)
+        QByteArray etag;
+    };
+    struct Asset {
+        QByteArray mimeType;
+        QByteArray version;   // Kurz-Hash für ?v=
+        bool hashedName = false;
+        Variant identity;
+        Variant br;
+        Variant gzip;
+    };
+
+    bool mapFile(const QString &path, QByteArray *data);
+    void rewriteHtml(Asset &asset);
+
+    QString index;
+    QHash<QString, Asset> assets;             // "/frontend.wasm" → Asset
+    std::vector<std::unique_ptr<QFile>> files; // halten die Mappings
+
+    quint64 served = 0;
+    quint64 servedBr = 0;
+    quint64 servedGzip = 0;
+    quint64 notModified = 0;
+};
+
+#endif // STATICASSETS_H
@@ -0,0 +1,318 @@
+#include "tableexport.h"
+#include "logger.h"
+#include <QHttpHeaders>
+#include <QHttpServerResponse>
+#include <libpq-fe.h>
+
+// COPY-Zeilen werden zu Chunks dieser Größe gesammelt
+static const int ChunkBytes = 64 * 1024;
+// Ab so vielen ungesendeten Bytes im Client-Socket wird pausiert …
+static const qint64 HighWaterBytes = 1024 * 1024;
+// … und unterhalb davon weitergelesen
+static const qint64 LowWaterBytes = 256 * 1024;
+
+// Zähler (nur Haupt-Thread)
+static int activeExports = 0;
+static quint64 startedExports = 0;
+static quint64 completedExports = 0;
+static quint64 failedExports = 0;
+static quint64 canceledExports = 0;
+static quint64 exportedBytes = 0;
+
+TableExport::TableExport(const QString &connInfo, const QString &table, Format format,
+                         QHttpServerResponder &&responder, QTcpSocket *socket, QObject *parent)
+    : QObject(parent), table(table), format(format), responder(std::move(responder)), socket(socket)
+{
+    timer.start();
+    ++activeExports;
+    ++startedExports;
+
+    if (!socket || socket->state() != QAbstractSocket::ConnectedState) {
+        cancel();
+        return;
+    }
+    connect(socket, &QTcpSocket::bytesWritten, this, [this]() {
+        if (paused && this->socket && this->socket->bytesToWrite() <= LowWaterBytes) {
+            paused = false;
+            if (notifier)
+                notifier->setEnabled(true);
+            // libpq kann noch Zeilen gepuffert haben, ohne dass der Socket feuert
+            pump();
+        }
+    });
+    connect(socket, &QTcpSocket::disconnected, this, &TableExport::cancel);
+
+    // Verbindungsaufbau ohne Blockieren — danach wie nach PGRES_POLLING_WRITING
+    conn = PQconnectStart(connInfo.toUtf8().constData());
+    if (!conn || PQstatus(conn) == CONNECTION_BAD) {
+        fail("Export-Verbindung fehlgeschlagen: " + QString::fromUtf8(PQerrorMessage(conn)).trimmed());
+        return;
+    }
+    watch(QSocketNotifier::Write);
+}
+
+TableExport::~TableExport()
+{
+    if (conn)
+        PQfinish(conn);
+}
+
+void TableExport::watch(QSocketNotifier::Type type)
+{
+    // Der Socket kann sich während PQconnectPoll ändern — Notifier neu anlegen
+    if (notifier) {
+        notifier->setEnabled(false);
+        notifier->deleteLater();
+    }
+    notifier = new QSocketNotifier(PQsocket(conn), type, this);
+    connect(notifier, &QSocketNotifier::activated, this, &TableExport::onSocket);
+}
+
+void TableExport::onSocket()
+{
+    switch (state) {
+    case State::Connecting:
+        poll();
+        break;
+    case State::Querying:
+        // Abfrage noch nicht ganz verschickt → weiter senden, sonst Ergebnis lesen
+        if (notifier->type() == QSocketNotifier::Write) {
+            const int pending = PQflush(conn);
+            if (pending < 0)
+                fail("Export-Abfrage nicht gesendet: " + QString::fromUtf8(PQerrorMessage(conn)).trimmed());
+            else if (pending == 0)
+                watch(QSocketNotifier::Read);
+            return;
+        }
+        readResult();
+        break;
+    case State::Copying:
+        pump();
+        break;
+    case State::Done:
+        break;
+    }
+}
+
+void TableExport::poll()
+{
+    switch (PQconnectPoll(conn)) {
+    case PGRES_POLLING_READING:
+        watch(QSocketNotifier::Read);
+        break;
+    case PGRES_POLLING_WRITING:
+        watch(QSocketNotifier::Write);
+        break;
+    case PGRES_POLLING_OK:
+        startQuery();
+        break;
+    default:
+        fail("Export-Verbindung fehlgeschlagen: " + QString::fromUtf8(PQerrorMessage(conn)).trimmed());
+        break;
+    }
+}
+
+void TableExport::startQuery()
+{
+    PQsetnonblocking(conn, 1);
+
+    const QByteArray name = table.toUtf8();
+    char *ident = PQescapeIdentifier(conn, name.constData(), size_t(name.size()));
+    if (!ident) {
+        fail("Ungültiger Tabellenname: " + table);
+        return;
+    }
+    // (SELECT …) statt COPY <tabelle>: die Whitelist enthält auch Views.
+    // NDJSON: eine Spalte row_to_json als CSV mit Steuerzeichen als
+    // Quote/Delimiter — JSON enthält beide nie roh, also kommt jede Zeile
+    // unverändert an (im Text-Format würden Backslashes verdoppelt)
+    const QByteArray sql = format == Format::Csv
+        ? QByteArray("COPY (SELECT * FROM ") + ident + ") TO STDOUT (FORMAT csv, HEADER)"
+        : QByteArray("COPY (SELECT row_to_json(t) FROM ") + ident
+              + " t) TO STDOUT (FORMAT csv, QUOTE E'\\x01', DELIMITER E'\\x02')";
+    PQfreemem(ident);
+
+    if (!PQsendQuery(conn, sql.constData())) {
+        fail("Export-Abfrage fehlgeschlagen: " + QString::fromUtf8(PQerrorMessage(conn)).trimmed());
+        return;
+    }
+    state = State::Querying;
+    watch(PQflush(conn) == 1 ? QSocketNotifier::Write : QSocketNotifier::Read);
+}
+
+void TableExport::readResult()
+{
+    if (!PQconsumeInput(conn)) {
+        fail("Export-Abfrage fehlgeschlagen: " + QString::fromUtf8(PQerrorMessage(conn)).trimmed());
+        return;
+    }
+    if (PQisBusy(conn))
+        return;
+
+    PGresult *res = PQgetResult(conn);
+    if (PQresultStatus(res) != PGRES_COPY_OUT) {
+        const QString error = QString::fromUtf8(res ? PQresultErrorMessage(res) : PQerrorMessage(conn)).trimmed();
+        PQclear(res);
+        fail("Export-Abfrage fehlgeschlagen: " + error);
+        return;
+    }
+    PQclear(res);
+
+    // Erst jetzt Header senden — bis hierher gibt es noch eine normale Fehlerantwort
+    const QByteArray extension = format == Format::Csv ? ".csv" : ".ndjson";
+    QHttpHeaders headers;
+    headers.append(QHttpHeaders::WellKnownHeader::ContentType,
+                   format == Format::Csv ? "text/csv; charset=utf-8" : "application/x-ndjson");
+    headers.append(QHttpHeaders::WellKnownHeader::ContentDisposition,
+                   "attachment; filename=\"" + table.toUtf8() + extension + "\"");
+    headers.append(QHttpHeaders::WellKnownHeader::CacheControl, "no-store");
+    headers.append("X-Accel-Buffering", "no");   // NGINX: nicht zwischenspeichern, Gegendruck durchreichen
+    responder.writeBeginChunked(headers);
+    headersSent = true;
+
+    state = State::Copying;
+    pump();
+}
+
+void TableExport::pump()
+{
+    if (state != State::Copying || paused)
+        return;
+    if (!PQconsumeInput(conn)) {
+        fail("Export abgebrochen: " + QString::fromUtf8(PQerrorMessage(conn)).trimmed());
+        return;
+    }
+
+    QByteArray chunk;
+    chunk.reserve(ChunkBytes);
+    auto send = [&]() {
+        if (chunk.isEmpty())
+            return false;
+        responder.writeChunk(chunk);
+        bytes += chunk.size();
+        exportedBytes += quint64(chunk.size());
+        chunk.resize(0);
+        // Client kommt nicht hinterher: DB-Socket nicht mehr lesen, bis
+        // bytesWritten den Puffer unter LowWaterBytes meldet
+        if (socket && socket->bytesToWrite() > HighWaterBytes) {
+            paused = true;
+            notifier->setEnabled(false);
+            return true;
+        }
+        return false;
+    };
+
+    for (;;) {
+        char *buffer = nullptr;
+        const int n = PQgetCopyData(conn, &buffer, 1);
+        if (n > 0) {
+            chunk.append(buffer, n);
+            PQfreemem(buffer);
+            ++rows;
+            if (chunk.size() >= ChunkBytes && send())
+                return;
+            continue;
+        }
+        // Rest senden; bei n == 0 weiter, sobald der DB-Socket Daten hat
+        send();
+        if (n == 0)
+            return;
+        // Ende der Daten: auch bei gebremstem Client jetzt abschließen — das
+        // Ende meldet libpq nur einmal, ein späterer pump() bekäme -2
+        if (n == -1)
+            finishCopy();
+        else
+            fail("Export abgebrochen: " + QString::fromUtf8(PQerrorMessage(conn)).trimmed());
+        return;
+    }
+}
+
+void TableExport::finishCopy()
+{
+    // Nach dem Ende der COPY-Daten liegt das Abschluss-Ergebnis bereits vor
+    PGresult *res = PQgetResult(conn);
+    const bool ok = PQresultStatus(res) == PGRES_COMMAND_OK;
+    const QString error = ok ? QString() : QString::fromUtf8(PQresultErrorMessage(res)).trimmed();
+    PQclear(res);
+    if (!ok) {
+        fail("Export abgebrochen: " + error);
+        return;
+    }
+
+    responder.writeEndChunked(QByteArray());
+    ++completedExports;
+    qCInfo(lcHttp).nospace() << "Export " << table << (format == Format::Csv ? " (csv)" : " (ndjson)")
+                             << ": " << rows << " Zeilen, " << bytes << " Bytes in " << timer.elapsed() << " ms";
+    finish();
+}
+
+void TableExport::fail(const QString &message)
+{
+    if (state == State::Done)
+        return;
+    ++failedExports;
+    qCWarning(lcDb) << "Export" << table << "fehlgeschlagen:" << message;
+
+    if (!headersSent) {
+        QJsonObject error;
+        error["error"] = message;
+        responder.sendResponse(QHttpServerResponse(error, QHttpServerResponse::StatusCode::InternalServerError));
+    } else if (socket) {
+        // Header und Daten sind schon unterwegs: Verbindung ohne abschließenden
+        // Chunk kappen, damit der Client die Datei als unvollständig erkennt
+        socket->abort();
+    }
+    finish();
+}
+
+void TableExport::cancel()
+{
+    if (state == State::Done)
+        return;
+    ++canceledExports;
+    qCDebug(lcHttp) << "Export" << table << "abgebrochen (Client getrennt) nach" << bytes << "Bytes";
+
+    // Laufendes COPY auf dem Server beenden, nicht erst beim nächsten Schreiben
+    if (conn && state != State::Connecting) {
+        if (PGcancel *handle = PQgetCancel(conn)) {
+            char error[256];
+            if (!PQcancel(handle, error, sizeof(error)))
+                qCWarning(lcDb) << "PQcancel fehlgeschlagen:" << error;
+            PQfreeCancel(handle);
+        }
+    }
+    finish();
+}
+
+void TableExport::finish()
+{
+    if (state == State::Done)
+        return;
+    state = State::Done;
+    --activeExports;
+
+    if (notifier) {
+        notifier->setEnabled(false);
+        notifier->deleteLater();
+        notifier = nullptr;
+    }
+    if (conn) {
+        PQfinish(conn);
+        conn = nullptr;
+    }
+    if (socket)
+        disconnect(socket, nullptr, this, nullptr);
+    deleteLater();
+}
+
+QJsonObject TableExport::stats()
+{
+    QJsonObject s;
+    s["active"]    = activeExports;
+    s["started"]   = qint64(startedExports);
+    s["completed"] = qint64(completedExports);
+    s["failed"]    = qint64(failedExports);
+    s["canceled"]  = qint64(canceledExports);
+    s["bytes"]     = qint64(exportedBytes);
+    return s;
+}
@@ -0,0 +1,70 @@
+#ifndef TABLEEXPORT_H
+#define TABLEEXPORT_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHttpServerResponder>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSocketNotifier>
+#include <QString>
+#include <QTcpSocket>
+
+typedef struct pg_conn PGconn;
+
+// Export einer ganzen Tabelle (GET /api/table/export) per COPY TO STDOUT
+//
+// Eigene libpq-Verbindung, komplett nicht-blockierend im Event-Loop:
+// Verbindungsaufbau, Abfrage und COPY-Daten laufen über einen
+// QSocketNotifier. Die Zeilen gehen unverändert als Chunks in die Antwort.
+// Hat der Client-Socket zu viel Ungesendetes, wird der DB-Socket nicht mehr
+// gelesen — der TCP-Puffer läuft voll und PostgreSQL wartet. Der Speicher
+// bleibt so unabhängig von der Tabellengröße konstant.
+class TableExport : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Format { Csv, Ndjson };
+
+    // Startet sofort; das Objekt löscht sich nach dem letzten Chunk selbst.
+    // table muss bereits gegen die Whitelist geprüft sein.
+    TableExport(const QString &connInfo, const QString &table, Format format,
+                QHttpServerResponder &&responder, QTcpSocket *socket, QObject *parent = nullptr);
+    ~TableExport();
+
+    // Laufende und abgeschlossene Exporte (für /metrics)
+    static QJsonObject stats();
+
+private:
+    enum class State { Connecting, Querying, Copying, Done };
+
+    void onSocket();
+    void poll();
+    void startQuery();
+    void readResult();
+    void pump();
+    void finishCopy();
+    void fail(const QString &message);
+    void cancel();
+    void finish();
+    void watch(QSocketNotifier::Type type);
+
+    QString table;
+    Format format;
+    QHttpServerResponder responder;
+    QPointer<QTcpSocket> socket;
+
+    PGconn *conn = nullptr;
+    QSocketNotifier *notifier = nullptr;
+    State state = State::Connecting;
+    bool headersSent = false;
+    bool paused = false;
+
+    QElapsedTimer timer;
+    qint64 bytes = 0;
+    qint64 rows = 0;
+};
+
+#endif // TABLEEXPORT_H
@@ -0,0 +1,215 @@
+#include "trafficcapture.h"
+#include "capturelog.h"
+#include "connectiontracker.h"
+#include "logger.h"
+#include <QDataStream>
+#include <QDateTime>
+#include <QHttpHeaders>
+#include <QHttpServerRequest>
+#include <QUrlQuery>
+#include <atomic>
+#include <utility>
+
+// Ab dieser Puffergröße sofort schreiben, nicht erst beim Timer
+static const qsizetype FlushBytes = 256 * 1024;
+
+// Diese Query-Parameter landen nie im Mitschnitt
+static const char *const RedactedParams[] = { "token", "access_token", "password", "api_key" };
+
+static std::atomic<TrafficCapture *> activeCapture { nullptr };
+
+TrafficCapture *TrafficCapture::fromEnvironment(QObject *parent)
+{
+    const QString path = qEnvironmentVariable("CAPTURE_FILE");
+    if (path.isEmpty())
+        return nullptr;
+    const int maxMb = qEnvironmentVariableIntValue("CAPTURE_MAX_MB");
+
+    auto *capture = new TrafficCapture(path, qint64(maxMb > 0 ? maxMb : 256) * 1024 * 1024, parent);
+    if (!capture->file.isOpen()) {
+        delete capture;
+        return nullptr;
+    }
+    activeCapture.store(capture, std::memory_order_release);
+    return capture;
+}
+
+TrafficCapture::TrafficCapture(const QString &path, qint64 maxBytes, QObject *parent)
+    : QObject(parent), file(path), maxBytes(maxBytes)
+{
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(lcHttp) << "CAPTURE_FILE kann nicht geöffnet werden:" << path << file.errorString();
+        return;
+    }
+
+    QDataStream header(&file);
+    header.setVersion(CaptureLog::StreamVersion);
+    header.writeRawData(CaptureLog::Magic, sizeof(CaptureLog::Magic));
+    header << CaptureLog::FormatVersion << QDateTime::currentMSecsSinceEpoch();
+    written = accepted = file.pos();
+    clock.start();
+
+    writer.setMaxThreadCount(1);
+    writer.setExpiryTimeout(-1);
+
+    flushTimer.setInterval(1000);
+    connect(&flushTimer, &QTimer::timeout, this, [this]() {
+        QMutexLocker lock(&mutex);
+        flush();
+    });
+    flushTimer.start();
+
+    qCInfo(lcHttp) << "Traffic-Mitschnitt aktiv:" << path << "(max." << maxBytes / (1024 * 1024) << "MB)";
+}
+
+TrafficCapture::~TrafficCapture()
+{
+    if (activeCapture.load() == this)
+        activeCapture.store(nullptr);
+    {
+        QMutexLocker lock(&mutex);
+        // Noch offene Requests (Server beendet) ohne Antwort übernehmen
+        for (const QList<Open> &pending : std::as_const(open)) {
+            for (const Open &o : pending)
+                complete(o, 0);
+        }
+        open.clear();
+        flush();
+    }
+    writer.waitForDone();
+}
+
+void TrafficCapture::record(const QHttpServerRequest &request, const char *route)
+{
+    if (TrafficCapture *capture = activeCapture.load(std::memory_order_acquire))
+        capture->append(request, route);
+}
+
+void TrafficCapture::append(const QHttpServerRequest &request, const char *route)
+{
+    Open o;
+    o.startedNs = clock.nsecsElapsed();
+    CaptureLog::Record &r = o.record;
+    r.offsetUs = o.startedNs / 1000;
+    r.route = route;
+    r.method = r.route.left(r.route.indexOf(' '));
+
+    QUrl url = request.url();
+    QUrlQuery query(url);
+    for (const char *param : RedactedParams)
+        query.removeAllQueryItems(QString::fromLatin1(param));
+    url.setQuery(query);
+    r.target = url.toEncoded(QUrl::RemoveScheme | QUrl::RemoveAuthority);
+
+    const QHttpHeaders headers = request.headers();
+    r.accept = headers.value(QHttpHeaders::WellKnownHeader::Accept).toByteArray();
+    r.contentType = headers.value(QHttpHeaders::WellKnownHeader::ContentType).toByteArray();
+    r.ifMatch = headers.value(QHttpHeaders::WellKnownHeader::IfMatch).toByteArray();
+    r.ifNoneMatch = headers.value(QHttpHeaders::WellKnownHeader::IfNoneMatch).toByteArray();
+    r.authorized = headers.contains(QHttpHeaders::WellKnownHeader::Authorization);
+    // Zugangsdaten nie mitschneiden — der Replay meldet sich selbst an
+    if (r.route != "POST /api/login")
+        r.body = request.body();
+
+    const QString connection = ConnectionTracker::connectionKey(request);
+    QMutexLocker lock(&mutex);
+    if (stopped)
+        return;
+    open[connection].append(std::move(o));
+}
+
+void TrafficCapture::responded(const QString &connection, int status)
+{
+    QMutexLocker lock(&mutex);
+    const auto it = open.find(connection);
+    // Antwort ohne Record (z.B. 404 ohne Route) — nichts offen
+    if (it == open.end())
+        return;
+    const Open o = it->takeFirst();
+    if (it->isEmpty())
+        open.erase(it);
+    complete(o, status);
+}
+
+void TrafficCapture::connectionClosed(const QString &connection)
+{
+    QMutexLocker lock(&mutex);
+    // Client vor der Antwort gegangen: Request trotzdem mitschneiden
+    for (const Open &o : open.take(connection))
+        complete(o, 0);
+}
+
+void TrafficCapture::complete(const Open &o, int status)
+{
+    // Aufrufer hält mutex
+    if (stopped)
+        return;
+    CaptureLog::Record r = o.record;
+    r.status = status;
+    r.durationUs = status > 0 ? (clock.nsecsElapsed() - o.startedNs) / 1000 : -1;
+
+    QByteArray encoded;
+    QDataStream out(&encoded, QIODevice::WriteOnly);
+    out.setVersion(CaptureLog::StreamVersion);
+    out << r;
+
+    if (accepted + encoded.size() > maxBytes) {
+        stop("CAPTURE_MAX_MB erreicht");
+        return;
+    }
+    buffer += encoded;
+    accepted += encoded.size();
+    ++records;
+    if (buffer.size() >= FlushBytes)
+        flush();
+}
+
+void TrafficCapture::flush()
+{
+    // Aufrufer hält mutex; geschrieben wird im Schreib-Thread
+    if (buffer.isEmpty())
+        return;
+    writer.start([this, data = std::exchange(buffer, QByteArray())]() {
+        if (!file.isOpen())
+            return;
+        const bool ok = file.write(data) == data.size() && file.flush();
+        QMutexLocker lock(&mutex);
+        if (ok) {
+            written += data.size();
+            return;
+        }
+        if (!stopped) {
+            stopped = true;
+            open.clear();
+            buffer.clear();
+            qCWarning(lcHttp) << "Traffic-Mitschnitt beendet: Schreibfehler —" << records << "Requests";
+        }
+        file.close();
+    });
+}
+
+void TrafficCapture::stop(const char *reason)
+{
+    // Aufrufer hält mutex
+    flush();
+    stopped = true;
+    open.clear();
+    writer.start([this]() { file.close(); });
+    qCWarning(lcHttp) << "Traffic-Mitschnitt beendet:" << reason << "—" << records << "Requests";
+}
+
+QJsonObject TrafficCapture::stats() const
+{
+    QMutexLocker lock(&mutex);
+    qsizetype pending = 0;
+    for (const QList<Open> &o : open)
+        pending += o.size();
+    QJsonObject s;
+    s["file"]    = file.fileName();
+    s["active"]  = !stopped;
+    s["records"] = qint64(records);
+    s["open"]    = qint64(pending);
+    s["bytes"]   = accepted;
+    s["written"] = written;
+    return s;
+}
@@ -0,0 +1,81 @@
+#ifndef TRAFFICCAPTURE_H
+#define TRAFFICCAPTURE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QThreadPool>
+#include <QTimer>
+#include "capturelog.h"
+
+class QHttpServerRequest;
+
+// Mitschnitt des eingehenden Traffics für replay/traffic-replay
+//
+// Nur mit CAPTURE_FILE aktiv. RequestContext meldet jeden Request beim
+// Eintritt in den Route-Handler: Methode, Route, Pfad + Query, die für
+// die Antwort relevanten Header und den Body, dazu der Zeitpunkt relativ
+// zum Start. Authorization wird nie gespeichert (nur ob vorhanden),
+// Login-Bodies und token/password-Parameter werden entfernt.
+//
+// Der Record bleibt offen, bis die Antwort auf derselben Verbindung beginnt
+// (ConnectionTracker::responseStarted) — dann kommen Status und Dauer dazu.
+// Schließt der Client vorher, wird er mit Status 0 geschrieben.
+// Geschrieben wird gepuffert, spätestens jede Sekunde, in einem eigenen
+// Schreib-Thread; bei CAPTURE_MAX_MB (Default 256) endet der Mitschnitt.
+class TrafficCapture : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Aktiv, wenn CAPTURE_FILE gesetzt ist und sich öffnen lässt, sonst nullptr
+    static TrafficCapture *fromEnvironment(QObject *parent = nullptr);
+    ~TrafficCapture();
+
+    // Aus RequestContext — ohne aktiven Mitschnitt nur eine Abfrage
+    static void record(const QHttpServerRequest &request, const char *route);
+
+    QJsonObject stats() const;
+
+public slots:
+    // Von ConnectionTracker: Antwort auf der Verbindung beginnt / Verbindung zu
+    void responded(const QString &connection, int status);
+    void connectionClosed(const QString &connection);
+
+private:
+    TrafficCapture(const QString &path, qint64 maxBytes, QObject *parent);
+
+    struct Open {
+        CaptureLog::Record record;
+        qint64 startedNs = 0;
+    };
+
+    void append(const QHttpServerRequest &request, const char *route);
+    void complete(const Open &open, int status);
+    void flush();
+    void stop(const char *reason);
+
+    QFile file;                       // nur im Schreib-Thread (bzw. nach waitForDone)
+    qint64 maxBytes;
+    QElapsedTimer clock;
+    QTimer flushTimer;
+
+    mutable QMutex mutex;
+    QHash<QString, QList<Open>> open; // Verbindung → Requests ohne Antwort (HTTP/1.1: in Reihenfolge)
+    QByteArray buffer;
+    qint64 accepted = 0;              // Dateigröße inkl. Puffer und laufender Schreibvorgänge
+    qint64 written = 0;
+    quint64 records = 0;
+    bool stopped = false;
+
+    // Ein Thread, Aufträge in Reihenfolge — der Event-Loop wartet nie auf die Platte.
+    // Zuletzt deklariert: der Destruktor wartet auf ihn, bevor der Rest verschwindet.
+    QThreadPool writer;
+};
+
+#endif // TRAFFICCAPTURE_H
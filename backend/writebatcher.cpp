@@ -0,0 +1,187 @@
+#include "writebatcher.h"
+#include "database.h"
+#include "logger.h"
+#include <QElapsedTimer>
+#include <QSqlQuery>
+#include <QtConcurrent>
+
+static const int DefaultWindowMs = 2;
+static const int DefaultMaxBatch = 64;
+
+WriteBatcher::WriteBatcher(Database *database, QObject *parent)
+    : QObject(parent), db(database)
+{
+    const QByteArray window = qgetenv("WRITE_BATCH_WINDOW_MS");
+    const int max = qEnvironmentVariableIntValue("WRITE_BATCH_MAX");
+    maxBatch = max > 0 ? max : DefaultMaxBatch;
+
+    windowTimer.setSingleShot(true);
+    windowTimer.setInterval(window.isEmpty() ? DefaultWindowMs : qMax(0, window.toInt()));
+    connect(&windowTimer, &QTimer::timeout, this, &WriteBatcher::flush);
+}
+
+WriteBatcher::~WriteBatcher()
+{
+    // Nicht mehr gestartete Mutationen nicht hängen lassen
+    for (Pending &p : queue) {
+        QJsonObject result;
+        result["error"] = "Server wird beendet";
+        p.promise->addResult(result);
+        p.promise->finish();
+    }
+}
+
+QFuture<QJsonObject> WriteBatcher::submit(const Mutation &mutation)
+{
+    auto promise = std::make_shared<QPromise<QJsonObject>>();
+    promise->start();
+    QFuture<QJsonObject> future = promise->future();
+    queue.append({ mutation, std::move(promise) });
+
+    if (queue.size() >= maxBatch) {
+        windowTimer.stop();
+        flush();
+    } else if (!windowTimer.isActive()) {
+        windowTimer.start();
+    }
+    return future;
+}
+
+void WriteBatcher::flush()
+{
+    // Läuft schon ein Batch, startet batchDone() den nächsten
+    if (committing || queue.isEmpty())
+        return;
+
+    auto batch = std::make_shared<Batch>();
+    const qsizetype n = qMin<qsizetype>(queue.size(), maxBatch);
+    batch->reserve(n);
+    for (qsizetype i = 0; i < n; ++i)
+        batch->append(std::move(queue[i]));
+    queue.remove(0, n);
+
+    committing = true;
+    Database *database = db;
+    QtConcurrent::run(db->pool(), [database, batch]() { return commitBatch(database, batch); })
+        .then(this, [this](const Outcome &outcome) { batchDone(outcome); });
+}
+
+void WriteBatcher::batchDone(const Outcome &outcome)
+{
+    committing = false;
+
+    ++batches;
+    mutations += outcome.size;
+    maxBatchSize = qMax(maxBatchSize, outcome.size);
+    const int bucket = outcome.size <= 1 ? 0 : outcome.size <= 4 ? 1 : outcome.size <= 16 ? 2
+                     : outcome.size <= 64 ? 3 : 4;
+    ++sizeBuckets[bucket];
+    commitUsTotal += outcome.commitUs;
+    commitUsMax = qMax(commitUsMax, outcome.commitUs);
+    commitUsLast = outcome.commitUs;
+    rollbacks += outcome.rollbacks;
+    if (outcome.commitFailed) ++commitFailures;
+
+    qCDebug(lcDb) << "Write-Batch:" << outcome.size << "Mutationen," << outcome.commitUs << "µs";
+
+    // Was während des Commits eingetroffen ist, sofort als nächster Batch
+    if (!queue.isEmpty()) {
+        windowTimer.stop();
+        flush();
+    }
+}
+
+WriteBatcher::Outcome WriteBatcher::commitBatch(Database *db, const std::shared_ptr<Batch> &batch)
+{
+    Outcome outcome;
+    outcome.size = int(batch->size());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlDatabase conn = db->connection();
+    // Oracle kennt kein RELEASE SAVEPOINT (Savepoints enden mit der Transaktion)
+    const bool oracle = conn.driverName() == "QOCI";
+    QVector<QJsonObject> results(batch->size());
+
+    if (!conn.transaction()) {
+        for (QJsonObject &r : results)
+            r["error"] = "Transaktion konnte nicht gestartet werden: " + conn.lastError().text();
+        outcome.commitFailed = true;
+    } else {
+        QSqlQuery sp(conn);
+        // Lesebudget der Verbindung (QueryGuard) gilt nicht für den Batch —
+        // SET LOCAL endet mit der Transaktion
+        if (!oracle)
+            sp.exec("SET LOCAL statement_timeout = 0");
+        for (qsizetype i = 0; i < batch->size(); ++i) {
+            sp.exec("SAVEPOINT batch_write");
+            results[i] = apply(db, batch->at(i).mutation);
+            if (results[i].contains("error")) {
+                // Nur diese Mutation verwerfen — PostgreSQL bricht sonst die ganze Transaktion ab
+                sp.exec("ROLLBACK TO SAVEPOINT batch_write");
+                ++outcome.rollbacks;
+            } else if (!oracle) {
+                sp.exec("RELEASE SAVEPOINT batch_write");
+            }
+        }
+
+        if (!conn.commit()) {
+            const QString error = "Commit fehlgeschlagen: " + conn.lastError().text();
+            qCWarning(lcDb) << "Write-Batch:" << error;
+            conn.rollback();
+            for (QJsonObject &r : results) {
+                if (!r.contains("error")) r = QJsonObject{ { "error", error } };
+            }
+            outcome.commitFailed = true;
+        }
+    }
+    outcome.commitUs = timer.nsecsElapsed() / 1000;
+
+    // Eine Position für den ganzen Batch — alle seine Commits liegen davor
+    const quint64 lsn = outcome.commitFailed ? 0 : db->writeLsn();
+    for (qsizetype i = 0; i < batch->size(); ++i) {
+        // Vor der Antwort: der nächste Lesezugriff der Session sieht die Änderung
+        if (!results.at(i).contains("error"))
+            db->noteWrite(batch->at(i).mutation.updatedBy, lsn);
+        const auto &promise = batch->at(i).promise;
+        promise->addResult(results.at(i));
+        promise->finish();
+    }
+    return outcome;
+}
+
+QJsonObject WriteBatcher::apply(Database *db, const Mutation &m)
+{
+    switch (m.kind) {
+    case Kind::Insert: return db->insertProduct(m.data, m.updatedBy);
+    case Kind::Update: return db->updateProduct(m.productId, m.data, m.updatedBy);
+    case Kind::Patch:  return db->patchProduct(m.productId, m.data, m.expectedVersion, m.updatedBy);
+    case Kind::Delete: break;
+    }
+    return db->deleteProduct(m.productId);
+}
+
+QJsonObject WriteBatcher::stats() const
+{
+    QJsonObject sizes;
+    static const char *const labels[] = { "1", "2-4", "5-16", "17-64", ">64" };
+    for (int i = 0; i < 5; ++i)
+        sizes[labels[i]] = qint64(sizeBuckets[i]);
+
+    QJsonObject s;
+    s["batches"]            = qint64(batches);
+    s["mutations"]          = qint64(mutations);
+    s["avgBatchSize"]       = batches > 0 ? double(mutations) / batches : 0.0;
+    s["maxBatchSize"]       = maxBatchSize;
+    s["batchSizes"]         = sizes;
+    s["commitMsAvg"]        = batches > 0 ? commitUsTotal / 1000.0 / batches : 0.0;
+    s["commitMsMax"]        = commitUsMax / 1000.0;
+    s["commitMsLast"]       = commitUsLast / 1000.0;
+    s["savepointRollbacks"] = qint64(rollbacks);
+    s["commitFailures"]     = qint64(commitFailures);
+    s["queued"]             = int(queue.size());
+    s["windowMs"]           = windowTimer.interval();
+    s["maxBatch"]           = maxBatch;
+    return s;
+}
@@ -0,0 +1,94 @@
+#ifndef WRITEBATCHER_H
+#define WRITEBATCHER_H
+
+#include <QObject>
+#include <QFuture>
+#include <QJsonObject>
+#include <QPromise>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <memory>
+
+class Database;
+
+// Group Commit für Produkt-Schreibzugriffe
+//
+// Mutationen, die innerhalb eines kurzen Fensters eintreffen
+// (WRITE_BATCH_WINDOW_MS, Default 2 ms, bzw. sobald WRITE_BATCH_MAX,
+// Default 64, erreicht ist), laufen gemeinsam in einer Transaktion im
+// DB-Worker-Pool — ein Commit (und ein fsync) für alle. Jede Mutation hat
+// einen eigenen Savepoint: schlägt eine fehl, wird nur sie zurückgerollt,
+// die anderen committen trotzdem. Die Futures werden erst nach dem Commit
+// erfüllt, mit demselben Ergebnis wie Database::insertProduct() usw.
+//
+// Es läuft immer nur ein Batch; was währenddessen eintrifft, bildet den
+// nächsten. Unter Last wachsen die Batches so von selbst.
+class WriteBatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Kind { Insert, Update, Patch, Delete };
+
+    struct Mutation {
+        Kind kind = Kind::Insert;
+        int productId = 0;
+        QJsonObject data;
+        qint64 expectedVersion = -1;   // nur Patch (If-Match)
+        QString updatedBy;
+    };
+
+    explicit WriteBatcher(Database *database, QObject *parent = nullptr);
+    ~WriteBatcher();
+
+    // Mutation einreihen — das Future liefert das Ergebnis nach dem Commit
+    QFuture<QJsonObject> submit(const Mutation &mutation);
+
+    // Mutation sofort auf der Verbindung des aufrufenden Threads ausführen
+    static QJsonObject apply(Database *db, const Mutation &mutation);
+
+    // Wartende Mutationen (noch in keinem Batch)
+    int queued() const { return int(queue.size()); }
+
+    // Batchgrößen, Commit-Latenz, zurückgerollte Savepoints (für /metrics)
+    QJsonObject stats() const;
+
+private:
+    struct Pending {
+        Mutation mutation;
+        std::shared_ptr<QPromise<QJsonObject>> promise;
+    };
+    using Batch = QVector<Pending>;
+
+    struct Outcome {
+        int size = 0;
+        qint64 commitUs = 0;
+        int rollbacks = 0;
+        bool commitFailed = false;
+    };
+
+    void flush();
+    void batchDone(const Outcome &outcome);
+    // Läuft im Worker-Thread, erfüllt die Promises
+    static Outcome commitBatch(Database *db, const std::shared_ptr<Batch> &batch);
+
+    Database *db;
+    QTimer windowTimer;
+    int maxBatch;
+    Batch queue;
+    bool committing = false;
+
+    // Metriken (nur Haupt-Thread)
+    quint64 batches = 0;
+    quint64 mutations = 0;
+    int maxBatchSize = 0;
+    quint64 sizeBuckets[5] = {};       // 1, 2–4, 5–16, 17–64, > 64
+    qint64 commitUsTotal = 0;
+    qint64 commitUsMax = 0;
+    qint64 commitUsLast = 0;
+    quint64 rollbacks = 0;
+    quint64 commitFailures = 0;
+};
+
+#endif // WRITEBATCHER_H
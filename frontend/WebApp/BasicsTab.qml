@@ -0,0 +1,184 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== TAB 1: BASICS =====
+Item {
+    required property Main app
+
+    ColumnLayout {
+        width: parent.width
+        spacing: 20
+
+        // Buttons
+        GroupBox {
+            title: "Buttons"
+            Layout.fillWidth: true
+
+            ColumnLayout {
+                width: parent.width
+                spacing: 15
+
+                RowLayout {
+                    spacing: 10
+
+                    Button {
+                        text: "Standard Button"
+                        onClicked: app.outputText = "Standard Button geklickt"
+                    }
+
+                    Button {
+                        text: "Flat Button"
+                        flat: true
+                        onClicked: app.outputText = "Flat Button geklickt"
+                    }
+
+                    Button {
+                        text: "Highlighted"
+                        highlighted: true
+                        onClicked: app.outputText = "Highlighted Button geklickt"
+                    }
+
+                    Button {
+                        text: "Disabled"
+                        enabled: false
+                    }
+                }
+
+                RowLayout {
+                    spacing: 10
+
+                    RoundButton {
+                        text: "+"
+                        onClicked: app.outputText = "Round Button '+' geklickt"
+                    }
+
+                    RoundButton {
+                        text: "−"
+                        onClicked: app.outputText = "Round Button '−' geklickt"
+                    }
+
+                    ToolButton {
+                        text: "Tool"
+                        onClicked: app.outputText = "ToolButton geklickt"
+                    }
+
+                    DelayButton {
+                        text: "Hold Me"
+                        delay: 2000
+                        onActivated: app.outputText = "DelayButton aktiviert nach 2 Sekunden"
+                    }
+                }
+            }
+        }
+
+        // CheckBox & RadioButton
+        GroupBox {
+            title: "Checkboxes & Radio Buttons"
+            Layout.fillWidth: true
+
+            ColumnLayout {
+                spacing: 10
+
+                RowLayout {
+                    CheckBox {
+                        id: check1
+                        text: "Option 1"
+                        onCheckedChanged: app.outputText = "CheckBox 1: " + (checked ? "aktiviert" : "deaktiviert")
+                    }
+                    CheckBox {
+                        id: check2
+                        text: "Option 2"
+                        checked: true
+                        onCheckedChanged: app.outputText = "CheckBox 2: " + (checked ? "aktiviert" : "deaktiviert")
+                    }
+                    CheckBox {
+                        text: "Partial"
+                        checkState: Qt.PartiallyChecked
+                        tristate: true
+                        onCheckStateChanged: app.outputText = "CheckBox State: " + checkState
+                    }
+                }
+
+                RowLayout {
+                    ButtonGroup { id: radioGroup }
+
+                    RadioButton {
+                        text: "Radio A"
+                        checked: true
+                        ButtonGroup.group: radioGroup
+                        onCheckedChanged: if (checked) app.outputText = "Radio A ausgewählt"
+                    }
+                    RadioButton {
+                        text: "Radio B"
+                        ButtonGroup.group: radioGroup
+                        onCheckedChanged: if (checked) app.outputText = "Radio B ausgewählt"
+                    }
+                    RadioButton {
+                        text: "Radio C"
+                        ButtonGroup.group: radioGroup
+                        onCheckedChanged: if (checked) app.outputText = "Radio C ausgewählt"
+                    }
+                }
+            }
+        }
+
+        // Switch & Slider
+        GroupBox {
+            title: "Switch & Slider"
+            Layout.fillWidth: true
+
+            ColumnLayout {
+                spacing: 15
+
+                RowLayout {
+                    Switch {
+                        id: demoSwitch
+                        text: "Switch Element"
+                        onCheckedChanged: app.outputText = "Switch: " + (checked ? "ON" : "OFF")
+                    }
+                    Text {
+                        text: demoSwitch.checked ? "Aktiviert ✓" : "Deaktiviert"
+                        color: demoSwitch.checked ? "#4CAF50" : "#999"
+                        font.bold: true
+                    }
+                }
+
+                RowLayout {
+                    Text { text: "Slider:" }
+                    Slider {
+                        id: demoSlider
+                        from: 0
+                        to: 100
+                        value: 50
+                        Layout.fillWidth: true
+                        onValueChanged: app.outputText = "Slider Wert: " + Math.round(value)
+                    }
+                    Text {
+                        text: Math.round(demoSlider.value)
+                        font.bold: true
+                        color: "#E57373"
+                    }
+                }
+
+                RowLayout {
+                    Text { text: "Range:" }
+                    RangeSlider {
+                        id: rangeSlider
+                        from: 0
+                        to: 100
+                        first.value: 25
+                        second.value: 75
+                        Layout.fillWidth: true
+                        first.onValueChanged: app.outputText = "Range: " + Math.round(first.value) + " - " + Math.round(second.value)
+                        second.onValueChanged: app.outputText = "Range: " + Math.round(first.value) + " - " + Math.round(second.value)
+                    }
+                    Text {
+                        text: Math.round(rangeSlider.first.value) + " - " + Math.round(rangeSlider.second.value)
+                        color: "#E57373"
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,267 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== TAB 5: DATABASE =====
+Item {
+    required property Main app
+
+    ColumnLayout {
+        width: parent.width
+        spacing: 20
+
+        // Greeting Anzeige
+        GroupBox {
+            title: qsTr("Datenbank-Abfrage")
+            Layout.fillWidth: true
+
+            ColumnLayout {
+                spacing: 15
+                width: parent.width
+
+                Rectangle {
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: 100
+                    color: "#FFF5F5"
+                    border.color: "#E57373"
+                    border.width: 2
+                    radius: 8
+
+                    ColumnLayout {
+                        anchors.centerIn: parent
+                        spacing: 8
+
+                        Text {
+                            text: app.greetingMessage
+                            font.pixelSize: 28
+                            font.bold: true
+                            color: "#E57373"
+                            Layout.alignment: Qt.AlignHCenter
+                        }
+                        Text {
+                            text: app.greetingStatus
+                            font.pixelSize: 11
+                            color: "#999"
+                            Layout.alignment: Qt.AlignHCenter
+                        }
+                    }
+                }
+
+                RowLayout {
+                    spacing: 10
+                    Layout.alignment: Qt.AlignHCenter
+
+                    Button { text: "Deutsch"; onClicked: app.loadGreeting("de") }
+                    Button { text: "English"; onClicked: app.loadGreeting("en") }
+                    Button { text: "Español"; onClicked: app.loadGreeting("es") }
+                    Button { text: qsTr("Neu laden"); highlighted: true; onClicked: app.loadGreeting("de") }
+                }
+            }
+        }
+
+        // ===== DB-BROWSER =====
+        GroupBox {
+            title: qsTr("Datenbank-Browser")
+            Layout.fillWidth: true
+            Layout.preferredHeight: 350
+
+            RowLayout {
+                anchors.fill: parent
+                spacing: 15
+
+                // Tabellen-Liste (links)
+                ColumnLayout {
+                    Layout.preferredWidth: 180
+                    Layout.fillHeight: true
+                    spacing: 5
+
+                    Label {
+                        text: qsTr("Tabellen")
+                        font.bold: true
+                        color: "#C62828"
+                    }
+
+                    ListView {
+                        id: tableList
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        clip: true
+                        model: app.dbTables
+
+                        delegate: ItemDelegate {
+                            width: tableList.width
+                            text: modelData
+                            highlighted: modelData === app.selectedTable
+                            font.bold: modelData === app.selectedTable
+
+                            background: Rectangle {
+                                color: modelData === app.selectedTable ? "#FFEBEE" : (parent.hovered ? "#FFF5F5" : "transparent")
+                                border.color: modelData === app.selectedTable ? "#E57373" : "transparent"
+                                border.width: 1
+                                radius: 4
+                            }
+
+                            onClicked: app.loadTableData(modelData)
+                        }
+
+                        ScrollBar.vertical: ScrollBar {}
+                    }
+
+                    Button {
+                        text: qsTr("Aktualisieren")
+                        Layout.fillWidth: true
+                        onClicked: app.loadTables()
+                    }
+                }
+
+                Rectangle {
+                    width: 1
+                    Layout.fillHeight: true
+                    color: "#e0e0e0"
+                }
+
+                // Daten-Liste (rechts)
+                ColumnLayout {
+                    Layout.fillWidth: true
+                    Layout.fillHeight: true
+                    spacing: 5
+
+                    Label {
+                        text: app.selectedTable ? (app.selectedTable + " (" + tableDataModel.rows + " " + qsTr("Zeilen") + ")") : qsTr("Tabelle wählen...")
+                        font.bold: true
+                        color: "#C62828"
+                    }
+
+                    // Spalten-Header (scrollt horizontal mit der Tabelle)
+                    HorizontalHeaderView {
+                        id: dataHeaderView
+                        Layout.fillWidth: true
+                        syncView: dataTableView
+                        clip: true
+                        visible: tableDataModel.columns.length > 0
+
+                        delegate: Rectangle {
+                            implicitHeight: 30
+                            color: "#C62828"
+                            Text {
+                                anchors.fill: parent
+                                anchors.leftMargin: 8
+                                anchors.rightMargin: 8
+                                text: display
+                                color: "white"
+                                font.bold: true
+                                font.pixelSize: 12
+                                elide: Text.ElideRight
+                                verticalAlignment: Text.AlignVCenter
+                            }
+                        }
+                    }
+
+                    // Daten-Zeilen: TableView erzeugt nur sichtbare Zellen
+                    // (Zeilen UND Spalten) und recycelt die Delegates
+                    TableView {
+                        id: dataTableView
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        clip: true
+                        model: tableDataModel
+                        reuseItems: true
+                        boundsBehavior: Flickable.StopAtBounds
+                        columnWidthProvider: function(column) {
+                            return tableDataModel.columnWidth(column)
+                        }
+                        rowHeightProvider: function(row) { return 36 }
+
+                        delegate: Rectangle {
+                            required property string display
+                            required property bool isNull
+                            required property int row
+
+                            color: row % 2 === 0 ? "#FFFFFF" : "#FFF8F8"
+
+                            Text {
+                                anchors.fill: parent
+                                anchors.leftMargin: 8
+                                anchors.rightMargin: 8
+                                text: display
+                                font.pixelSize: 12
+                                font.italic: isNull
+                                color: isNull ? "#999" : "#424242"
+                                elide: Text.ElideRight
+                                verticalAlignment: Text.AlignVCenter
+                            }
+
+                            TapHandler {
+                                onTapped: {
+                                    app.outputText = app.selectedTable + " Zeile " + (row + 1) + " — " + qsTr("Doppelklick für Details");
+                                }
+                                onDoubleTapped: {
+                                    app.openDetailDialog(qsTr("Datensatz Details") + " — " + app.selectedTable + " #" + (row + 1),
+                                                         tableDataModel.rowData(row));
+                                    app.outputText = qsTr("Detail-Ansicht: ") + app.selectedTable + " Zeile " + (row + 1);
+                                }
+                            }
+                        }
+
+                        ScrollBar.vertical: ScrollBar {}
+                        ScrollBar.horizontal: ScrollBar {}
+                    }
+                }
+            }
+        }
+
+        // Server Kontrolle + API Info (kompakt)
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 15
+
+            GroupBox {
+                title: qsTr("Server Kontrolle")
+                Layout.fillWidth: true
+
+                RowLayout {
+                    spacing: 15
+
+                    Button {
+                        text: qsTr("Backend beenden")
+
+                        background: Rectangle {
+                            color: parent.pressed ? "#C62828" : (parent.hovered ? "#EF5350" : "#F44336")
+                            radius: 4
+                        }
+                        contentItem: Text {
+                            text: parent.text
+                            font: parent.font
+                            color: "white"
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                        }
+
+                        onClicked: app.openShutdownDialog()
+                    }
+
+                    Text {
+                        text: qsTr("Nur Development!")
+                        color: "#999"
+                        font.italic: true
+                    }
+                }
+            }
+
+            GroupBox {
+                title: qsTr("API Informationen")
+                Layout.fillWidth: true
+
+                ColumnLayout {
+                    spacing: 3
+                    Label { text: "POST /api/login"; font.family: "monospace"; font.pixelSize: 11; color: "#4CAF50" }
+                    Label { text: "GET  /api/greeting?lang=de"; font.family: "monospace"; font.pixelSize: 11 }
+                    Label { text: "GET  /api/tables"; font.family: "monospace"; font.pixelSize: 11 }
+                    Label { text: "GET  /api/table?name=X&limit=N"; font.family: "monospace"; font.pixelSize: 11 }
+                    Label { text: "GET  /api/styles"; font.family: "monospace"; font.pixelSize: 11 }
+                    Label { text: "POST /api/batch"; font.family: "monospace"; font.pixelSize: 11 }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== DETAIL POPUP (Readonly) =====
+Dialog {
+    id: detailDialog
+    required property Main app
+
+    title: qsTr("Datensatz Details")
+    modal: true
+    anchors.centerIn: parent
+    width: 500
+    height: Math.min(450, detailColumn.implicitHeight + 120)
+
+    property var rowData: ({})
+
+    ScrollView {
+        anchors.fill: parent
+        clip: true
+
+        ColumnLayout {
+            id: detailColumn
+            width: parent.width
+            spacing: 8
+
+            Repeater {
+                model: Object.keys(detailDialog.rowData)
+
+                RowLayout {
+                    spacing: 10
+                    Layout.fillWidth: true
+
+                    Label {
+                        text: modelData + ":"
+                        font.bold: true
+                        Layout.preferredWidth: 140
+                        color: "#C62828"
+                    }
+                    Label {
+                        text: String(detailDialog.rowData[modelData] !== null ? detailDialog.rowData[modelData] : "NULL")
+                        Layout.fillWidth: true
+                        wrapMode: Text.Wrap
+                    }
+                }
+            }
+        }
+    }
+
+    footer: DialogButtonBox {
+        Button {
+            text: qsTr("Schließen")
+            DialogButtonBox.buttonRole: DialogButtonBox.RejectRole
+        }
+    }
+}
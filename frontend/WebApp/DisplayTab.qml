@@ -0,0 +1,186 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== TAB 4: DISPLAY =====
+Item {
+    required property Main app
+
+    ColumnLayout {
+        width: parent.width
+        spacing: 20
+
+        // ProgressBar & BusyIndicator
+        GroupBox {
+            title: "Progress & Indicators"
+            Layout.fillWidth: true
+
+            ColumnLayout {
+                spacing: 15
+                width: parent.width
+
+                RowLayout {
+                    Label { text: "ProgressBar:" }
+                    ProgressBar {
+                        id: progressBar1
+                        from: 0
+                        to: 100
+                        value: demoSlider.value
+                        Layout.fillWidth: true
+                    }
+                    Text {
+                        text: Math.round(progressBar1.value) + "%"
+                        color: "#E57373"
+                    }
+                }
+
+                RowLayout {
+                    Label { text: "Indeterminate:" }
+                    ProgressBar {
+                        indeterminate: true
+                        Layout.fillWidth: true
+                    }
+                }
+
+                RowLayout {
+                    Label { text: "BusyIndicator:" }
+                    BusyIndicator {
+                        running: busySwitch.checked
+                    }
+                    Switch {
+                        id: busySwitch
+                        text: "Running"
+                        checked: true
+                        onCheckedChanged: app.outputText = "BusyIndicator: " + (checked ? "läuft" : "gestoppt")
+                    }
+                }
+            }
+        }
+
+        // Labels mit Farben
+        GroupBox {
+            title: "Labels & Text"
+            Layout.fillWidth: true
+
+            GridLayout {
+                columns: 2
+                columnSpacing: 20
+                rowSpacing: 10
+
+                Label {
+                    text: "Standard Label"
+                }
+                Label {
+                    text: "Mit Tooltip"
+                    color: "#E57373"
+
+                    ToolTip {
+                        id: labelToolTip
+                        visible: labelMouseArea.containsMouse
+                        text: "Dies ist ein Tooltip!"
+                        delay: 300
+
+                        contentItem: Text {
+                            text: labelToolTip.text
+                            color: "black"
+                            font.pixelSize: 13
+                        }
+                        background: Rectangle {
+                            color: "#FFEE58"
+                            border.color: "#F9A825"
+                            border.width: 1
+                            radius: 4
+                        }
+                    }
+
+                    MouseArea {
+                        id: labelMouseArea
+                        anchors.fill: parent
+                        hoverEnabled: true
+                        onClicked: app.outputText = "Label mit Tooltip geklickt"
+                    }
+                }
+
+                Label {
+                    text: "Fett & Groß"
+                    font.bold: true
+                    font.pixelSize: 20
+                }
+                Label {
+                    text: "Kursiv & Rot"
+                    font.italic: true
+                    color: "#F44336"
+                }
+
+                Label {
+                    text: "Link Style"
+                    color: "#E57373"
+                    font.underline: true
+
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: app.outputText = "Link geklickt"
+                    }
+                }
+                Label {
+                    text: "Durchgestrichen"
+                    font.strikeout: true
+                    color: "#999"
+                }
+            }
+        }
+
+        // TabBar Demo
+        GroupBox {
+            title: "TabBar (Nested)"
+            Layout.fillWidth: true
+
+            ColumnLayout {
+                width: parent.width
+
+                TabBar {
+                    id: nestedTabBar
+                    Layout.fillWidth: true
+
+                    TabButton { text: "Tab 1" }
+                    TabButton { text: "Tab 2" }
+                    TabButton { text: "Tab 3" }
+
+                    onCurrentIndexChanged: app.outputText = "Nested Tab gewechselt: " + currentIndex
+                }
+
+                StackLayout {
+                    currentIndex: nestedTabBar.currentIndex
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: 100
+
+                    Rectangle {
+                        color: "#FFEBEE"
+                        Text {
+                            anchors.centerIn: parent
+                            text: "Content Tab 1"
+                            font.pixelSize: 18
+                        }
+                    }
+                    Rectangle {
+                        color: "#E3F2FD"
+                        Text {
+                            anchors.centerIn: parent
+                            text: "Content Tab 2"
+                            font.pixelSize: 18
+                        }
+                    }
+                    Rectangle {
+                        color: "#E8F5E9"
+                        Text {
+                            anchors.centerIn: parent
+                            text: "Content Tab 3"
+                            font.pixelSize: 18
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
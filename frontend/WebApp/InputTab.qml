@@ -0,0 +1,384 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== TAB 2: INPUT =====
+Item {
+    required property Main app
+
+    function updateDateOutput() {
+        var d = String(dayBox.value).padStart(2, '0');
+        var m = String(monthBox.value).padStart(2, '0');
+        var y = yearBox.value;
+        dateDisplay.text = d + "." + m + "." + y;
+        app.outputText = qsTr("Datum: ") + dateDisplay.text;
+    }
+
+    function updateTimeOutput() {
+        var h = String(hourBox.value).padStart(2, '0');
+        var min = String(minuteBox.value).padStart(2, '0');
+        var s = String(secondBox.value).padStart(2, '0');
+        timeDisplay.text = h + ":" + min + ":" + s;
+        app.outputText = qsTr("Zeit: ") + timeDisplay.text;
+    }
+
+    ColumnLayout {
+        width: parent.width
+        spacing: 16
+
+        // ── Text Input (volle Breite) ──────────────────────────
+        GroupBox {
+            title: "Text Input"
+            Layout.fillWidth: true
+
+            GridLayout {
+                columns: 2
+                columnSpacing: 20; rowSpacing: 12
+                width: parent.width
+
+                Label { text: "TextField:" }
+                TextField {
+                    id: textField1
+                    placeholderText: "Name eingeben..."
+                    Layout.fillWidth: true
+                    onTextChanged: app.outputText = "TextField: " + text
+                }
+
+                Label { text: "Passwort:" }
+                TextField {
+                    id: passwordField
+                    placeholderText: "Passwort..."
+                    echoMode: TextInput.Password
+                    Layout.fillWidth: true
+                    onTextChanged: app.outputText = "Passwort eingegeben (Länge: " + text.length + ")"
+                }
+
+                Label { text: "Mit Validator:" }
+                TextField {
+                    placeholderText: "Nur Zahlen"
+                    validator: IntValidator { bottom: 0; top: 999 }
+                    Layout.fillWidth: true
+                    onTextChanged: app.outputText = "Zahl: " + text
+                }
+
+                Label { text: "TextArea:" }
+                TextArea {
+                    id: textArea
+                    placeholderText: "Mehrzeiliger Text..."
+                    wrapMode: TextArea.Wrap
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: 80
+                    onTextChanged: app.outputText = "TextArea (" + text.length + " Zeichen): " + text.substring(0, 50)
+                }
+            }
+        }
+
+        // ── Links: Numerische Eingabe | Rechts: Datum+Zeit+Kalender (feste Größe) ──
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 16
+
+            // LINKS ── Numerische Eingabe (füllt verbleibende Breite) ─
+            GroupBox {
+                title: qsTr("Numerische Eingabe")
+                Layout.fillWidth: true
+                Layout.alignment: Qt.AlignTop
+
+                GridLayout {
+                    columns: 3
+                    columnSpacing: 10; rowSpacing: 10
+                    width: parent.width
+
+                    Label { text: "SpinBox:" }
+                    SpinBox {
+                        id: spinBox1
+                        from: 0; to: 100; value: 42
+                        Layout.columnSpan: 2
+                        onValueChanged: app.outputText = "SpinBox: " + value
+                    }
+
+                    Label { text: "Integer:" }
+                    TextField {
+                        id: intField
+                        placeholderText: "0–100"
+                        Layout.fillWidth: true
+                        validator: IntValidator { bottom: 0; top: 100 }
+                        inputMethodHints: Qt.ImhDigitsOnly
+                        onTextChanged: {
+                            if (text !== "") {
+                                var v = parseInt(text)
+                                if (v >= 0 && v <= 100) app.outputText = "Integer: " + v
+                            }
+                        }
+                    }
+                    Text {
+                        text: intField.text !== "" ? (intField.acceptableInput ? "✓" : "✗") : ""
+                        color: intField.acceptableInput ? "#4CAF50" : "#F44336"
+                        font.bold: true
+                    }
+
+                    Label { text: "Double:" }
+                    TextField {
+                        id: doubleField
+                        placeholderText: "3.14"
+                        Layout.fillWidth: true
+                        validator: RegularExpressionValidator {
+                            regularExpression: /^\d{0,4}([.,]\d{0,2})?$/
+                        }
+                        onTextChanged: {
+                            if (text !== "" && acceptableInput) app.outputText = "Double: " + text
+                        }
+                    }
+                    Text {
+                        text: doubleField.text !== "" ? (doubleField.acceptableInput ? "✓" : "✗") : ""
+                        color: doubleField.acceptableInput ? "#4CAF50" : "#F44336"
+                        font.bold: true
+                    }
+
+                    Label { text: "€-SpinBox:" }
+                    SpinBox {
+                        id: doubleSpinBox
+                        from: 0; to: 1000; value: 314; stepSize: 10
+                        Layout.columnSpan: 2
+                        property int decimals: 2
+                        property real realValue: value / 100
+                        validator: DoubleValidator {
+                            bottom: Math.min(doubleSpinBox.from, doubleSpinBox.to)
+                            top:    Math.max(doubleSpinBox.from, doubleSpinBox.to)
+                        }
+                        textFromValue: function(value, locale) {
+                            return Number(value / 100).toLocaleString(locale, 'f', doubleSpinBox.decimals)
+                        }
+                        valueFromText: function(text, locale) {
+                            return Number.fromLocaleString(locale, text) * 100
+                        }
+                        onValueChanged: app.outputText = "Double SpinBox: " + realValue.toFixed(2)
+                    }
+
+                    Label { text: "Dial:" }
+                    Item {
+                        Layout.columnSpan: 2
+                        Layout.preferredWidth: 130
+                        Layout.preferredHeight: 130
+                        Dial {
+                            id: dial1
+                            from: 0; to: 360; value: 180
+                            anchors.centerIn: parent
+                            width: 100; height: 100
+                            onValueChanged: app.outputText = "Dial: " + Math.round(value) + "°"
+                        }
+                        Text {
+                            anchors.centerIn: parent
+                            text: Math.round(dial1.value) + "°"
+                            font.pixelSize: 15; font.bold: true; color: "#C62828"
+                        }
+                        Text { text: "0°";   font.pixelSize: 9; color: "#999"; x: 5;   y: 105 }
+                        Text { text: "360°"; font.pixelSize: 9; color: "#999"; x: 95;  y: 105 }
+                        Text { text: "180°"; font.pixelSize: 9; color: "#999"; x: 45;  y: 2   }
+                    }
+                }
+            }
+
+            // RECHTS ── Datum, Zeit & Kalender (feste Zellgröße, kein Overflow) ──
+            GroupBox {
+                id: calGroupBox
+                title: qsTr("Datum, Zeit & Kalender")
+                Layout.alignment: Qt.AlignTop
+
+                // Feste Zellgröße 44px → Kalender 308×264px ≈ 8 cm bei 96 dpi
+                readonly property int cellSz: 44
+                readonly property int calW:   cellSz * 7   // 308 px
+                readonly property int calH:   cellSz * 6   // 264 px
+
+                // Innerer Container – Größe vom Inhalt bestimmt (kein anchors.fill)
+                Rectangle {
+                    width:          parent.width
+                    implicitWidth:  dtCol.implicitWidth  + 16
+                    implicitHeight: dtCol.implicitHeight + 16
+                    border.color: "#E57373"; border.width: 1
+                    radius: 6; color: "#FFFFFF"
+
+                    ColumnLayout {
+                        id: dtCol
+                        anchors.left: parent.left; anchors.right: parent.right
+                        anchors.top:  parent.top;  anchors.margins: 8
+                        spacing: 4
+
+                        // ── Datum: Label-Anzeige + 3× +/- (kein Wert sichtbar) ──
+                        RowLayout {
+                            spacing: 4
+                            Text {
+                                id: dateDisplay
+                                text: ""; color: "#C62828"
+                                font.bold: true; font.pixelSize: 14
+                                Layout.minimumWidth: 92
+                            }
+                            Item { Layout.fillWidth: true }
+                            SpinBox {
+                                id: dayBox
+                                from: 1; to: 31; value: new Date().getDate()
+                                implicitWidth: 72; editable: false
+                                textFromValue: function(value) { return "" }
+                                onValueChanged: updateDateOutput()
+                            }
+                            SpinBox {
+                                id: monthBox
+                                from: 1; to: 12; value: new Date().getMonth() + 1
+                                implicitWidth: 72; editable: false
+                                textFromValue: function(value) { return "" }
+                                onValueChanged: updateDateOutput()
+                            }
+                            SpinBox {
+                                id: yearBox
+                                from: 2000; to: 2099; value: new Date().getFullYear()
+                                implicitWidth: 72; editable: false
+                                textFromValue: function(value) { return "" }
+                                onValueChanged: updateDateOutput()
+                            }
+                        }
+
+                        // ── Zeit: Label-Anzeige + 3× +/- ────────────────────
+                        RowLayout {
+                            spacing: 4
+                            Text {
+                                id: timeDisplay
+                                text: ""; color: "#C62828"
+                                font.bold: true; font.pixelSize: 14
+                                Layout.minimumWidth: 92
+                            }
+                            Item { Layout.fillWidth: true }
+                            SpinBox {
+                                id: hourBox
+                                from: 0; to: 23; value: new Date().getHours()
+                                implicitWidth: 72; editable: false
+                                textFromValue: function(value) { return "" }
+                                onValueChanged: updateTimeOutput()
+                            }
+                            SpinBox {
+                                id: minuteBox
+                                from: 0; to: 59; value: new Date().getMinutes()
+                                implicitWidth: 72; editable: false
+                                textFromValue: function(value) { return "" }
+                                onValueChanged: updateTimeOutput()
+                            }
+                            SpinBox {
+                                id: secondBox
+                                from: 0; to: 59; value: 0
+                                implicitWidth: 72; editable: false
+                                textFromValue: function(value) { return "" }
+                                onValueChanged: updateTimeOutput()
+                            }
+                        }
+
+                        Rectangle { height: 1; Layout.fillWidth: true; color: "#FFCDD2" }
+
+                        // ── Monat/Jahr Navigation (Breite = calW) ────────────
+                        RowLayout {
+                            Layout.preferredWidth: calGroupBox.calW
+                            Layout.alignment: Qt.AlignHCenter
+                            Button {
+                                text: "◀"; flat: true
+                                implicitWidth: 36; implicitHeight: 34
+                                onClicked: {
+                                    if (monthBox.value > 1) monthBox.value--
+                                    else { monthBox.value = 12; yearBox.value-- }
+                                }
+                            }
+                            Item { Layout.fillWidth: true }
+                            Text {
+                                text: ["", "Januar", "Februar", "März", "April", "Mai", "Juni",
+                                       "Juli", "August", "September", "Oktober", "November", "Dezember"
+                                      ][monthBox.value] + "  " + yearBox.value
+                                font.bold: true; font.pixelSize: 15; color: "#C62828"
+                            }
+                            Item { Layout.fillWidth: true }
+                            Button {
+                                text: "▶"; flat: true
+                                implicitWidth: 36; implicitHeight: 34
+                                onClicked: {
+                                    if (monthBox.value < 12) monthBox.value++
+                                    else { monthBox.value = 1; yearBox.value++ }
+                                }
+                            }
+                        }
+
+                        // ── Wochentage-Header (je cellSz breit) ──────────────
+                        Row {
+                            Layout.alignment: Qt.AlignHCenter
+                            Repeater {
+                                model: ["Mo", "Di", "Mi", "Do", "Fr", "Sa", "So"]
+                                Text {
+                                    width: calGroupBox.cellSz
+                                    text: modelData
+                                    font.pixelSize: 12; font.bold: true
+                                    color: index >= 5 ? "#C62828" : "#666"
+                                    horizontalAlignment: Text.AlignHCenter
+                                }
+                            }
+                        }
+
+                        Rectangle {
+                            height: 1; color: "#FFCDD2"
+                            Layout.preferredWidth: calGroupBox.calW
+                            Layout.alignment: Qt.AlignHCenter
+                        }
+
+                        // ── Kalender-Grid: FESTE Größe → nie abgeschnitten ───
+                        Item {
+                            id: calGridItem
+                            Layout.preferredWidth:  calGroupBox.calW   // 308 px (fest)
+                            Layout.preferredHeight: calGroupBox.calH   // 264 px (fest)
+                            Layout.alignment: Qt.AlignHCenter
+
+                            Grid {
+                                id: calGrid
+                                anchors.fill: parent
+                                columns: 7
+
+                                property int  daysInMonth:    new Date(yearBox.value, monthBox.value, 0).getDate()
+                                property int  firstDayOfWeek: (new Date(yearBox.value, monthBox.value - 1, 1).getDay() + 6) % 7
+                                property real cellW: calGroupBox.cellSz   // fest 44 px
+                                property real cellH: calGroupBox.cellSz   // fest 44 px
+
+                                Repeater {
+                                    model: 42
+                                    Rectangle {
+                                        property int  dayNum:     index - calGrid.firstDayOfWeek + 1
+                                        property bool isValid:    dayNum >= 1 && dayNum <= calGrid.daysInMonth
+                                        property bool isSelected: isValid && dayNum === dayBox.value
+                                        property bool isWeekend:  (index % 7) >= 5
+
+                                        width:  calGrid.cellW; height: calGrid.cellH
+                                        radius: Math.min(width, height) * 0.45
+                                        color:  isSelected ? "#C62828" :
+                                                (calDayMouse.containsMouse && isValid ? "#FFEBEE" : "transparent")
+
+                                        Text {
+                                            anchors.centerIn: parent
+                                            text:           isValid ? dayNum : ""
+                                            font.pixelSize: 14
+                                            font.bold:      isSelected
+                                            color: isSelected ? "white" :
+                                                   (isWeekend && isValid ? "#E53935" : "#424242")
+                                        }
+                                        MouseArea {
+                                            id: calDayMouse
+                                            anchors.fill: parent
+                                            hoverEnabled: true
+                                            onClicked: {
+                                                if (isValid) {
+                                                    dayBox.value = dayNum
+                                                    app.outputText = qsTr("Kalender: ") + dayNum + "." + monthBox.value + "." + yearBox.value
+                                                }
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,11 @@
+import QtQuick
+import QtQuick.Layouts
+
+// Seite im StackLayout: Inhalt wird erst beim ersten Anzeigen erzeugt
+// und bleibt danach erhalten (Eingaben, Scroll-Position)
+Loader {
+    property bool opened: false
+
+    active: opened || StackLayout.isCurrentItem
+    onLoaded: opened = true
+}
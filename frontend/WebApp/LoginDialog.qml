@@ -0,0 +1,123 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== LOGIN DIALOG =====
+Dialog {
+    id: loginDialog
+    required property Main app
+
+    // Fehlermeldung im Dialog (z.B. "Sitzung abgelaufen")
+    property alias errorText: loginErrorText.text
+
+    function performLogin() {
+        var user = loginUserField.text;
+        var pass = loginPasswordField.text;
+        loginErrorText.text = "";
+
+        apiClient.post("/api/login", { username: user, password: pass }, function(status, response) {
+            if (status === 200) {
+                if (!response || !response.token) {
+                    loginErrorText.text = qsTr("Serverfehler beim Login");
+                    return;
+                }
+                loginDialog.close();
+                app.loginSucceeded(response.token, response.username);
+            } else if (status === 401) {
+                loginErrorText.text = qsTr("Ungültige Anmeldedaten");
+                loginPasswordField.text = "";
+                loginPasswordField.forceActiveFocus();
+            } else {
+                loginErrorText.text = qsTr("Verbindungsfehler: ") + status;
+            }
+        });
+    }
+
+    onOpened: loginUserField.forceActiveFocus()
+
+    title: qsTr("Anmeldung")
+    modal: true
+    anchors.centerIn: parent
+    width: 380
+    closePolicy: Popup.NoAutoClose
+
+    ColumnLayout {
+        width: parent.width
+        spacing: 15
+
+        // Logo/Titel
+        Text {
+            text: "Qt6 WebApp"
+            font.pixelSize: 22
+            font.bold: true
+            color: "#C62828"
+            Layout.alignment: Qt.AlignHCenter
+        }
+
+        Text {
+            text: qsTr("Bitte melden Sie sich an")
+            color: "#666"
+            font.pixelSize: 13
+            Layout.alignment: Qt.AlignHCenter
+        }
+
+        // Fehlermeldung
+        Rectangle {
+            id: loginErrorBox
+            Layout.fillWidth: true
+            height: loginErrorText.implicitHeight + 16
+            color: "#FFEBEE"
+            border.color: "#F44336"
+            border.width: 1
+            radius: 4
+            visible: loginErrorText.text !== ""
+
+            Text {
+                id: loginErrorText
+                text: ""
+                color: "#C62828"
+                font.pixelSize: 12
+                anchors.centerIn: parent
+                width: parent.width - 20
+                wrapMode: Text.WordWrap
+                horizontalAlignment: Text.AlignHCenter
+            }
+        }
+
+        GridLayout {
+            columns: 2
+            columnSpacing: 10
+            rowSpacing: 10
+            Layout.fillWidth: true
+
+            Label { text: qsTr("Benutzer:"); font.bold: true }
+            TextField {
+                id: loginUserField
+                placeholderText: qsTr("Benutzername")
+                Layout.fillWidth: true
+                text: "admin"
+                onAccepted: loginPasswordField.forceActiveFocus()
+            }
+
+            Label { text: qsTr("Passwort:"); font.bold: true }
+            TextField {
+                id: loginPasswordField
+                placeholderText: qsTr("Passwort")
+                echoMode: TextInput.Password
+                Layout.fillWidth: true
+                onAccepted: performLogin()
+            }
+        }
+    }
+
+    footer: DialogButtonBox {
+        Button {
+            text: qsTr("Anmelden")
+            highlighted: true
+            enabled: loginUserField.text !== "" && loginPasswordField.text !== ""
+            DialogButtonBox.buttonRole: DialogButtonBox.AcceptRole
+        }
+    }
+
+    onAccepted: performLogin()
+}
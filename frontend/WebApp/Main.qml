@@ -0,0 +1,641 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+ApplicationWindow {
+    id: window
+    visible: true
+    width: 1200
+    height: 900
+    title: "Qt6 QML GUI Elements Demo"
+    
+    // Hintergrundfarbe zartrot
+    color: "#FFF0F0"
+
+    // Auth State
+    property string authToken: ""
+    property string authUser: ""
+    property bool isLoggedIn: authToken !== ""
+
+    // State für Tab-Navigation
+    property int currentTab: 0
+
+    // Output-Text für alle Interaktionen
+    property string outputText: qsTr("Bitte anmelden...")
+    
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: 0
+        
+        // ===== HEADER =====
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 80
+            gradient: Gradient {
+                GradientStop { position: 0.0; color: "#E57373" }
+                GradientStop { position: 1.0; color: "#C62828" }
+            }
+            
+            ColumnLayout {
+                anchors.centerIn: parent
+                spacing: 5
+                
+                Text {
+                    text: "Qt6 QML GUI Elements Showcase"
+                    font.pixelSize: 28
+                    font.bold: true
+                    color: "white"
+                    Layout.alignment: Qt.AlignHCenter
+                }
+                
+                Text {
+                    text: "WebAssembly • PostgreSQL Backend • NGINX"
+                    font.pixelSize: 14
+                    color: "#FFCDD2"
+                    Layout.alignment: Qt.AlignHCenter
+                }
+            }
+        }
+        
+        // ===== TAB BAR =====
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 50
+            color: "white"
+            border.color: "#e0e0e0"
+            border.width: 1
+            
+            RowLayout {
+                anchors.fill: parent
+                spacing: 0
+                
+                Repeater {
+                    model: ["Basics", "Input", "Selection", "Display", "Database", "Produkte"]
+                    
+                    Rectangle {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        color: currentTab === index ? "#C62828" : (tabMouseArea.containsMouse ? "#FFEBEE" : "white")
+                        border.color: "#e0e0e0"
+                        border.width: 1
+                        
+                        Text {
+                            anchors.centerIn: parent
+                            text: modelData
+                            font.pixelSize: 16
+                            font.bold: currentTab === index
+                            color: currentTab === index ? "white" : "#333"
+                        }
+                        
+                        MouseArea {
+                            id: tabMouseArea
+                            anchors.fill: parent
+                            hoverEnabled: true
+                            onClicked: currentTab = index
+                            cursorShape: Qt.PointingHandCursor
+                        }
+                    }
+                }
+            }
+        }
+        
+        // ===== CONTENT AREA =====
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            color: "#FFF5F5"
+            
+            ScrollView {
+                anchors.fill: parent
+                anchors.margins: 20
+                clip: true
+                
+                StackLayout {
+                    width: parent.width
+                    currentIndex: currentTab
+
+                    // Tabs werden erst beim ersten Öffnen erzeugt (LazyPage)
+                    LazyPage { sourceComponent: Component { BasicsTab { app: window } } }
+                    LazyPage { sourceComponent: Component { InputTab { app: window } } }
+                    LazyPage { sourceComponent: Component { SelectionTab { app: window } } }
+                    LazyPage { sourceComponent: Component { DisplayTab { app: window } } }
+                    LazyPage { sourceComponent: Component { DatabaseTab { app: window } } }
+                    LazyPage { sourceComponent: Component { ProductsTab { app: window } } }
+                }
+            }
+        }
+
+        // ===== OUTPUT CONSOLE =====
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 100
+            color: "#263238"
+            border.color: "#37474F"
+            border.width: 1
+            
+            ColumnLayout {
+                anchors.fill: parent
+                anchors.margins: 10
+                spacing: 5
+                
+                Text {
+                    text: "Output Console:"
+                    color: "#EF9A9A"
+                    font.bold: true
+                    font.pixelSize: 12
+                }
+                
+                Rectangle {
+                    Layout.fillWidth: true
+                    Layout.fillHeight: true
+                    color: "#1E1E1E"
+                    radius: 4
+                    
+                    ScrollView {
+                        anchors.fill: parent
+                        anchors.margins: 10
+                        
+                        Text {
+                            text: "> " + outputText
+                            color: "#4CAF50"
+                            font.family: "monospace"
+                            font.pixelSize: 13
+                            wrapMode: Text.Wrap
+                            width: parent.width
+                        }
+                    }
+                }
+            }
+        }
+        
+        // ===== FOOTER =====
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 40
+            color: "#37474F"
+
+            RowLayout {
+                anchors.centerIn: parent
+                spacing: 15
+
+                Text {
+                    text: isLoggedIn ? ("✓ " + authUser) : qsTr("Nicht angemeldet")
+                    color: isLoggedIn ? "#81C784" : "#EF9A9A"
+                    font.pixelSize: 12
+                    font.bold: true
+                }
+
+                Rectangle { width: 1; height: 20; color: "#546E7A" }
+
+                Text {
+                    text: "Qt " + Application.version
+                    color: "#B0BEC5"
+                    font.pixelSize: 12
+                }
+
+                Rectangle { width: 1; height: 20; color: "#546E7A" }
+
+                Text {
+                    text: "WebAssembly"
+                    color: "#B0BEC5"
+                    font.pixelSize: 12
+                }
+
+                Rectangle { width: 1; height: 20; color: "#546E7A" }
+
+                Text {
+                    text: "Style:"
+                    color: "#B0BEC5"
+                    font.pixelSize: 12
+                }
+
+                ComboBox {
+                    id: styleSelector
+                    model: ["Material", "Fusion", "Basic", "Universal"]
+                    currentIndex: model.indexOf(currentStyle)
+                    implicitWidth: 120
+                    font.pixelSize: 12
+
+                    onActivated: function(index) {
+                        var style = model[index]
+                        outputText = "Style: " + style
+                        styleHelper.switchWithParams("style", style)
+                    }
+                }
+
+                Rectangle { width: 1; height: 20; color: "#546E7A" }
+
+                Text {
+                    text: qsTr("Sprache:")
+                    color: "#B0BEC5"
+                    font.pixelSize: 12
+                }
+
+                ComboBox {
+                    id: langSelector
+                    model: ["Deutsch", "English"]
+                    currentIndex: currentLang === "en" ? 1 : 0
+                    implicitWidth: 110
+                    font.pixelSize: 12
+
+                    onActivated: function(index) {
+                        var lang = index === 1 ? "en" : "de"
+                        outputText = "Sprache: " + model[index]
+                        styleHelper.switchWithParams("lang", lang)
+                    }
+                }
+            }
+        }
+    }
+
+    // ===== DIALOGE =====
+    // Werden erst beim ersten Öffnen erzeugt und danach wiederverwendet
+
+    property LoginDialog loginDialog: null
+    property ShutdownDialog shutdownDialog: null
+    property DetailDialog detailDialog: null
+    property ProductDialog productDialog: null
+    property ProductDeleteDialog productDeleteDialog: null
+
+    Component { id: loginDialogComponent;         LoginDialog { app: window } }
+    Component { id: shutdownDialogComponent;      ShutdownDialog { app: window } }
+    Component { id: detailDialogComponent;        DetailDialog { app: window } }
+    Component { id: productDialogComponent;       ProductDialog { app: window } }
+    Component { id: productDeleteDialogComponent; ProductDeleteDialog { app: window } }
+
+    function openLoginDialog(message) {
+        if (!loginDialog) loginDialog = loginDialogComponent.createObject(window.contentItem);
+        loginDialog.errorText = message;
+        loginDialog.open();
+    }
+
+    function openShutdownDialog() {
+        if (!shutdownDialog) shutdownDialog = shutdownDialogComponent.createObject(window.contentItem);
+        shutdownDialog.open();
+    }
+
+    function openDetailDialog(title, rowData) {
+        if (!detailDialog) detailDialog = detailDialogComponent.createObject(window.contentItem);
+        detailDialog.title = title;
+        detailDialog.rowData = rowData;
+        detailDialog.open();
+    }
+
+    // editId < 0 → neues Produkt
+    function openProductDialog(editId, data) {
+        if (!productDialog) productDialog = productDialogComponent.createObject(window.contentItem);
+        productDialog.edit(editId, data);
+    }
+
+    function openProductDeleteDialog() {
+        if (!productDeleteDialog) productDeleteDialog = productDeleteDialogComponent.createObject(window.contentItem);
+        productDeleteDialog.open();
+    }
+
+    // ===== JAVASCRIPT FUNKTIONEN =====
+
+    // Vom LoginDialog nach erfolgreicher Anmeldung
+    function loginSucceeded(token, username) {
+        authToken = token;
+        authUser = username;
+        outputText = "✓ " + qsTr("Angemeldet als: ") + authUser;
+        // Nach Login Startdaten in einem Batch-Request laden
+        loadInitialData();
+        startProductEvents();
+    }
+
+    // DB-Browser State
+    property var dbTables: []
+    property string selectedTable: ""
+    property string greetingMessage: qsTr("Lade...")
+    property string greetingStatus: ""
+
+    // Token für alle ApiClient-Requests
+    Binding {
+        target: apiClient
+        property: "token"
+        value: authToken
+    }
+
+    // Persistenter Cache getrennt je Benutzer
+    Binding {
+        target: apiClient
+        property: "cacheUser"
+        value: authUser
+    }
+
+    Connections {
+        target: apiClient
+        function onUnauthorized() { sessionExpired() }
+    }
+
+    // Helper: Auth-Header setzen (nur noch für den SSE-Stream per XHR)
+    function setAuthHeader(xhr) {
+        if (authToken !== "") {
+            xhr.setRequestHeader("Authorization", "Bearer " + authToken);
+        }
+    }
+
+    // Token abgelaufen → abmelden und Login-Dialog zeigen
+    function sessionExpired() {
+        if (!isLoggedIn) return;
+        authToken = "";
+        authUser = "";
+        stopProductEvents();
+        outputText = "✗ " + qsTr("Sitzung abgelaufen — bitte erneut anmelden");
+        openLoginDialog(qsTr("Sitzung abgelaufen"));
+    }
+
+    // Helper: 401-Handling für XHR
+    function handleAuthError(xhr) {
+        if (xhr.status === 401) {
+            sessionExpired();
+            return true;
+        }
+        return false;
+    }
+
+    // Startdaten (Greeting, Tabellen, Produkte) mit EINEM Roundtrip laden
+    function loadInitialData() {
+        if (!isLoggedIn) return;
+
+        greetingMessage = qsTr("Lade...");
+        greetingStatus = qsTr("Verbinde mit Backend...");
+        outputText = qsTr("Lade Startdaten...");
+
+        selectedProductId   = -1;
+        selectedProductData = null;
+
+        // Produkt-Ergebnis landet direkt im productListModel (ApiClient).
+        // "cache": Antwort wird persistent gespeichert und revalidiert
+        var requests = [
+            { id: "greeting", method: "GET", path: "/api/greeting", query: { lang: "de" } },
+            { id: "tables",   method: "GET", path: "/api/tables", cache: true },
+            { id: "products", method: "GET", path: "/api/products", cache: true,
+              query: { limit: String(productListModel.pageSize) } }
+        ];
+
+        // Zuerst den letzten Stand aus dem Cache zeigen …
+        apiClient.loadCached(requests, function(status, resp) {
+            if (status !== 200) return;
+            for (var i = 0; i < resp.results.length; i++) {
+                var r = resp.results[i];
+                if (r.id === "tables")        applyTables(r.body);
+                else if (r.id === "products") outputText = "✓ " + r.body.count + qsTr(" Produkte (Cache)");
+            }
+        });
+
+        // … dann beim Backend revalidieren (unverändert → 304, Anzeige bleibt)
+        apiClient.batch(requests, function(status, resp) {
+            if (status === 401) return;
+            if (status !== 200) {
+                // Fallback: Einzel-Requests
+                loadGreeting("de");
+                loadTables();
+                loadProducts();
+                return;
+            }
+            for (var i = 0; i < resp.results.length; i++) {
+                var r = resp.results[i];
+                if (r.status === 304) continue;
+                if (r.status !== 200) {
+                    outputText = "✗ " + r.id + ": HTTP " + r.status;
+                    continue;
+                }
+                if (r.id === "greeting")      applyGreeting(r.body);
+                else if (r.id === "tables")   applyTables(r.body);
+                else if (r.id === "products") outputText = "✓ " + r.body.count + qsTr(" Produkte geladen");
+            }
+        });
+    }
+
+    function applyGreeting(response) {
+        greetingMessage = response.message;
+        greetingStatus = qsTr("Geladen: ") + response.timestamp;
+        outputText = "✓ Greeting: " + response.message;
+    }
+
+    function applyTables(response) {
+        dbTables = response.tables;
+        outputText = "✓ " + dbTables.length + " Tabellen geladen";
+        if (dbTables.length > 0 && selectedTable === "") {
+            loadTableData(dbTables[0]);
+        }
+    }
+
+    function loadGreeting(language) {
+        if (!language) language = "de";
+        if (!isLoggedIn) return;
+
+        greetingMessage = qsTr("Lade...");
+        greetingStatus = qsTr("Verbinde mit Backend...");
+        outputText = qsTr("Lade Greeting (Sprache: ") + language + ")...";
+
+        apiClient.get("/api/greeting?lang=" + language, function(status, response) {
+            if (status === 401) return;
+            if (status === 200 && response) {
+                applyGreeting(response);
+            } else {
+                greetingMessage = qsTr("Fehler: ") + status;
+                greetingStatus = qsTr("Backend nicht erreichbar");
+                outputText = "✗ Backend Fehler: HTTP " + status;
+            }
+        });
+    }
+
+    function loadTables() {
+        if (!isLoggedIn) return;
+
+        // Mehrfachklicks: identische laufende GETs legt der ApiClient zusammen
+        apiClient.get("/api/tables", function(status, response) {
+            if (status === 200) applyTables(response);
+        });
+    }
+
+    function loadTableData(tableName) {
+        if (!isLoggedIn) return;
+        selectedTable = tableName;
+        tableDataModel.clear();
+        // Dekodiert im Worker-Thread direkt ins tableDataModel
+        apiClient.loadTableData(tableName, 5000);
+    }
+
+    Connections {
+        target: apiClient
+        function onTableDataLoaded(name, rows) {
+            outputText = "✓ " + name + ": " + rows + " Zeilen";
+        }
+        function onProductPageLoaded(count) {
+            outputText = "✓ " + count + qsTr(" Produkte geladen");
+        }
+        function onRequestFailed(path, status) {
+            if (status !== 401) outputText = "✗ " + path + ": HTTP " + status;
+        }
+    }
+
+    function shutdownServer() {
+        if (!isLoggedIn) return;
+        greetingStatus = qsTr("Sende Shutdown-Befehl...");
+        outputText = qsTr("Sende Shutdown-Befehl an Backend...");
+
+        apiClient.post("/api/shutdown", undefined, function(status, response) {
+            if (status === 401) return;
+            if (status === 200) {
+                greetingMessage = qsTr("Server wird beendet");
+                greetingStatus = qsTr("Shutdown erfolgreich");
+                outputText = "✓ Backend wird beendet...";
+            } else {
+                greetingStatus = qsTr("Shutdown-Fehler: ") + status;
+                outputText = "✗ Shutdown fehlgeschlagen: HTTP " + status;
+            }
+        });
+    }
+
+    // ===== PRODUKTE STATE =====
+    property int selectedProductId: -1
+    property var selectedProductData: null
+
+    // ===== PRODUKTE FUNKTIONEN =====
+
+    // Liste verwerfen und erste Seite anfordern — weitere Seiten holt sich
+    // die ListView beim Scrollen über fetchMore(); geladen wird vom ApiClient
+    function loadProducts() {
+        if (!isLoggedIn) return
+        outputText = qsTr("Lade Produkte...")
+        selectedProductId   = -1
+        selectedProductData = null
+        productListModel.reload()
+    }
+
+
+    function deleteProduct(productId) {
+        if (!isLoggedIn || productId < 0) return
+        outputText = qsTr("Lösche Produkt ID ") + productId + "..."
+
+        apiClient.deleteResource("/api/products/" + productId, function(status, response) {
+            if (status === 401) return
+            if (status === 200) {
+                outputText = "✓ Produkt gelöscht"
+                selectedProductId   = -1
+                selectedProductData = null
+                if (!productEventsConnected) loadProducts()
+            } else {
+                outputText = "✗ Löschen fehlgeschlagen: HTTP " + status
+            }
+        })
+    }
+
+    // ===== ÄNDERUNGSSTROM (SSE) =====
+
+    // Änderungen anderer Nutzer kommen per Server-Sent Events als Zeilen-Diffs
+    // ({op, id, row}) und werden direkt ins Modell übernommen — kein Neuladen
+    // der ganzen Liste. XHR statt EventSource, weil der Bearer-Header gesetzt
+    // werden muss; responseText wächst dabei inkrementell.
+    property var productEventsXhr: null
+    property bool productEventsConnected: false
+    property string lastProductEventId: ""
+
+    Timer {
+        id: productEventsRetry
+        interval: 3000
+        onTriggered: startProductEvents()
+    }
+
+    function startProductEvents() {
+        if (!isLoggedIn) return
+        stopProductEvents()
+
+        var xhr = new XMLHttpRequest()
+        var consumed = 0
+        var eventId = ""
+        var eventName = ""
+        var data = ""
+        productEventsXhr = xhr
+
+        xhr.open("GET", apiBaseUrl + "/api/products/events")
+        setAuthHeader(xhr)
+        xhr.setRequestHeader("Accept", "text/event-stream")
+        if (lastProductEventId !== "")
+            xhr.setRequestHeader("Last-Event-ID", lastProductEventId)
+
+        xhr.onreadystatechange = function() {
+            if (xhr !== productEventsXhr) return
+
+            if (xhr.readyState === XMLHttpRequest.LOADING || xhr.readyState === XMLHttpRequest.DONE) {
+                productEventsConnected = xhr.status === 200
+                var text = xhr.responseText
+                var end = text.lastIndexOf("\n")
+                if (xhr.status === 200 && end >= consumed) {
+                    var lines = text.substring(consumed, end).split("\n")
+                    consumed = end + 1
+                    for (var i = 0; i < lines.length; i++) {
+                        var line = lines[i]
+                        if (line === "") {
+                            // Leerzeile beendet ein Event
+                            if (eventName !== "") {
+                                if (eventId !== "") lastProductEventId = eventId
+                                handleProductEvent(eventName, data)
+                            }
+                            eventName = ""; data = ""
+                        } else if (line.indexOf("id: ") === 0) {
+                            eventId = line.substring(4)
+                        } else if (line.indexOf("event: ") === 0) {
+                            eventName = line.substring(7)
+                        } else if (line.indexOf("data: ") === 0) {
+                            data += line.substring(6)
+                        }
+                    }
+                    // responseText wächst unbegrenzt → gelegentlich neu verbinden
+                    // (Resume über Last-Event-ID, es geht nichts verloren)
+                    if (consumed > 4 * 1024 * 1024 && eventName === "") {
+                        startProductEvents()
+                        return
+                    }
+                }
+            }
+
+            if (xhr.readyState !== XMLHttpRequest.DONE) return
+            productEventsConnected = false
+            productEventsXhr = null
+            if (handleAuthError(xhr)) return
+            // Verbindung beendet (Server-Neustart, Proxy-Timeout) → neu verbinden
+            if (isLoggedIn) productEventsRetry.start()
+        }
+        xhr.send()
+    }
+
+    function stopProductEvents() {
+        productEventsRetry.stop()
+        if (productEventsXhr) {
+            var xhr = productEventsXhr
+            productEventsXhr = null
+            xhr.abort()
+        }
+        productEventsConnected = false
+    }
+
+    function handleProductEvent(name, data) {
+        if (name === "resync") {
+            // Events verpasst (Puffer übergelaufen, Backend-Reconnect) → komplett neu laden
+            loadProducts()
+            return
+        }
+        if (name !== "product") return
+
+        // Diff zeilenweise im Modell einspielen (insert/update/remove)
+        productListModel.applyChange(data)
+
+        if (selectedProductId >= 0) {
+            var idx = productListModel.indexOfProduct(selectedProductId)
+            if (idx < 0) {
+                selectedProductId   = -1
+                selectedProductData = null
+            } else {
+                selectedProductData = productListModel.get(idx)
+            }
+        }
+    }
+
+    // Beim Start Login-Dialog öffnen
+    Component.onCompleted: openLoginDialog("")
+}
@@ -0,0 +1,44 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== PRODUKT LÖSCH-BESTÄTIGUNG =====
+Dialog {
+    id: productDeleteDialog
+    required property Main app
+
+    title: qsTr("Produkt löschen?")
+    modal: true
+    anchors.centerIn: parent
+    width: 420
+
+    Label {
+        text: app.selectedProductData
+              ? qsTr("Möchten Sie folgendes Produkt wirklich löschen?\n\n")
+                + app.selectedProductData.product_number + " — " + app.selectedProductData.name
+              : ""
+        wrapMode: Text.WordWrap
+        width: parent.width
+    }
+
+    footer: DialogButtonBox {
+        Button {
+            text: qsTr("Löschen")
+            DialogButtonBox.buttonRole: DialogButtonBox.AcceptRole
+            background: Rectangle {
+                color: parent.pressed ? "#C62828" : (parent.hovered ? "#EF5350" : "#F44336")
+                radius: 4
+            }
+            contentItem: Text {
+                text: parent.text; font: parent.font; color: "white"
+                horizontalAlignment: Text.AlignHCenter; verticalAlignment: Text.AlignVCenter
+            }
+        }
+        Button {
+            text: qsTr("Abbrechen")
+            DialogButtonBox.buttonRole: DialogButtonBox.RejectRole
+        }
+    }
+
+    onAccepted: app.deleteProduct(app.selectedProductId)
+}
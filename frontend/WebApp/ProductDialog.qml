@@ -0,0 +1,449 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== PRODUKT EDIT DIALOG =====
+Dialog {
+    id: productDialog
+    required property Main app
+
+    title: editId < 0 ? qsTr("Neues Produkt") : qsTr("Produkt bearbeiten")
+    modal: true
+    anchors.centerIn: parent
+    width: 640
+    height: 680
+
+    property int editId: -1
+    // Zeile beim Öffnen — Basis für PATCH (nur Änderungen) und If-Match
+    property var original: null
+
+    // Beim Öffnen Dialog so groß wie möglich skalieren
+    onAboutToShow: {
+        var ov = Overlay.overlay
+        if (ov && ov.width > 0 && ov.height > 0) {
+            // Breite: Fensterbreite minus kleiner Rand
+            width = Math.min(1000, Math.max(480, ov.width - 40))
+
+            // Höhe: Formularinhalt + Dialog-Overhead (Titelzeile ~56px + Footer 64px + Padding ~48px)
+            var contentH = pfFormColumn.implicitHeight
+            var overhead = 56 + 64 + 48
+            var needed   = (contentH > 0 ? contentH : 750) + overhead
+            height = Math.min(Math.max(needed, 400), ov.height - 40)
+        }
+    }
+
+    function clearForm() {
+        pfNumber.text      = ""
+        pfGtin.text        = ""
+        pfName.text        = ""
+        pfUnit.currentIndex = 0
+        pfPurchase.text    = ""
+        pfSales.text       = ""
+        pfVat.currentIndex = 0
+        pfCatId.text       = ""
+        pfSuppId.text      = ""
+        pfDesc.text        = ""
+        pfActive.checked   = true
+        pfError.text       = ""
+    }
+
+    // editId < 0 → neues Produkt, sonst Formular mit p füllen
+    function edit(id, p) {
+        editId = id
+        original = p || null
+        if (p) fillForm(p)
+        else   clearForm()
+        open()
+    }
+
+    function saveProduct() {
+        if (!app.isLoggedIn) return
+
+        var salesText = pfSales.text.replace(",", ".")
+        var purchText = pfPurchase.text.replace(",", ".")
+
+        var payload = {
+            product_number: pfNumber.text,
+            gtin:           pfGtin.text === "" ? null : parseInt(pfGtin.text),
+            name:           pfName.text,
+            unit:           pfUnit.currentText,
+            purchase_price: purchText === "" ? null : parseFloat(purchText),
+            sales_price:    parseFloat(salesText),
+            vat_code:       pfVat.currentIndex === 0 ? 1 : 2,
+            category_id:    pfCatId.text === "" ? null : parseInt(pfCatId.text),
+            supplier_id:    pfSuppId.text === "" ? null : parseInt(pfSuppId.text),
+            description:    pfDesc.text === "" ? null : pfDesc.text,
+            active:         pfActive.checked ? 1 : 0
+        }
+
+        var isNew = editId < 0
+        var path  = "/api/products" + (isNew ? "" : "/" + editId)
+
+        var done = function(status, response) {
+            if (status === 401) return
+            if (status === 412) {
+                // Inzwischen von jemand anderem geändert → neuen Stand laden
+                pfError.text = "Das Produkt wurde inzwischen geändert. Bitte neu öffnen."
+                if (!app.productEventsConnected) app.loadProducts()
+                productDialog.open()
+                return
+            }
+            if (status === 200 || status === 201) {
+                app.outputText = isNew ? "✓ Produkt angelegt" : "✓ Produkt aktualisiert"
+                // Mit aktivem Änderungsstrom kommt die Zeile per Event
+                if (!app.productEventsConnected) app.loadProducts()
+            } else {
+                pfError.text = response && response.message ? response.message : "HTTP " + status
+                productDialog.open()
+            }
+        }
+
+        if (isNew) {
+            apiClient.post(path, payload, done)
+            return
+        }
+
+        // Nur geänderte Felder senden, Version als If-Match
+        var changes = {}
+        var changed = 0
+        for (var key in payload) {
+            if (!sameValue(payload[key], original ? original[key] : undefined)) {
+                changes[key] = payload[key]
+                ++changed
+            }
+        }
+        if (changed === 0) {
+            app.outputText = "✓ Keine Änderungen"
+            return
+        }
+        var ifMatch = original && original.row_version ? '"' + original.row_version + '"' : ""
+        apiClient.patch(path, changes, ifMatch, done)
+    }
+
+    function sameValue(a, b) {
+        if (a === undefined) a = null
+        if (b === undefined) b = null
+        if (a === null || b === null) return a === b
+        if (typeof a === "number" || typeof b === "number")
+            return Math.abs(Number(a) - Number(b)) < 1e-9
+        return String(a) === String(b)
+    }
+
+    function fillForm(p) {
+        pfNumber.text      = p.product_number || ""
+        pfGtin.text        = p.gtin !== null && p.gtin !== undefined ? String(p.gtin) : ""
+        pfName.text        = p.name || ""
+        var units = ["ST","KG"]
+        pfUnit.currentIndex = Math.max(0, units.indexOf(p.unit))
+        pfPurchase.text    = p.purchase_price !== null && p.purchase_price !== undefined
+                             ? Number(p.purchase_price).toFixed(2).replace('.', ',') : ""
+        pfSales.text       = p.sales_price !== undefined
+                             ? Number(p.sales_price).toFixed(2).replace('.', ',') : ""
+        pfVat.currentIndex = p.vat_code == 1 ? 0 : 1
+        pfCatId.text       = p.category_id !== null && p.category_id !== undefined ? String(p.category_id) : ""
+        pfSuppId.text      = p.supplier_id !== null && p.supplier_id !== undefined ? String(p.supplier_id) : ""
+        pfDesc.text        = p.description || ""
+        pfActive.checked   = p.active == 1
+        pfError.text       = ""
+    }
+
+    ScrollView {
+        id: pfScrollView
+        anchors.fill: parent
+        clip: true
+        ScrollBar.horizontal.policy: ScrollBar.AlwaysOff
+
+        ColumnLayout {
+            id: pfFormColumn
+            width: pfScrollView.width
+            spacing: 0
+
+            // Fehlermeldung
+            Rectangle {
+                id: pfErrorBox
+                Layout.fillWidth: true
+                Layout.bottomMargin: 8
+                height: pfError.implicitHeight + 14
+                color: "#FFEBEE"; border.color: "#F44336"; border.width: 1; radius: 4
+                visible: pfError.text !== ""
+                Text {
+                    id: pfError
+                    text: ""
+                    color: "#C62828"; font.pixelSize: 12
+                    anchors.centerIn: parent
+                    width: parent.width - 16
+                    wrapMode: Text.Wrap
+                    horizontalAlignment: Text.AlignHCenter
+                }
+            }
+
+            // ── Sektion: Stammdaten ──────────────────────────────────
+            Label {
+                text: qsTr("Stammdaten")
+                font.bold: true; font.pixelSize: 12
+                color: "#C62828"
+                Layout.topMargin: 2
+            }
+            Rectangle {
+                Layout.fillWidth: true; height: 1
+                color: "#FFCDD2"; Layout.bottomMargin: 10
+            }
+
+            GridLayout {
+                columns: 2
+                columnSpacing: 16; rowSpacing: 12
+                Layout.fillWidth: true
+                Layout.bottomMargin: 14
+
+                Label {
+                    text: qsTr("Art.-Nr. *"); font.bold: true
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                TextField {
+                    id: pfNumber
+                    placeholderText: "z.B. P001"
+                    Layout.fillWidth: true
+                    maximumLength: 20
+                }
+
+                Label {
+                    text: "GTIN"
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                TextField {
+                    id: pfGtin
+                    placeholderText: "14-stellige EAN"
+                    Layout.fillWidth: true
+                    inputMethodHints: Qt.ImhDigitsOnly
+                    validator: RegularExpressionValidator { regularExpression: /^\d{0,14}$/ }
+                }
+
+                Label {
+                    text: qsTr("Name *"); font.bold: true
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                TextField {
+                    id: pfName
+                    placeholderText: qsTr("Produktname")
+                    Layout.fillWidth: true
+                    maximumLength: 100
+                }
+
+                Label {
+                    text: qsTr("Einheit *"); font.bold: true
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                ComboBox {
+                    id: pfUnit
+                    model: ["ST", "KG"]
+                    Layout.preferredWidth: 140
+                }
+            }
+
+            // ── Sektion: Preise & Steuern ────────────────────────────
+            Label {
+                text: qsTr("Preise & Steuern")
+                font.bold: true; font.pixelSize: 12
+                color: "#C62828"
+            }
+            Rectangle {
+                Layout.fillWidth: true; height: 1
+                color: "#FFCDD2"; Layout.bottomMargin: 10
+            }
+
+            GridLayout {
+                columns: 2
+                columnSpacing: 16; rowSpacing: 12
+                Layout.fillWidth: true
+                Layout.bottomMargin: 14
+
+                Label {
+                    text: qsTr("EK-Preis €")
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                TextField {
+                    id: pfPurchase
+                    placeholderText: "0,00"
+                    Layout.preferredWidth: 160
+                    validator: RegularExpressionValidator { regularExpression: /^\d{0,8}(,\d{0,2})?$/ }
+                    inputMethodHints: Qt.ImhFormattedNumbersOnly
+                }
+
+                Label {
+                    text: qsTr("VK-Preis € *"); font.bold: true
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                TextField {
+                    id: pfSales
+                    placeholderText: "0,00"
+                    Layout.preferredWidth: 160
+                    validator: RegularExpressionValidator { regularExpression: /^\d{0,8}(,\d{0,2})?$/ }
+                    inputMethodHints: Qt.ImhFormattedNumbersOnly
+                }
+
+                Label {
+                    text: qsTr("MwSt.-Satz *"); font.bold: true
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                ComboBox {
+                    id: pfVat
+                    model: ["1 — ermäßigt (10%)", "2 — normal (20%)"]
+                    Layout.fillWidth: true
+                }
+            }
+
+            // ── Sektion: Klassifizierung ─────────────────────────────
+            Label {
+                text: qsTr("Klassifizierung")
+                font.bold: true; font.pixelSize: 12
+                color: "#C62828"
+            }
+            Rectangle {
+                Layout.fillWidth: true; height: 1
+                color: "#FFCDD2"; Layout.bottomMargin: 10
+            }
+
+            GridLayout {
+                columns: 2
+                columnSpacing: 16; rowSpacing: 12
+                Layout.fillWidth: true
+                Layout.bottomMargin: 14
+
+                Label {
+                    text: qsTr("Kategorie-ID")
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                TextField {
+                    id: pfCatId
+                    placeholderText: qsTr("optional")
+                    Layout.preferredWidth: 140
+                    inputMethodHints: Qt.ImhDigitsOnly
+                    validator: IntValidator { bottom: 1; top: 999999999 }
+                }
+
+                Label {
+                    text: qsTr("Lieferanten-ID")
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                TextField {
+                    id: pfSuppId
+                    placeholderText: qsTr("optional")
+                    Layout.preferredWidth: 140
+                    inputMethodHints: Qt.ImhDigitsOnly
+                    validator: IntValidator { bottom: 1; top: 999999999 }
+                }
+            }
+
+            // ── Sektion: Weitere Angaben ─────────────────────────────
+            Label {
+                text: qsTr("Weitere Angaben")
+                font.bold: true; font.pixelSize: 12
+                color: "#C62828"
+            }
+            Rectangle {
+                Layout.fillWidth: true; height: 1
+                color: "#FFCDD2"; Layout.bottomMargin: 10
+            }
+
+            GridLayout {
+                columns: 2
+                columnSpacing: 16; rowSpacing: 12
+                Layout.fillWidth: true
+
+                Label {
+                    text: qsTr("Beschreibung")
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignTop
+                    topPadding: 8
+                }
+                TextArea {
+                    id: pfDesc
+                    placeholderText: qsTr("Freitext, max. 500 Zeichen")
+                    wrapMode: TextArea.Wrap
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: 88
+                }
+
+                Label {
+                    text: qsTr("Aktiv")
+                    Layout.preferredWidth: 140; Layout.alignment: Qt.AlignVCenter
+                }
+                CheckBox {
+                    id: pfActive
+                    checked: true
+                    text: pfActive.checked ? qsTr("Ja") : qsTr("Nein")
+                }
+            }
+        }
+    }
+
+    // ── Fußleiste: Buttons + Resize-Griff ───────────────────────
+    footer: Item {
+        height: 64
+
+        RowLayout {
+            anchors.fill: parent
+            anchors.leftMargin: 12
+            anchors.rightMargin: 32
+            anchors.topMargin: 10
+            anchors.bottomMargin: 14
+            spacing: 8
+
+            Item { Layout.fillWidth: true }
+
+            Button {
+                text: productDialog.editId < 0 ? qsTr("Anlegen") : qsTr("Speichern")
+                highlighted: true
+                enabled: pfNumber.text !== "" && pfName.text !== "" && pfSales.text !== ""
+                onClicked: productDialog.accept()
+            }
+            Button {
+                text: qsTr("Abbrechen")
+                onClicked: productDialog.reject()
+            }
+        }
+
+        // Resize-Griff — rechte untere Ecke des Dialogs
+        Item {
+            anchors.right: parent.right
+            anchors.bottom: parent.bottom
+            width: 22; height: 22
+
+            Canvas {
+                anchors.fill: parent
+                onPaint: {
+                    var ctx = getContext("2d")
+                    ctx.strokeStyle = "#BDBDBD"
+                    ctx.lineWidth = 1.5
+                    ctx.lineCap = "round"
+                    for (var i = 0; i < 3; i++) {
+                        var o = i * 5 + 4
+                        ctx.beginPath()
+                        ctx.moveTo(width - o, height - 2)
+                        ctx.lineTo(width - 2, height - o)
+                        ctx.stroke()
+                    }
+                }
+            }
+
+            MouseArea {
+                anchors.fill: parent
+                cursorShape: Qt.SizeFDiagCursor
+                property real startX: 0
+                property real startY: 0
+
+                onPressed: function(mouse) {
+                    startX = mouse.x
+                    startY = mouse.y
+                }
+                onPositionChanged: function(mouse) {
+                    if (pressed) {
+                        productDialog.width  = Math.max(480, productDialog.width  + mouse.x - startX)
+                        productDialog.height = Math.max(360, productDialog.height + mouse.y - startY)
+                    }
+                }
+            }
+        }
+    }
+
+    onAccepted: saveProduct()
+}
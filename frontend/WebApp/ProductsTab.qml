@@ -0,0 +1,224 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== TAB 6: PRODUKTE =====
+Item {
+    required property Main app
+
+    ColumnLayout {
+        width: parent.width
+        spacing: 10
+
+        // Toolbar
+        GroupBox {
+            title: qsTr("Produkt-Verwaltung")
+            Layout.fillWidth: true
+
+            RowLayout {
+                spacing: 8
+
+                Button {
+                    text: qsTr("＋ Neu")
+                    highlighted: true
+                    onClicked: app.openProductDialog(-1, null)
+                }
+                Button {
+                    text: qsTr("✎ Bearbeiten")
+                    enabled: app.selectedProductId >= 0
+                    onClicked: app.openProductDialog(app.selectedProductId, app.selectedProductData)
+                }
+                Button {
+                    text: qsTr("✕ Löschen")
+                    enabled: app.selectedProductId >= 0
+                    background: Rectangle {
+                        color: parent.enabled
+                               ? (parent.pressed ? "#C62828" : (parent.hovered ? "#EF5350" : "#F44336"))
+                               : "#ccc"
+                        radius: 4
+                    }
+                    contentItem: Text {
+                        text: parent.text; font: parent.font
+                        color: parent.enabled ? "white" : "#888"
+                        horizontalAlignment: Text.AlignHCenter
+                        verticalAlignment: Text.AlignVCenter
+                    }
+                    onClicked: app.openProductDeleteDialog()
+                }
+
+                Item { Layout.fillWidth: true }
+
+                Text {
+                    text: productListModel.count + (productListModel.hasMore ? "+" : "")
+                          + qsTr(" Produkte")
+                    color: "#999"; font.pixelSize: 12
+                }
+
+                Button {
+                    text: qsTr("⟳ Aktualisieren")
+                    onClicked: app.loadProducts()
+                }
+            }
+        }
+
+        // Tabellen-Header
+        Rectangle {
+            Layout.fillWidth: true
+            height: 34
+            color: "#C62828"
+            radius: 4
+            visible: productListModel.count > 0
+
+            Row {
+                anchors.fill: parent
+                anchors.leftMargin: 10
+                anchors.rightMargin: 10
+
+                Repeater {
+                    model: [
+                        {label: "ID",        w: 50},
+                        {label: "Art.-Nr.",  w: 100},
+                        {label: "Name",      w: 260},
+                        {label: "Einheit",   w: 60},
+                        {label: "EK-Preis",  w: 80},
+                        {label: "VK-Preis",  w: 80},
+                        {label: "MwSt.",     w: 55},
+                        {label: "Aktiv",     w: 50}
+                    ]
+
+                    Text {
+                        width: modelData.w
+                        height: parent.height
+                        text: modelData.label
+                        color: "white"; font.bold: true; font.pixelSize: 12
+                        verticalAlignment: Text.AlignVCenter
+                    }
+                }
+            }
+        }
+
+        // Produktliste
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: 460
+            color: "white"
+            border.color: "#e0e0e0"
+            border.width: 1
+            radius: 4
+            clip: true
+
+            ListView {
+                id: productListView
+                anchors.fill: parent
+                clip: true
+                // C++-Modell: typisierte Zeilen, lädt beim Scrollen seitenweise nach
+                model: productListModel
+                reuseItems: true
+
+                delegate: Item {
+                    width: productListView.width
+                    height: 36
+
+                    // Rollen = Spaltennamen, für den Spalten-Repeater als Objekt
+                    property var pdata: model
+                    property bool isSelected: model.product_id === app.selectedProductId
+
+                    Rectangle {
+                        anchors.fill: parent
+                        color: isSelected ? "#FFEBEE"
+                               : (index % 2 === 0 ? "#FFFFFF" : "#FFF8F8")
+                        border.color: isSelected ? "#E57373" : "transparent"
+                        border.width: isSelected ? 1 : 0
+                    }
+
+                    Row {
+                        anchors.fill: parent
+                        anchors.leftMargin: 10
+                        anchors.rightMargin: 10
+
+                        Repeater {
+                            model: [
+                                {key: "product_id",     w: 50,  fmt: "int"},
+                                {key: "product_number", w: 100, fmt: "str"},
+                                {key: "name",           w: 260, fmt: "str"},
+                                {key: "unit",           w: 60,  fmt: "str"},
+                                {key: "purchase_price", w: 80,  fmt: "eur"},
+                                {key: "sales_price",    w: 80,  fmt: "eur"},
+                                {key: "vat_code",       w: 55,  fmt: "vat"},
+                                {key: "active",         w: 50,  fmt: "bool"}
+                            ]
+
+                            Text {
+                                width: modelData.w
+                                height: 36
+                                font.pixelSize: 12
+                                color: {
+                                    if (modelData.fmt === "eur") return "#4CAF50"
+                                    if (modelData.fmt === "bool") return pdata[modelData.key] == 1 ? "#4CAF50" : "#F44336"
+                                    return "#424242"
+                                }
+                                font.bold: modelData.fmt === "bool"
+                                verticalAlignment: Text.AlignVCenter
+                                elide: Text.ElideRight
+                                text: {
+                                    var v = pdata[modelData.key]
+                                    if (v === null || v === undefined) return "—"
+                                    if (modelData.fmt === "eur")  return "€ " + Number(v).toFixed(2)
+                                    if (modelData.fmt === "vat")  return v == 1 ? "7%" : "19%"
+                                    if (modelData.fmt === "bool") return v == 1 ? "✓ Ja" : "✗ Nein"
+                                    return String(v)
+                                }
+                            }
+                        }
+                    }
+
+                    MouseArea {
+                        anchors.fill: parent
+                        onClicked: {
+                            app.selectedProductId   = pdata.product_id
+                            app.selectedProductData = productListModel.get(index)
+                            app.outputText = "Produkt gewählt: " + pdata.name + " (ID " + pdata.product_id + ")"
+                        }
+                        onDoubleClicked: {
+                            app.selectedProductId   = pdata.product_id
+                            app.selectedProductData = productListModel.get(index)
+                            app.openProductDialog(pdata.product_id, app.selectedProductData)
+                        }
+                    }
+                }
+
+                footer: BusyIndicator {
+                    width: productListView.width
+                    height: productListModel.loading ? 36 : 0
+                    running: productListModel.loading
+                    visible: running
+                }
+
+                ScrollBar.vertical: ScrollBar {}
+            }
+
+            // Leer-Hinweis
+            Text {
+                anchors.centerIn: parent
+                text: qsTr("Keine Produkte geladen — bitte anmelden und 'Aktualisieren' klicken")
+                color: "#ccc"; font.pixelSize: 14; font.italic: true
+                visible: productListModel.count === 0 && !productListModel.loading
+            }
+        }
+
+        // API-Info
+        GroupBox {
+            title: qsTr("API Endpunkte (Produkte)")
+            Layout.fillWidth: true
+
+            ColumnLayout {
+                spacing: 2
+                Label { text: "GET    /api/products?after=&limit="; font.family: "monospace"; font.pixelSize: 11; color: "#2196F3" }
+                Label { text: "POST   /api/products";       font.family: "monospace"; font.pixelSize: 11; color: "#4CAF50" }
+                Label { text: "PUT    /api/products/{id}";  font.family: "monospace"; font.pixelSize: 11; color: "#FF9800" }
+                Label { text: "PATCH  /api/products/{id}";  font.family: "monospace"; font.pixelSize: 11; color: "#FF9800" }
+                Label { text: "DELETE /api/products/{id}";  font.family: "monospace"; font.pixelSize: 11; color: "#F44336" }
+            }
+        }
+    }
+}
@@ -0,0 +1,138 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== TAB 3: SELECTION =====
+Item {
+    required property Main app
+
+    ColumnLayout {
+        width: parent.width
+        spacing: 20
+
+        // ComboBox
+        GroupBox {
+            title: "ComboBox & Tumbler"
+            Layout.fillWidth: true
+
+            GridLayout {
+                columns: 2
+                columnSpacing: 20
+                rowSpacing: 15
+                width: parent.width
+
+                Label { text: "Einfach:" }
+                ComboBox {
+                    id: combo1
+                    model: ["Option 1", "Option 2", "Option 3", "Option 4"]
+                    Layout.fillWidth: true
+                    onCurrentTextChanged: app.outputText = "ComboBox: " + currentText + " (Index: " + currentIndex + ")"
+                }
+
+                Label { text: "Editierbar:" }
+                ComboBox {
+                    model: ["Deutschland", "Österreich", "Schweiz"]
+                    editable: true
+                    Layout.fillWidth: true
+                    onAccepted: app.outputText = "ComboBox editiert: " + editText
+                }
+
+                Label { text: "Tumbler:" }
+                Rectangle {
+                    Layout.preferredWidth: 70
+                    Layout.preferredHeight: 120
+                    border.color: "#E57373"
+                    border.width: 1
+                    radius: 6
+                    color: "#FFF5F5"
+                    clip: true
+
+                    Tumbler {
+                        id: tumbler1
+                        model: 24
+                        anchors.fill: parent
+                        anchors.margins: 2
+                        visibleItemCount: 5
+                        wrap: true
+
+                        delegate: Text {
+                            text: String(modelData).padStart(2, '0')
+                            font.pixelSize: index === tumbler1.currentIndex ? 18 : 14
+                            font.bold: index === tumbler1.currentIndex
+                            color: index === tumbler1.currentIndex ? "#C62828" : "#999"
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                            opacity: 1.0 - Math.abs(Tumbler.displacement) / (tumbler1.visibleItemCount / 2)
+                        }
+
+                        onCurrentIndexChanged: app.outputText = "Tumbler: " + currentIndex + " Uhr"
+                    }
+
+                    // Untere Markierungslinie
+                    Rectangle {
+                        anchors.horizontalCenter: parent.horizontalCenter
+                        width: parent.width - 10
+                        height: 1
+                        color: "#E57373"
+                        y: parent.height / 2 + 12
+                    }
+                }
+            }
+        }
+
+        // ListView
+        GroupBox {
+            title: "ListView"
+            Layout.fillWidth: true
+            Layout.preferredHeight: 250
+
+            ListView {
+                id: listView
+                anchors.fill: parent
+                clip: true
+
+                model: ListModel {
+                    ListElement { name: "Apple"; quantity: 5; price: 2.50 }
+                    ListElement { name: "Banana"; quantity: 12; price: 1.80 }
+                    ListElement { name: "Orange"; quantity: 8; price: 3.20 }
+                    ListElement { name: "Grape"; quantity: 20; price: 4.50 }
+                    ListElement { name: "Mango"; quantity: 3; price: 5.00 }
+                }
+
+                delegate: ItemDelegate {
+                    width: listView.width
+
+                    RowLayout {
+                        anchors.fill: parent
+                        anchors.margins: 10
+                        spacing: 20
+
+                        Text {
+                            text: name
+                            font.bold: true
+                            font.pixelSize: 16
+                            Layout.preferredWidth: 100
+                        }
+
+                        Text {
+                            text: "Menge: " + quantity
+                            color: "#666"
+                        }
+
+                        Item { Layout.fillWidth: true }
+
+                        Text {
+                            text: "€ " + price.toFixed(2)
+                            color: "#4CAF50"
+                            font.bold: true
+                        }
+                    }
+
+                    onClicked: app.outputText = "ListView Item: " + name + " (€" + price + ")"
+                }
+
+                ScrollBar.vertical: ScrollBar {}
+            }
+        }
+    }
+}
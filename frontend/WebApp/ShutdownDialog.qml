@@ -0,0 +1,33 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// ===== SHUTDOWN DIALOG (Ja/Nein) =====
+Dialog {
+    id: shutdownDialog
+    required property Main app
+
+    title: qsTr("Server beenden?")
+    modal: true
+    anchors.centerIn: parent
+    width: 400
+
+    Label {
+        text: qsTr("Möchten Sie das Qt-Backend wirklich beenden?\n\nDie Applikation ist danach nicht mehr funktionsfähig.")
+        wrapMode: Text.WordWrap
+        width: parent.width
+    }
+
+    footer: DialogButtonBox {
+        Button {
+            text: qsTr("Ja")
+            DialogButtonBox.buttonRole: DialogButtonBox.AcceptRole
+        }
+        Button {
+            text: qsTr("Nein")
+            DialogButtonBox.buttonRole: DialogButtonBox.RejectRole
+        }
+    }
+
+    onAccepted: app.shutdownServer()
+}
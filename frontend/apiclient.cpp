@@ -0,0 +1,423 @@
+#include "apiclient.h"
+#include "clientcache.h"
+#include "productlistmodel.h"
+#include "tabledatamodel.h"
+#include <QDebug>
+#include <QJSEngine>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QtConcurrent>
+
+// Obergrenze für gemerkte ETag-Bodies
+static const int EtagCacheBytes = 16 * 1024 * 1024;
+
+// Große Listen binär anfordern (Fehlerantworten bleiben JSON)
+static const QByteArray CborAccept = "application/cbor, application/json;q=0.5";
+
+// Ergebnis von POST /api/batch nach dem Dekodieren
+struct BatchResult
+{
+    QVariant data;
+    bool hasProducts = false;
+    int productsAfter = 0;
+    ProductPage products;
+};
+
+// Ein GET-Sub-Request eines Batches
+struct BatchSub
+{
+    QString cacheKey;
+    bool cacheable = false;
+    bool products = false;
+    int after = 0;
+};
+
+ApiClient::ApiClient(QJSEngine *engine, const QString &baseUrl, QObject *parent)
+    : QObject(parent), engine(engine), baseUrl(baseUrl)
+{
+    etagCache.setMaxCost(EtagCacheBytes);
+}
+
+void ApiClient::setProductModel(ProductListModel *model)
+{
+    if (productModel)
+        disconnect(productModel, nullptr, this, nullptr);
+    productModel = model;
+    if (productModel)
+        connect(productModel, &ProductListModel::fetchRequested, this, &ApiClient::fetchProductPage);
+}
+
+void ApiClient::setTableModel(TableDataModel *model)
+{
+    tableModel = model;
+}
+
+void ApiClient::setPersistentCache(ClientCache *cache)
+{
+    persistentCache = cache;
+}
+
+void ApiClient::setCacheUser(const QString &user)
+{
+    if (user == cacheUserName) return;
+    cacheUserName = user;
+    emit cacheUserChanged();
+}
+
+void ApiClient::setToken(const QString &token)
+{
+    if (token == bearerToken) return;
+    bearerToken = token;
+    // Gemerkte Antworten gehören zum alten Benutzer
+    etagCache.clear();
+    emit tokenChanged();
+}
+
+// ===== Transport =====
+
+void ApiClient::send(const QByteArray &method, const QString &path, const QByteArray &body, Handler handler,
+                     const QByteArray &accept, const QByteArray &ifMatch)
+{
+    const QString url = baseUrl + path;
+    const QString key = accept.isEmpty() ? url : url + '#' + QString::fromLatin1(accept);
+    const bool isGet = method == "GET";
+
+    if (isGet) {
+        // Gleicher GET schon unterwegs → nur anhängen
+        auto it = inFlight.find(key);
+        if (it != inFlight.end()) {
+            it->append(std::move(handler));
+            return;
+        }
+        inFlight.insert(key, { std::move(handler) });
+    }
+
+    QNetworkRequest request{QUrl(url)};
+    if (!bearerToken.isEmpty())
+        request.setRawHeader("Authorization", "Bearer " + bearerToken.toUtf8());
+    if (!accept.isEmpty())
+        request.setRawHeader("Accept", accept);
+    if (!isGet)
+        request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    if (!ifMatch.isEmpty())
+        request.setRawHeader("If-Match", ifMatch);
+    if (isGet) {
+        if (const CachedBody *cached = etagCache.object(key))
+            request.setRawHeader("If-None-Match", cached->etag);
+    }
+
+    QNetworkReply *reply = network.sendCustomRequest(request, method, body);
+    ++pending;
+    emit pendingRequestsChanged();
+
+    connect(reply, &QNetworkReply::finished, this,
+            [this, reply, key, path, isGet, handler = isGet ? Handler() : std::move(handler)]() {
+        reply->deleteLater();
+        --pending;
+        emit pendingRequestsChanged();
+
+        Response response;
+        response.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        response.body = reply->readAll();
+        response.contentType = reply->header(QNetworkRequest::ContentTypeHeader).toByteArray();
+
+        if (isGet && response.status == 304) {
+            if (const CachedBody *cached = etagCache.object(key)) {
+                response.status = 200;
+                response.body = cached->body;
+                response.contentType = cached->contentType;
+                response.notModified = true;
+            }
+        } else if (isGet && response.status == 200) {
+            const QByteArray etag = reply->rawHeader("ETag");
+            if (!etag.isEmpty())
+                etagCache.insert(key, new CachedBody{ etag, response.body, response.contentType },
+                                 qMax<qsizetype>(1, response.body.size()));
+        }
+
+        if (response.status == 401 && path != "/api/login")
+            emit unauthorized();
+        else if (response.status == 0)
+            qWarning() << "ApiClient:" << path << reply->errorString();
+
+        const QList<Handler> handlers = isGet ? inFlight.take(key) : QList<Handler>{ handler };
+        for (const Handler &h : handlers)
+            h(response);
+    });
+}
+
+template <typename Parse, typename Apply>
+void ApiClient::decodeAsync(const QByteArray &body, Parse parse, Apply apply)
+{
+    QtConcurrent::run(parse, body).then(this, apply);
+}
+
+quint64 ApiClient::keepCallback(const QJSValue &callback)
+{
+    const quint64 id = ++nextCallbackId;
+    callbacks.insert(id, callback);
+    return id;
+}
+
+void ApiClient::invokeCallback(quint64 id, int status, const QVariant &data)
+{
+    QJSValue callback = callbacks.take(id);
+    if (!callback.isCallable()) return;
+
+    QJSValue result = callback.call({ QJSValue(status), engine->toScriptValue(data) });
+    if (result.isError())
+        qWarning() << "ApiClient: Fehler im Callback:" << result.toString();
+}
+
+void ApiClient::deliverJson(const Response &response, const QJSValue &callback)
+{
+    if (!callback.isCallable()) return;
+
+    const quint64 id = keepCallback(callback);
+    const int status = response.status;
+    decodeAsync(response.body,
+                [](const QByteArray &body) { return QJsonDocument::fromJson(body).toVariant(); },
+                [this, id, status](const QVariant &data) { invokeCallback(id, status, data); });
+}
+
+void ApiClient::sendJson(const QByteArray &method, const QString &path, const QVariant &body, const QJSValue &callback,
+                         const QByteArray &ifMatch)
+{
+    const QByteArray payload = body.isValid()
+        ? QJsonDocument::fromVariant(body).toJson(QJsonDocument::Compact)
+        : QByteArray();
+    send(method, path, payload, [this, callback](const Response &r) { deliverJson(r, callback); },
+         QByteArray(), ifMatch);
+}
+
+// ===== Generische Requests =====
+
+void ApiClient::get(const QString &path, const QJSValue &callback)
+{
+    sendJson("GET", path, QVariant(), callback);
+}
+
+void ApiClient::post(const QString &path, const QVariant &body, const QJSValue &callback)
+{
+    sendJson("POST", path, body, callback);
+}
+
+void ApiClient::put(const QString &path, const QVariant &body, const QJSValue &callback)
+{
+    sendJson("PUT", path, body, callback);
+}
+
+void ApiClient::patch(const QString &path, const QVariant &body, const QString &ifMatch, const QJSValue &callback)
+{
+    sendJson("PATCH", path, body, callback, ifMatch.toUtf8());
+}
+
+void ApiClient::deleteResource(const QString &path, const QJSValue &callback)
+{
+    sendJson("DELETE", path, QVariant(), callback);
+}
+
+// ===== Modell-Requests =====
+
+// Sub-Request-Infos für Batch und Cache
+static QHash<QString, BatchSub> describeBatch(const QVariantList &requests, const QString &user)
+{
+    QHash<QString, BatchSub> subs;
+    for (const QVariant &v : requests) {
+        const QVariantMap r = v.toMap();
+        if (r.value("method", "GET").toString() != "GET") continue;
+
+        BatchSub sub;
+        const QString path = r.value("path").toString();
+        const QVariantMap query = r.value("query").toMap();
+        sub.products = path == "/api/products";
+        sub.after = query.value("after").toInt();
+        sub.cacheable = r.value("cache").toBool();
+
+        // QVariantMap ist sortiert → stabiler Schlüssel
+        QUrlQuery q;
+        for (auto it = query.cbegin(); it != query.cend(); ++it)
+            q.addQueryItem(it.key(), it.value().toString());
+        sub.cacheKey = user + ' ' + path + '?' + q.toString();
+
+        subs.insert(r.value("id").toString(), sub);
+    }
+    return subs;
+}
+
+// Läuft im Worker: Produkte als ProductPage herauslösen, Cache schreiben
+static BatchResult processBatch(QJsonObject doc, const QHash<QString, BatchSub> &subs, ClientCache *cache)
+{
+    QJsonArray results = doc["results"].toArray();
+
+    BatchResult out;
+    for (int i = 0; i < results.size(); ++i) {
+        QJsonObject res = results.at(i).toObject();
+        const auto sub = subs.constFind(res["id"].toString());
+        if (sub == subs.cend() || res["status"].toInt() != 200)
+            continue;
+
+        if (cache && sub->cacheable && res["etag"].isString()) {
+            cache->write(sub->cacheKey, res["etag"].toString().toUtf8(),
+                         QJsonDocument(res["body"].toObject()).toJson(QJsonDocument::Compact));
+        }
+
+        if (sub->products && !out.hasProducts) {
+            out.hasProducts = true;
+            out.productsAfter = sub->after;
+            out.products = ProductPage::fromJson(res["body"].toObject());
+            // Nur die Anzahl an QML, die Zeilen stehen im Modell
+            res["body"] = QJsonObject{ { "count", int(out.products.rows.size()) } };
+            results[i] = res;
+        }
+    }
+    doc["results"] = results;
+    out.data = doc.toVariantMap();
+    return out;
+}
+
+void ApiClient::applyBatch(quint64 callbackId, const BatchResult &result)
+{
+    if (result.hasProducts && productModel) {
+        if (result.productsAfter == 0)
+            productModel->clear();
+        productModel->appendPage(result.productsAfter, result.products);
+        emit productPageLoaded(productModel->count());
+    }
+    invokeCallback(callbackId, 200, result.data);
+}
+
+void ApiClient::batch(const QVariantList &requests, const QJSValue &callback)
+{
+    const QHash<QString, BatchSub> subs = describeBatch(requests, cacheUserName);
+
+    // Gecachte Einträge bedingt anfragen → unverändert = 304 ohne Body
+    QVariantList withEtags = requests;
+    if (persistentCache && persistentCache->isReady()) {
+        for (QVariant &v : withEtags) {
+            QVariantMap r = v.toMap();
+            const auto sub = subs.constFind(r.value("id").toString());
+            if (sub == subs.cend() || !sub->cacheable) continue;
+            const QByteArray etag = persistentCache->etag(sub->cacheKey);
+            if (!etag.isEmpty()) {
+                r.insert("ifNoneMatch", QString::fromUtf8(etag));
+                v = r;
+            }
+        }
+    }
+
+    const QByteArray payload = QJsonDocument(QJsonObject{
+        { "requests", QJsonArray::fromVariantList(withEtags) }
+    }).toJson(QJsonDocument::Compact);
+
+    send("POST", "/api/batch", payload, [this, callback, subs](const Response &r) {
+        if (r.status != 200) {
+            deliverJson(r, callback);
+            return;
+        }
+
+        const quint64 id = keepCallback(callback);
+        ClientCache *cache = persistentCache && persistentCache->isReady() ? persistentCache.data() : nullptr;
+        decodeAsync(r.body,
+                    [subs, cache](const QByteArray &body) {
+                        return processBatch(QJsonDocument::fromJson(body).object(), subs, cache);
+                    },
+                    [this, id](const BatchResult &result) {
+                        ++appliedBatches;
+                        applyBatch(id, result);
+                    });
+    });
+}
+
+void ApiClient::loadCached(const QVariantList &requests, const QJSValue &callback)
+{
+    if (!persistentCache || !persistentCache->isReady()) {
+        QJSValue cb = callback;
+        if (cb.isCallable()) cb.call({ QJSValue(404), QJSValue() });
+        return;
+    }
+
+    const QHash<QString, BatchSub> subs = describeBatch(requests, cacheUserName);
+    const quint64 id = keepCallback(callback);
+    const quint64 generation = appliedBatches;
+    ClientCache *cache = persistentCache.data();
+
+    // Wie eine Batch-Antwort aufbauen, nur aus dem lokalen Cache
+    QtConcurrent::run([subs, cache]() {
+        QJsonArray results;
+        for (auto it = subs.cbegin(); it != subs.cend(); ++it) {
+            if (!it->cacheable) continue;
+            const ClientCache::Entry e = cache->read(it->cacheKey);
+            if (!e.valid) continue;
+            results.append(QJsonObject{
+                { "id", it.key() },
+                { "status", 200 },
+                { "cached", true },
+                { "body", QJsonDocument::fromJson(e.body).object() }
+            });
+        }
+        return processBatch(QJsonObject{ { "results", results }, { "count", int(results.size()) } },
+                            subs, nullptr);
+    }).then(this, [this, id, generation](const BatchResult &result) {
+        // Frische Batch-Antwort war schneller → Cache-Stand verwerfen
+        if (generation != appliedBatches) {
+            callbacks.remove(id);
+            return;
+        }
+        applyBatch(id, result);
+    });
+}
+
+void ApiClient::loadTableData(const QString &name, int limit)
+{
+    requestedTable = name;
+    const QString path = "/api/table?name=" + QString::fromUtf8(QUrl::toPercentEncoding(name))
+                         + "&limit=" + QString::number(limit) + "&layout=columnar";
+
+    send("GET", path, {}, [this, name, path](const Response &r) {
+        if (r.status != 200) {
+            emit requestFailed(path, r.status);
+            return;
+        }
+        const bool cbor = r.isCbor();
+        decodeAsync(r.body,
+                    [cbor](const QByteArray &body) {
+                        return cbor ? TableData::fromCbor(body) : TableData::fromJson(body);
+                    },
+                    [this, name](TableData data) {
+                        // Inzwischen andere Tabelle gewählt → verwerfen
+                        if (!tableModel || name != requestedTable) return;
+                        const int rows = data.rows;
+                        tableModel->setTableData(std::move(data));
+                        emit tableDataLoaded(name, rows);
+                    });
+    }, CborAccept);
+}
+
+void ApiClient::fetchProductPage(int afterId, int limit)
+{
+    const QString path = QString("/api/products?after=%1&limit=%2").arg(afterId).arg(limit);
+
+    send("GET", path, {}, [this, afterId, path](const Response &r) {
+        if (r.status != 200) {
+            if (productModel) productModel->fetchFailed();
+            emit requestFailed(path, r.status);
+            return;
+        }
+        const bool cbor = r.isCbor();
+        decodeAsync(r.body,
+                    [cbor](const QByteArray &body) {
+                        return cbor ? ProductPage::fromCbor(body) : ProductPage::fromJson(body);
+                    },
+                    [this, afterId](const ProductPage &page) {
+                        if (!productModel) return;
+                        productModel->appendPage(afterId, page);
+                        emit productPageLoaded(productModel->count());
+                    });
+    }, CborAccept);
+}
@@ -0,0 +1,153 @@
+#ifndef APICLIENT_H
+#define APICLIENT_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QJSValue>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QPointer>
+#include <QString>
+#include <QVariant>
+#include <functional>
+
+class QJSEngine;
+class ClientCache;
+class ProductListModel;
+class TableDataModel;
+struct BatchResult;
+
+// HTTP-Client für das Backend (ersetzt XMLHttpRequest in QML)
+//
+// - Bearer-Token wird zentral an jeden Request gehängt; 401 → unauthorized()
+// - Identische GETs, die gerade unterwegs sind, werden zusammengelegt:
+//   ein Netzwerk-Request, alle Aufrufer bekommen dieselbe Antwort
+// - GET-Antworten mit ETag werden gemerkt und per If-None-Match
+//   revalidiert (304 → Body aus dem Speicher)
+// - JSON wird im Worker-Thread (QtConcurrent, in WASM der Pthread-Pool)
+//   dekodiert; Produkt- und Tabellendaten landen fertig typisiert in den
+//   Modellen, der GUI-Thread macht nur noch das Einfügen
+// - Produktseiten und Tabellendaten kommen als CBOR (Accept), Zahlen
+//   binär, dekodiert per QCborStreamReader ohne Zwischenobjekte
+// - Batch-Sub-Requests mit "cache": true werden persistent gespeichert
+//   (ClientCache) und beim nächsten Start sofort daraus angezeigt
+class ApiClient : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString token READ token WRITE setToken NOTIFY tokenChanged)
+    Q_PROPERTY(int pendingRequests READ pendingRequests NOTIFY pendingRequestsChanged)
+    // Benutzer als Präfix der Cache-Schlüssel (kein Zugriff auf fremde Daten)
+    Q_PROPERTY(QString cacheUser READ cacheUser WRITE setCacheUser NOTIFY cacheUserChanged)
+
+public:
+    ApiClient(QJSEngine *engine, const QString &baseUrl, QObject *parent = nullptr);
+
+    void setProductModel(ProductListModel *model);
+    void setTableModel(TableDataModel *model);
+    void setPersistentCache(ClientCache *cache);
+
+    QString token() const { return bearerToken; }
+    void setToken(const QString &token);
+
+    int pendingRequests() const { return pending; }
+
+    QString cacheUser() const { return cacheUserName; }
+    void setCacheUser(const QString &user);
+
+    // Generische Requests — callback(status, data), data = dekodiertes JSON
+    Q_INVOKABLE void get(const QString &path, const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void post(const QString &path, const QVariant &body, const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void put(const QString &path, const QVariant &body, const QJSValue &callback = QJSValue());
+    // Teil-Update; ifMatch = ETag der bekannten Version (412, wenn inzwischen geändert)
+    Q_INVOKABLE void patch(const QString &path, const QVariant &body, const QString &ifMatch = QString(),
+                           const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void deleteResource(const QString &path, const QJSValue &callback = QJSValue());
+
+    // POST /api/batch — Produkt-Ergebnisse gehen direkt ins Produktmodell,
+    // der Rest an den Callback (wie bei post())
+    // Gecachte Sub-Requests werden per ifNoneMatch revalidiert (304 = unverändert)
+    Q_INVOKABLE void batch(const QVariantList &requests, const QJSValue &callback = QJSValue());
+
+    // Dieselben Sub-Requests sofort aus dem persistenten Cache beantworten
+    // (Ergebnis wie bei batch(), fehlende Einträge fehlen im results-Array)
+    Q_INVOKABLE void loadCached(const QVariantList &requests, const QJSValue &callback = QJSValue());
+
+    // GET /api/table → Tabellenmodell
+    Q_INVOKABLE void loadTableData(const QString &name, int limit = 200);
+
+public slots:
+    // GET /api/products?after=…&limit=… → Produktmodell (an fetchRequested)
+    void fetchProductPage(int afterId, int limit);
+
+signals:
+    void tokenChanged();
+    void cacheUserChanged();
+    void pendingRequestsChanged();
+    void unauthorized();
+
+    void tableDataLoaded(const QString &name, int rows);
+    void productPageLoaded(int count);
+    void requestFailed(const QString &path, int status);
+
+private:
+    struct Response {
+        int status = 0;
+        QByteArray body;
+        QByteArray contentType;
+        bool notModified = false;
+
+        bool isCbor() const { return contentType.startsWith("application/cbor"); }
+    };
+    using Handler = std::function<void(const Response &)>;
+
+    struct CachedBody {
+        QByteArray etag;
+        QByteArray body;
+        QByteArray contentType;
+    };
+
+    // accept leer = JSON; Coalescing und ETag-Cache je URL + Accept
+    void send(const QByteArray &method, const QString &path, const QByteArray &body, Handler handler,
+              const QByteArray &accept = QByteArray(), const QByteArray &ifMatch = QByteArray());
+    void sendJson(const QByteArray &method, const QString &path, const QVariant &body, const QJSValue &callback,
+                  const QByteArray &ifMatch = QByteArray());
+
+    // JSON im Worker dekodieren und an den QML-Callback geben
+    void deliverJson(const Response &response, const QJSValue &callback);
+
+    // QJSValue darf den GUI-Thread nicht verlassen → nur IDs in Continuations
+    quint64 keepCallback(const QJSValue &callback);
+    void invokeCallback(quint64 id, int status, const QVariant &data);
+    void applyBatch(quint64 callbackId, const BatchResult &result);
+
+    // parse() läuft im Thread-Pool, apply() danach im GUI-Thread
+    template <typename Parse, typename Apply>
+    void decodeAsync(const QByteArray &body, Parse parse, Apply apply);
+
+    QJSEngine *engine;
+    QString baseUrl;
+    QString bearerToken;
+    QNetworkAccessManager network;
+
+    QPointer<ProductListModel> productModel;
+    QPointer<TableDataModel> tableModel;
+    QString requestedTable;
+
+    QPointer<ClientCache> persistentCache;
+    QString cacheUserName;
+    quint64 appliedBatches = 0;
+
+    QHash<quint64, QJSValue> callbacks;
+    quint64 nextCallbackId = 0;
+
+    // Laufende GETs (URL + Accept → wartende Aufrufer)
+    QHash<QString, QList<Handler>> inFlight;
+    int pending = 0;
+
+    // ETag + Body je URL + Accept, Kosten = Bytes
+    QCache<QString, CachedBody> etagCache;
+};
+
+#endif // APICLIENT_H
@@ -0,0 +1,72 @@
+#ifndef CBORREADER_H
+#define CBORREADER_H
+
+#include <QCborStreamReader>
+#include <QString>
+#include <QVariant>
+
+// Hilfen für CBOR-Antworten des Backends (Accept: application/cbor)
+//
+// Gelesen wird direkt mit QCborStreamReader, ohne QCborValue-Baum: die
+// Decoder in den Modellen gehen Map für Map durch und übernehmen jeden
+// Wert sofort in ihre typisierten Strukturen.
+namespace Cbor {
+
+// Tags (z.B. 0 = Datum/Zeit als String) überspringen → getaggter Wert
+inline void skipTags(QCborStreamReader &reader)
+{
+    while (reader.isTag() && reader.next()) {}
+}
+
+// Aktuellen Wert lesen und weiterrücken. NULL → ungültiges QVariant,
+// Container werden komplett übersprungen (ebenfalls ungültig).
+inline QVariant readValue(QCborStreamReader &reader)
+{
+    skipTags(reader);
+
+    QVariant value;
+    switch (reader.type()) {
+    case QCborStreamReader::UnsignedInteger:
+    case QCborStreamReader::NegativeInteger:
+        value = reader.toInteger();
+        reader.next();
+        break;
+    case QCborStreamReader::Float16:
+        value = double(reader.toFloat16());
+        reader.next();
+        break;
+    case QCborStreamReader::Float:
+        value = double(reader.toFloat());
+        reader.next();
+        break;
+    case QCborStreamReader::Double:
+        value = reader.toDouble();
+        reader.next();
+        break;
+    case QCborStreamReader::String:
+        value = reader.readAllString();
+        break;
+    case QCborStreamReader::ByteArray:
+        value = reader.readAllByteArray();
+        break;
+    case QCborStreamReader::SimpleType:
+        if (reader.isBool())
+            value = reader.toBool();
+        reader.next();
+        break;
+    default:
+        reader.next();
+        break;
+    }
+    return value;
+}
+
+// Map-Schlüssel (immer Text beim Backend)
+inline QString readKey(QCborStreamReader &reader)
+{
+    return reader.isString() ? reader.readAllString() : readValue(reader).toString();
+}
+
+} // namespace Cbor
+
+#endif // CBORREADER_H
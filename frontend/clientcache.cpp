@@ -0,0 +1,138 @@
+#include "clientcache.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+// Dateiformat: Magic, Version, ETag, Body (QDataStream)
+static const quint32 CacheMagic = 0x57414343;   // "WACC"
+static const quint16 CacheVersion = 1;
+
+// IndexedDB nicht bei jedem Schreibzugriff synchronisieren
+static const int SyncDelayMs = 1000;
+
+ClientCache::ClientCache(QObject *parent)
+    : QObject(parent)
+{
+    syncTimer.setSingleShot(true);
+    syncTimer.setInterval(SyncDelayMs);
+    connect(&syncTimer, &QTimer::timeout, this, &ClientCache::flush);
+
+#ifdef __EMSCRIPTEN__
+    directory = "/webapp-cache";
+    EM_ASM({
+        var dir = UTF8ToString($0);
+        try { FS.mkdir(dir); } catch (e) {}
+        FS.mount(IDBFS, {}, dir);
+        Module.webappCacheReady = false;
+        FS.syncfs(true, function(err) {
+            if (err) console.warn("ClientCache: IndexedDB nicht lesbar", err);
+            Module.webappCacheReady = true;
+        });
+    }, directory.toUtf8().constData());
+
+    // syncfs ist asynchron — Fertigmeldung im Event-Loop abholen
+    readyPoll.setInterval(20);
+    connect(&readyPoll, &QTimer::timeout, this, [this]() {
+        if (!EM_ASM_INT({ return Module.webappCacheReady ? 1 : 0; })) return;
+        readyPoll.stop();
+        readyFlag = true;
+        emit ready();
+    });
+    readyPoll.start();
+#else
+    directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/api";
+    QDir().mkpath(directory);
+    readyFlag = true;
+    QMetaObject::invokeMethod(this, &ClientCache::ready, Qt::QueuedConnection);
+#endif
+}
+
+bool ClientCache::isReady() const
+{
+    return readyFlag;
+}
+
+QString ClientCache::fileFor(const QString &key) const
+{
+    return directory + '/' + QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex() + ".bin";
+}
+
+ClientCache::Entry ClientCache::readFile(const QString &key, bool withBody) const
+{
+    Entry e;
+    if (!readyFlag) return e;
+
+    QFile file(fileFor(key));
+    if (!file.open(QIODevice::ReadOnly)) return e;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != CacheMagic || version != CacheVersion) return e;
+
+    in >> e.etag;
+    if (withBody)
+        in >> e.body;
+    e.valid = in.status() == QDataStream::Ok && !e.etag.isEmpty();
+    return e;
+}
+
+ClientCache::Entry ClientCache::read(const QString &key) const
+{
+    return readFile(key, true);
+}
+
+QByteArray ClientCache::etag(const QString &key) const
+{
+    return readFile(key, false).etag;
+}
+
+void ClientCache::write(const QString &key, const QByteArray &etag, const QByteArray &body)
+{
+    if (!readyFlag) return;
+
+    QSaveFile file(fileFor(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "ClientCache: Schreiben fehlgeschlagen:" << file.errorString();
+        return;
+    }
+    QDataStream out(&file);
+    out << CacheMagic << CacheVersion << etag << body;
+    if (!file.commit()) {
+        qWarning() << "ClientCache: Schreiben fehlgeschlagen:" << file.errorString();
+        return;
+    }
+
+    // Timer gehört dem GUI-Thread
+    QMetaObject::invokeMethod(&syncTimer, qOverload<>(&QTimer::start), Qt::QueuedConnection);
+}
+
+void ClientCache::clear()
+{
+    QDir dir(directory);
+    const QStringList files = dir.entryList({ "*.bin" }, QDir::Files);
+    for (const QString &f : files)
+        dir.remove(f);
+    syncTimer.start();
+}
+
+void ClientCache::flush()
+{
+#ifdef __EMSCRIPTEN__
+    EM_ASM({
+        FS.syncfs(false, function(err) {
+            if (err) console.warn("ClientCache: IndexedDB nicht schreibbar", err);
+        });
+    });
+#endif
+}
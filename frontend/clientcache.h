@@ -0,0 +1,56 @@
+#ifndef CLIENTCACHE_H
+#define CLIENTCACHE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QTimer>
+#include <atomic>
+
+// Persistenter Antwort-Cache (ETag + Body je Schlüssel)
+//
+// Desktop: Dateien unter QStandardPaths::CacheLocation.
+// WASM: IDBFS unter /webapp-cache — beim Start wird IndexedDB per
+// FS.syncfs(true) ins Dateisystem geladen, nach Schreibzugriffen
+// (gebündelt) per FS.syncfs(false) zurückgeschrieben.
+//
+// read()/write() sind thread-sicher (reine Datei-Operationen) und
+// werden vom ApiClient im Worker-Thread aufgerufen.
+class ClientCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Entry {
+        QByteArray etag;
+        QByteArray body;
+        bool valid = false;
+    };
+
+    explicit ClientCache(QObject *parent = nullptr);
+
+    // WASM: erst nach dem Laden aus IndexedDB verwendbar
+    bool isReady() const;
+
+    Entry read(const QString &key) const;
+    QByteArray etag(const QString &key) const;
+    void write(const QString &key, const QByteArray &etag, const QByteArray &body);
+    void clear();
+
+signals:
+    void ready();
+
+private slots:
+    void flush();
+
+private:
+    QString fileFor(const QString &key) const;
+    Entry readFile(const QString &key, bool withBody) const;
+
+    QString directory;
+    std::atomic<bool> readyFlag { false };
+    QTimer syncTimer;
+    QTimer readyPoll;
+};
+
+#endif // CLIENTCACHE_H
@@ -1,25 +1,42 @@
-QT += quick qml quickcontrols2
+QT += quick qml quickcontrols2 network concurrent
 
 CONFIG += c++17
 
+# QML zur Build-Zeit mit qmlcachegen kompilieren (Bytecode + AOT-C++ für
+# typisierte Bindings) statt beim Start zu parsen. qmltc (QML → C++-Klassen)
+# gibt es nur mit CMake (qt_target_compile_qml_to_cpp), nicht mit qmake.
+CONFIG += qtquickcompiler
+
 # WebAssembly spezifisch
+# Pthread-Pool: ApiClient dekodiert JSON per QtConcurrent im Worker
+# IDBFS: ClientCache persistiert in IndexedDB
 wasm {
     QMAKE_WASM_PTHREAD_POOL_SIZE = 4
+    QMAKE_LFLAGS += -lidbfs.js
 }
 
 # Source Files
 SOURCES += \
-    main.cpp
+    main.cpp \
+    apiclient.cpp \
+    clientcache.cpp \
+    productlistmodel.cpp \
+    tabledatamodel.cpp
 
 # Header Files
 HEADERS += \
-    stylehelper.h
-
-# QML Files
+    stylehelper.h \
+    apiclient.h \
+    cborreader.h \
+    clientcache.h \
+    productlistmodel.h \
+    tabledatamodel.h
+
+# QML Files (Modul WebApp unter qrc:/qt/qml/WebApp)
 RESOURCES += qml.qrc
 
 # Additional import path used to resolve QML modules
-QML_IMPORT_PATH =
+QML_IMPORT_PATH = $$PWD
 
 # Additional import path used to resolve QML modules just for Qt Quick Designer
 QML_DESIGNER_IMPORT_PATH =
@@ -1,18 +1,48 @@
 #include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
 #include <QQuickStyle>
+#include <QQuickWindow>
 #include <QUrl>
 #include <QUrlQuery>
 #include <QTranslator>
 #include "stylehelper.h"
+#include "apiclient.h"
+#include "clientcache.h"
+#include "productlistmodel.h"
+#include "tabledatamodel.h"
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #endif
 
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+// Speicherverbrauch für die Startmessung (WASM: Heap, Linux: RSS)
+static qint64 memoryUsageBytes()
+{
+#ifdef __EMSCRIPTEN__
+    return EM_ASM_INT({ return HEAP8.length; });
+#elif defined(Q_OS_LINUX)
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    return fields.size() > 1 ? fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE) : -1;
+#else
+    return -1;
+#endif
+}
+
 int main(int argc, char *argv[])
 {
+    // Time-to-first-frame: ab Programmstart bis zum ersten gezeigten Frame
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     QGuiApplication app(argc, argv);
 
     app.setOrganizationName("WebApp");
@@ -85,20 +115,54 @@ int main(int argc, char *argv[])
     QString apiBaseUrl = "http://localhost:3000";
 #endif
     StyleHelper styleHelper;
+    ProductListModel productListModel;
+    TableDataModel tableDataModel;
+
+    // Netzwerk + JSON-Dekodierung in C++ (Worker-Threads), Daten direkt in die Modelle
+    ApiClient apiClient(&engine, apiBaseUrl);
+    apiClient.setProductModel(&productListModel);
+    apiClient.setTableModel(&tableDataModel);
+
+    // Letzte Antworten überleben den Neustart (WASM: IndexedDB)
+    ClientCache clientCache;
+    apiClient.setPersistentCache(&clientCache);
+
     engine.rootContext()->setContextProperty("apiBaseUrl", apiBaseUrl);
     engine.rootContext()->setContextProperty("currentStyle", styleName);
     engine.rootContext()->setContextProperty("currentLang", langCode);
     engine.rootContext()->setContextProperty("styleHelper", &styleHelper);
+    engine.rootContext()->setContextProperty("productListModel", &productListModel);
+    engine.rootContext()->setContextProperty("tableDataModel", &tableDataModel);
+    engine.rootContext()->setContextProperty("apiClient", &apiClient);
 
-    const QUrl url(QStringLiteral("qrc:/main.qml"));
+    QObject::connect(&engine, &QQmlApplicationEngine::objectCreationFailed,
+                     &app, []() { QCoreApplication::exit(-1); }, Qt::QueuedConnection);
 
+    // Erster Frame → Startzeit und Speicher loggen (Vergleichswert für
+    // Änderungen an QML-Struktur und Lazy-Loading)
     QObject::connect(&engine, &QQmlApplicationEngine::objectCreated,
-                     &app, [url](QObject *obj, const QUrl &objUrl) {
-        if (!obj && url == objUrl)
-            QCoreApplication::exit(-1);
-    }, Qt::QueuedConnection);
+                     &app, [&startupTimer](QObject *obj, const QUrl &) {
+        auto *window = qobject_cast<QQuickWindow *>(obj);
+        if (!window) return;
+        const qint64 createdMs = startupTimer.elapsed();
+        QObject::connect(window, &QQuickWindow::frameSwapped, window, [&startupTimer, createdMs]() {
+            const qint64 memory = memoryUsageBytes();
+#ifdef __EMSCRIPTEN__
+            // Inkl. Download + Kompilieren des WASM-Moduls (ab Navigation)
+            const double pageMs = EM_ASM_DOUBLE({ return performance.now(); });
+            qInfo().nospace() << "Startup: QML erzeugt nach " << createdMs << " ms, erster Frame nach "
+                              << startupTimer.elapsed() << " ms (ab Seitenaufruf " << qRound64(pageMs)
+                              << " ms), Speicher " << memory / (1024 * 1024) << " MB";
+#else
+            qInfo().nospace() << "Startup: QML erzeugt nach " << createdMs << " ms, erster Frame nach "
+                              << startupTimer.elapsed() << " ms, Speicher "
+                              << (memory < 0 ? QStringLiteral("?") : QString::number(memory / (1024 * 1024))) << " MB";
+#endif
+        }, Qt::SingleShotConnection);
+    });
 
-    engine.load(url);
+    // QML-Modul WebApp (WebApp/qmldir, vorkompiliert per qmlcachegen)
+    engine.loadFromModule("WebApp", "Main");
 
     return app.exec();
 }
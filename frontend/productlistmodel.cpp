@@ -0,0 +1,369 @@
+#include "productlistmodel.h"
+#include "cborreader.h"
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+
+// ===== ProductRow =====
+
+static std::optional<qint64> optInt64(const QJsonValue &v)
+{
+    if (v.isNull() || v.isUndefined()) return std::nullopt;
+    return v.toVariant().toLongLong();
+}
+
+static std::optional<int> optInt(const QJsonValue &v)
+{
+    if (v.isNull() || v.isUndefined()) return std::nullopt;
+    return v.toVariant().toInt();
+}
+
+static std::optional<double> optDouble(const QJsonValue &v)
+{
+    // numeric kommt je nach Treiber als Zahl oder String
+    if (v.isNull() || v.isUndefined()) return std::nullopt;
+    return v.toVariant().toDouble();
+}
+
+template <typename T>
+static std::optional<T> optValue(const QVariant &v)
+{
+    if (!v.isValid()) return std::nullopt;
+    return v.value<T>();
+}
+
+template <typename T>
+static QVariant toVariant(const std::optional<T> &v)
+{
+    return v ? QVariant::fromValue(*v) : QVariant();
+}
+
+ProductRow ProductRow::fromJson(const QJsonObject &obj)
+{
+    ProductRow r;
+    r.productId     = obj["product_id"].toVariant().toInt();
+    r.productNumber = obj["product_number"].toString();
+    r.gtin          = optInt64(obj["gtin"]);
+    r.name          = obj["name"].toString();
+    r.unit          = obj["unit"].toString();
+    r.categoryId    = optInt(obj["category_id"]);
+    r.supplierId    = optInt(obj["supplier_id"]);
+    r.purchasePrice = optDouble(obj["purchase_price"]);
+    r.salesPrice    = obj["sales_price"].toVariant().toDouble();
+    r.vatCode       = obj["vat_code"].toVariant().toInt();
+    r.description   = obj["description"].toString();
+    r.active        = obj["active"].toVariant().toInt();
+    r.createdAt     = QDateTime::fromString(obj["created_at"].toString(), Qt::ISODateWithMs);
+    r.updatedAt     = QDateTime::fromString(obj["updated_at"].toString(), Qt::ISODateWithMs);
+    r.updatedBy     = obj["updated_by"].toString();
+    r.rowVersion    = obj["row_version"].toVariant().toLongLong();
+    return r;
+}
+
+ProductRow ProductRow::fromCbor(QCborStreamReader &reader)
+{
+    ProductRow r;
+    if (!reader.isMap() || !reader.enterContainer()) {
+        reader.next();
+        return r;
+    }
+
+    while (reader.hasNext()) {
+        const QString key = Cbor::readKey(reader);
+        const QVariant v = Cbor::readValue(reader);
+
+        if      (key == u"product_id")     r.productId     = v.toInt();
+        else if (key == u"product_number") r.productNumber = v.toString();
+        else if (key == u"gtin")           r.gtin          = optValue<qint64>(v);
+        else if (key == u"name")           r.name          = v.toString();
+        else if (key == u"unit")           r.unit          = v.toString();
+        else if (key == u"category_id")    r.categoryId    = optValue<int>(v);
+        else if (key == u"supplier_id")    r.supplierId    = optValue<int>(v);
+        else if (key == u"purchase_price") r.purchasePrice = optValue<double>(v);
+        else if (key == u"sales_price")    r.salesPrice    = v.toDouble();
+        else if (key == u"vat_code")       r.vatCode       = v.toInt();
+        else if (key == u"description")    r.description   = v.toString();
+        else if (key == u"active")         r.active        = v.toInt();
+        else if (key == u"created_at")     r.createdAt     = QDateTime::fromString(v.toString(), Qt::ISODateWithMs);
+        else if (key == u"updated_at")     r.updatedAt     = QDateTime::fromString(v.toString(), Qt::ISODateWithMs);
+        else if (key == u"updated_by")     r.updatedBy     = v.toString();
+        else if (key == u"row_version")    r.rowVersion    = v.toLongLong();
+    }
+    reader.leaveContainer();
+    return r;
+}
+
+// ===== ProductPage =====
+
+ProductPage ProductPage::fromJson(const QByteArray &json)
+{
+    return fromJson(QJsonDocument::fromJson(json).object());
+}
+
+ProductPage ProductPage::fromJson(const QJsonObject &resp)
+{
+    const QJsonArray products = resp["products"].toArray();
+
+    ProductPage page;
+    page.rows.reserve(products.size());
+    for (const QJsonValue &v : products)
+        page.rows.append(ProductRow::fromJson(v.toObject()));
+    if (!page.rows.isEmpty())
+        page.lastId = page.rows.last().productId;
+    page.hasMore = resp["hasMore"].toBool();
+    return page;
+}
+
+ProductPage ProductPage::fromCbor(const QByteArray &cbor)
+{
+    ProductPage page;
+    QCborStreamReader reader(cbor);
+    if (!reader.isMap() || !reader.enterContainer())
+        return page;
+
+    while (reader.hasNext()) {
+        const QString key = Cbor::readKey(reader);
+        if (key == u"products" && reader.isArray()) {
+            if (reader.isLengthKnown())
+                page.rows.reserve(qsizetype(reader.length()));
+            reader.enterContainer();
+            while (reader.hasNext())
+                page.rows.append(ProductRow::fromCbor(reader));
+            reader.leaveContainer();
+        } else if (key == u"hasMore") {
+            page.hasMore = Cbor::readValue(reader).toBool();
+        } else {
+            reader.next();
+        }
+    }
+    reader.leaveContainer();
+
+    if (reader.lastError() != QCborError::NoError) {
+        qWarning() << "ProductPage: CBOR fehlerhaft:" << reader.lastError().toString();
+        return ProductPage();
+    }
+    if (!page.rows.isEmpty())
+        page.lastId = page.rows.last().productId;
+    return page;
+}
+
+// ===== ProductListModel =====
+
+ProductListModel::ProductListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int ProductListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(rows.size());
+}
+
+QVariant ProductListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows.size()) return QVariant();
+
+    const ProductRow &r = rows.at(index.row());
+    switch (role) {
+    case ProductIdRole:     return r.productId;
+    case ProductNumberRole: return r.productNumber;
+    case GtinRole:          return toVariant(r.gtin);
+    case Qt::DisplayRole:
+    case NameRole:          return r.name;
+    case UnitRole:          return r.unit;
+    case CategoryIdRole:    return toVariant(r.categoryId);
+    case SupplierIdRole:    return toVariant(r.supplierId);
+    case PurchasePriceRole: return toVariant(r.purchasePrice);
+    case SalesPriceRole:    return r.salesPrice;
+    case VatCodeRole:       return r.vatCode;
+    case DescriptionRole:   return r.description.isNull() ? QVariant() : QVariant(r.description);
+    case ActiveRole:        return r.active;
+    case CreatedAtRole:     return r.createdAt;
+    case UpdatedAtRole:     return r.updatedAt;
+    case UpdatedByRole:     return r.updatedBy.isNull() ? QVariant() : QVariant(r.updatedBy);
+    case RowVersionRole:    return r.rowVersion;
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> ProductListModel::roleNames() const
+{
+    static const QHash<int, QByteArray> names {
+        { ProductIdRole,     "product_id" },
+        { ProductNumberRole, "product_number" },
+        { GtinRole,          "gtin" },
+        { NameRole,          "name" },
+        { UnitRole,          "unit" },
+        { CategoryIdRole,    "category_id" },
+        { SupplierIdRole,    "supplier_id" },
+        { PurchasePriceRole, "purchase_price" },
+        { SalesPriceRole,    "sales_price" },
+        { VatCodeRole,       "vat_code" },
+        { DescriptionRole,   "description" },
+        { ActiveRole,        "active" },
+        { CreatedAtRole,     "created_at" },
+        { UpdatedAtRole,     "updated_at" },
+        { UpdatedByRole,     "updated_by" },
+        { RowVersionRole,    "row_version" }
+    };
+    return names;
+}
+
+bool ProductListModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && more && !loading;
+}
+
+void ProductListModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) return;
+    setLoading(true);
+    requestedAfter = cursor;
+    emit fetchRequested(cursor, pageLimit);
+}
+
+void ProductListModel::setPageSize(int size)
+{
+    if (size <= 0 || size == pageLimit) return;
+    pageLimit = size;
+    emit pageSizeChanged();
+}
+
+void ProductListModel::clear()
+{
+    beginResetModel();
+    rows.clear();
+    cursor = 0;
+    requestedAfter = -1;
+    endResetModel();
+    emit countChanged();
+
+    setLoading(false);
+    setHasMore(true);
+}
+
+void ProductListModel::reload()
+{
+    clear();
+    fetchMore(QModelIndex());
+}
+
+void ProductListModel::appendPage(int afterId, const ProductPage &page)
+{
+    if (afterId == requestedAfter) {
+        requestedAfter = -1;
+        setLoading(false);
+    }
+    if (afterId != cursor) {
+        qDebug() << "ProductListModel: veraltete Seite verworfen (after" << afterId << ")";
+        return;
+    }
+
+    // Zeilen der Seite liegen alle hinter dem Cursor, also hinter allen
+    // bisherigen — nur Duplikate aus Live-Events überspringen
+    const int lastKnown = rows.isEmpty() ? cursor : qMax(cursor, rows.last().productId);
+    auto first = std::find_if(page.rows.cbegin(), page.rows.cend(),
+                              [lastKnown](const ProductRow &r) { return r.productId > lastKnown; });
+    const int added = int(page.rows.cend() - first);
+
+    if (added > 0) {
+        beginInsertRows(QModelIndex(), int(rows.size()), int(rows.size()) + added - 1);
+        rows.append(QVector<ProductRow>(first, page.rows.cend()));
+        endInsertRows();
+        emit countChanged();
+    }
+
+    if (!page.rows.isEmpty())
+        cursor = page.lastId;
+
+    setHasMore(page.hasMore);
+}
+
+void ProductListModel::fetchFailed()
+{
+    requestedAfter = -1;
+    setLoading(false);
+}
+
+void ProductListModel::applyChange(const QString &json)
+{
+    const QJsonObject ev = QJsonDocument::fromJson(json.toUtf8()).object();
+    const QString op = ev["op"].toString();
+
+    if (op == "delete") {
+        removeProduct(ev["id"].toInt());
+    } else if (op == "insert" || op == "update") {
+        upsert(ProductRow::fromJson(ev["row"].toObject()));
+    }
+}
+
+void ProductListModel::upsert(const ProductRow &row)
+{
+    // Noch nicht geladener Bereich — kommt mit der passenden Seite
+    if (more && row.productId > cursor) return;
+
+    const int pos = lowerBound(row.productId);
+    if (pos < rows.size() && rows.at(pos).productId == row.productId) {
+        rows[pos] = row;
+        const QModelIndex idx = index(pos);
+        emit dataChanged(idx, idx);
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), pos, pos);
+    rows.insert(pos, row);
+    endInsertRows();
+    emit countChanged();
+}
+
+void ProductListModel::removeProduct(int productId)
+{
+    const int pos = indexOfProduct(productId);
+    if (pos < 0) return;
+
+    beginRemoveRows(QModelIndex(), pos, pos);
+    rows.remove(pos);
+    endRemoveRows();
+    emit countChanged();
+}
+
+int ProductListModel::indexOfProduct(int productId) const
+{
+    const int pos = lowerBound(productId);
+    return pos < rows.size() && rows.at(pos).productId == productId ? pos : -1;
+}
+
+QVariantMap ProductListModel::get(int row) const
+{
+    QVariantMap map;
+    if (row < 0 || row >= rows.size()) return map;
+
+    const QModelIndex idx = index(row);
+    const auto names = roleNames();
+    for (auto it = names.cbegin(); it != names.cend(); ++it)
+        map.insert(QString::fromLatin1(it.value()), data(idx, it.key()));
+    return map;
+}
+
+void ProductListModel::setLoading(bool value)
+{
+    if (loading == value) return;
+    loading = value;
+    emit loadingChanged();
+}
+
+void ProductListModel::setHasMore(bool value)
+{
+    if (more == value) return;
+    more = value;
+    emit hasMoreChanged();
+}
+
+int ProductListModel::lowerBound(int productId) const
+{
+    // Zeilen sind nach product_id sortiert → binäre Suche statt Hash-Index
+    auto it = std::lower_bound(rows.cbegin(), rows.cend(), productId,
+                               [](const ProductRow &r, int id) { return r.productId < id; });
+    return int(it - rows.cbegin());
+}
@@ -0,0 +1,150 @@
+#ifndef PRODUCTLISTMODEL_H
+#define PRODUCTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+#include <optional>
+
+class QCborStreamReader;
+
+// Eine Zeile der product-Tabelle, typisiert (NULL → leeres optional)
+struct ProductRow
+{
+    int productId = 0;
+    QString productNumber;
+    std::optional<qint64> gtin;
+    QString name;
+    QString unit;
+    std::optional<int> categoryId;
+    std::optional<int> supplierId;
+    std::optional<double> purchasePrice;
+    double salesPrice = 0.0;
+    int vatCode = 2;
+    QString description;
+    int active = 1;
+    QDateTime createdAt;
+    QDateTime updatedAt;
+    QString updatedBy;
+    qint64 rowVersion = 0;       // für If-Match beim PATCH
+
+    static ProductRow fromJson(const QJsonObject &obj);
+    // Eine Map aus dem CBOR-Strom (Reader steht auf der Map)
+    static ProductRow fromCbor(QCborStreamReader &reader);
+};
+
+// Eine dekodierte Seite von GET /api/products?after=…&limit=…
+struct ProductPage
+{
+    QVector<ProductRow> rows;
+    int lastId = 0;
+    bool hasMore = false;
+
+    // Reine Funktionen ohne Modellzugriff — laufen im Worker-Thread
+    static ProductPage fromJson(const QByteArray &json);
+    static ProductPage fromJson(const QJsonObject &resp);
+    static ProductPage fromCbor(const QByteArray &cbor);
+};
+
+// Produktliste für die QML-ListView
+//
+// Hält die Zeilen nach product_id sortiert und lädt seitenweise nach:
+// Die View ruft canFetchMore()/fetchMore() beim Scrollen ans Ende, das
+// Modell meldet per fetchRequested(), welche Seite gebraucht wird, und
+// bekommt die fertig dekodierte Seite über appendPage(). Änderungen (SSE, eigenes
+// Speichern) werden zeilenweise eingespielt, nie durch Neuaufbau.
+//
+// Rollennamen = Spaltennamen der API (product_id, name, sales_price, …).
+class ProductListModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(bool hasMore READ hasMore NOTIFY hasMoreChanged)
+    Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged)
+    Q_PROPERTY(int pageSize READ pageSize WRITE setPageSize NOTIFY pageSizeChanged)
+
+public:
+    enum Roles {
+        ProductIdRole = Qt::UserRole + 1,
+        ProductNumberRole,
+        GtinRole,
+        NameRole,
+        UnitRole,
+        CategoryIdRole,
+        SupplierIdRole,
+        PurchasePriceRole,
+        SalesPriceRole,
+        VatCodeRole,
+        DescriptionRole,
+        ActiveRole,
+        CreatedAtRole,
+        UpdatedAtRole,
+        UpdatedByRole,
+        RowVersionRole
+    };
+
+    explicit ProductListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    int count() const { return int(rows.size()); }
+    bool hasMore() const { return more; }
+    bool isLoading() const { return loading; }
+    int pageSize() const { return pageLimit; }
+    void setPageSize(int size);
+
+    // Alles verwerfen (clear) bzw. verwerfen und erste Seite anfordern (reload)
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE void reload();
+
+    // Dekodierte Seite übernehmen — Antworten auf veraltete Anfragen
+    // (afterId passt nicht mehr zum Cursor) werden verworfen
+    void appendPage(int afterId, const ProductPage &page);
+    Q_INVOKABLE void fetchFailed();
+
+    // Änderungs-Event {op, id, row} aus /api/products/events einspielen
+    Q_INVOKABLE void applyChange(const QString &json);
+
+    // Einzelne Zeile einfügen/ersetzen bzw. entfernen
+    void upsert(const ProductRow &row);
+    Q_INVOKABLE void removeProduct(int productId);
+
+    Q_INVOKABLE int indexOfProduct(int productId) const;
+
+    // Zeile als Objekt mit Spaltennamen (für Formulare)
+    Q_INVOKABLE QVariantMap get(int row) const;
+
+signals:
+    void countChanged();
+    void hasMoreChanged();
+    void loadingChanged();
+    void pageSizeChanged();
+
+    // Nächste Seite wird benötigt: Produkte mit product_id > afterId
+    void fetchRequested(int afterId, int limit);
+
+private:
+    void setLoading(bool value);
+    void setHasMore(bool value);
+    int lowerBound(int productId) const;
+
+    QVector<ProductRow> rows;
+
+    // Keyset-Cursor: höchste bereits seitenweise geladene product_id
+    int cursor = 0;
+    // afterId der offenen Anfrage (-1 = keine)
+    int requestedAfter = -1;
+    bool more = false;   // bis zum ersten reload()/clear() nichts nachladen
+    bool loading = false;
+    int pageLimit = 200;
+};
+
+#endif // PRODUCTLISTMODEL_H
@@ -0,0 +1,324 @@
+#include "tabledatamodel.h"
+#include "cborreader.h"
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// Grobe Zeichenbreite bei 12px-Schrift + Rand
+static const int CharWidth = 7;
+static const int CellPadding = 20;
+static const int MinColumnWidth = 60;
+static const int MaxColumnWidth = 320;
+// Für die Breitenschätzung reichen die ersten Zeilen
+static const int WidthSampleRows = 200;
+
+// ===== TableData =====
+
+static QString cellText(const QVariant &v)
+{
+    switch (v.metaType().id()) {
+    case QMetaType::Double:    return QString::number(v.toDouble(), 'g', 15);
+    case QMetaType::LongLong:  return QString::number(v.toLongLong());
+    case QMetaType::Bool:      return v.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+    default:                   return v.toString();
+    }
+}
+
+static QString cellText(const QJsonValue &v)
+{
+    if (v.isString())
+        return v.toString();
+    if (v.isDouble())
+        return QString::number(v.toDouble(), 'g', 15);
+    if (v.isBool())
+        return v.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+    if (v.isArray())
+        return QString::fromUtf8(QJsonDocument(v.toArray()).toJson(QJsonDocument::Compact));
+    if (v.isObject())
+        return QString::fromUtf8(QJsonDocument(v.toObject()).toJson(QJsonDocument::Compact));
+    return QString();
+}
+
+TableData TableData::fromJson(const QByteArray &json)
+{
+    return fromJson(QJsonDocument::fromJson(json).object());
+}
+
+TableData TableData::fromJson(const QJsonObject &resp)
+{
+    const QJsonArray cols = resp["columns"].toArray();
+    const QJsonArray rowArray = resp["rows"].toArray();
+
+    TableData d;
+    d.table = resp["table"].toString();
+    for (const QJsonValue &c : cols)
+        d.columns << c.toString();
+
+    if (resp["layout"].toString() == "columnar") {
+        // {name, type, values | dict + codes, nulls (Base64)} je Spalte
+        QVector<QVector<QString>> texts;
+        QVector<QByteArray> nullMaps;
+        for (const QJsonValue &entry : resp["data"].toArray()) {
+            const QJsonObject col = entry.toObject();
+            QVector<QString> values;
+            if (col.contains("codes")) {
+                QVector<QString> dict;
+                for (const QJsonValue &v : col["dict"].toArray()) dict.append(cellText(v));
+                for (const QJsonValue &code : col["codes"].toArray()) values.append(dict.value(code.toInt()));
+            } else {
+                for (const QJsonValue &v : col["values"].toArray()) values.append(cellText(v));
+            }
+            texts.append(values);
+            nullMaps.append(QByteArray::fromBase64(col["nulls"].toString().toLatin1()));
+        }
+        d.appendColumns(texts, nullMaps);
+        d.finishWidths();
+        return d;
+    }
+
+    const int columnTotal = int(d.columns.size());
+    d.rows = int(rowArray.size());
+    d.cells.reserve(d.rows * columnTotal);
+    d.nulls.fill(false, d.rows * columnTotal);
+    d.widths.fill(0, columnTotal);
+    for (int c = 0; c < columnTotal; ++c)
+        d.widths[c] = int(d.columns.at(c).size());
+
+    for (int r = 0; r < d.rows; ++r) {
+        const QJsonObject row = rowArray.at(r).toObject();
+        for (int c = 0; c < columnTotal; ++c) {
+            const QJsonValue v = row.value(d.columns.at(c));
+            d.appendCell(r, c, cellText(v), v.isNull() || v.isUndefined());
+        }
+    }
+
+    d.finishWidths();
+    return d;
+}
+
+TableData TableData::fromCbor(const QByteArray &cbor)
+{
+    // Struktur wie JSON: {table, columns, rows: [{spalte: wert}], rowCount},
+    // columns kommt vom Backend vor rows bzw. data (layout=columnar)
+    TableData d;
+    QCborStreamReader reader(cbor);
+    if (!reader.isMap() || !reader.enterContainer())
+        return d;
+
+    QHash<QString, int> columnIndex;
+    while (reader.hasNext()) {
+        const QString key = Cbor::readKey(reader);
+
+        if (key == u"table") {
+            d.table = Cbor::readValue(reader).toString();
+        } else if (key == u"columns" && reader.isArray()) {
+            reader.enterContainer();
+            while (reader.hasNext()) {
+                const QString name = Cbor::readValue(reader).toString();
+                columnIndex.insert(name, int(d.columns.size()));
+                d.columns << name;
+            }
+            reader.leaveContainer();
+            d.widths.fill(0, d.columns.size());
+            for (int c = 0; c < d.columns.size(); ++c)
+                d.widths[c] = int(d.columns.at(c).size());
+        } else if (key == u"rows" && reader.isArray()) {
+            const int columnTotal = int(d.columns.size());
+            QVector<QVariant> values(columnTotal);
+
+            reader.enterContainer();
+            while (reader.hasNext()) {
+                values.fill(QVariant());
+                if (reader.isMap() && reader.enterContainer()) {
+                    while (reader.hasNext()) {
+                        const int c = columnIndex.value(Cbor::readKey(reader), -1);
+                        const QVariant v = Cbor::readValue(reader);
+                        if (c >= 0) values[c] = v;
+                    }
+                    reader.leaveContainer();
+                } else {
+                    reader.next();
+                }
+
+                const int r = d.rows++;
+                d.nulls.resize(d.rows * columnTotal);
+                for (int c = 0; c < columnTotal; ++c) {
+                    const QVariant &v = values.at(c);
+                    d.appendCell(r, c, cellText(v), !v.isValid());
+                }
+            }
+            reader.leaveContainer();
+        } else if (key == u"data" && reader.isArray()) {
+            // layout=columnar: eine Map pro Spalte, codes und nulls als Byte-Strings
+            QVector<QVector<QString>> texts;
+            QVector<QByteArray> nullMaps;
+
+            reader.enterContainer();
+            while (reader.hasNext()) {
+                QVector<QString> values, dict;
+                QByteArray codes, nulls;
+                bool hasCodes = false;
+                if (reader.isMap() && reader.enterContainer()) {
+                    while (reader.hasNext()) {
+                        const QString k = Cbor::readKey(reader);
+                        if ((k == u"values" || k == u"dict") && reader.isArray()) {
+                            QVector<QString> &target = k == u"values" ? values : dict;
+                            reader.enterContainer();
+                            while (reader.hasNext())
+                                target.append(cellText(Cbor::readValue(reader)));
+                            reader.leaveContainer();
+                        } else if (k == u"codes") {
+                            codes = Cbor::readValue(reader).toByteArray();
+                            hasCodes = true;
+                        } else if (k == u"nulls") {
+                            nulls = Cbor::readValue(reader).toByteArray();
+                        } else {
+                            reader.next();
+                        }
+                    }
+                    reader.leaveContainer();
+                } else {
+                    reader.next();
+                }
+
+                if (hasCodes) {
+                    values.resize(codes.size());
+                    for (int i = 0; i < codes.size(); ++i)
+                        values[i] = dict.value(quint8(codes.at(i)));
+                }
+                texts.append(values);
+                nullMaps.append(nulls);
+            }
+            reader.leaveContainer();
+            d.appendColumns(texts, nullMaps);
+        } else {
+            reader.next();
+        }
+    }
+    reader.leaveContainer();
+
+    if (reader.lastError() != QCborError::NoError) {
+        qWarning() << "TableData: CBOR fehlerhaft:" << reader.lastError().toString();
+        return TableData();
+    }
+
+    d.finishWidths();
+    return d;
+}
+
+void TableData::appendCell(int row, int column, const QString &text, bool isNull)
+{
+    if (isNull)
+        nulls.setBit(row * int(columns.size()) + column);
+    if (row < WidthSampleRows)
+        widths[column] = qMax(widths[column], int(text.size()));
+    cells.append(text);
+}
+
+void TableData::appendColumns(const QVector<QVector<QString>> &texts, const QVector<QByteArray> &nullMaps)
+{
+    const int columnTotal = int(columns.size());
+    if (widths.size() != columnTotal) {
+        widths.fill(0, columnTotal);
+        for (int c = 0; c < columnTotal; ++c)
+            widths[c] = int(columns.at(c).size());
+    }
+
+    rows = texts.isEmpty() ? 0 : int(texts.first().size());
+    cells.reserve(rows * columnTotal);
+    nulls.fill(false, rows * columnTotal);
+
+    // Spalten, die das Backend nicht geliefert hat, bleiben leer
+    const int available = qMin(columnTotal, int(qMin(texts.size(), nullMaps.size())));
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columnTotal; ++c) {
+            if (c >= available) { appendCell(r, c, QString(), true); continue; }
+            const QByteArray &bitmap = nullMaps.at(c);
+            const bool isNull = r / 8 < bitmap.size() && (quint8(bitmap.at(r / 8)) & (1 << (r % 8)));
+            appendCell(r, c, texts.at(c).value(r), isNull);
+        }
+    }
+}
+
+void TableData::finishWidths()
+{
+    for (int &w : widths)
+        w = qBound(MinColumnWidth, w * CharWidth + CellPadding, MaxColumnWidth);
+}
+
+// ===== TableDataModel =====
+
+TableDataModel::TableDataModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int TableDataModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : content.rows;
+}
+
+int TableDataModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(content.columns.size());
+}
+
+QVariant TableDataModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid()) return QVariant();
+
+    const int i = index.row() * int(content.columns.size()) + index.column();
+    switch (role) {
+    case Qt::DisplayRole: return content.nulls.testBit(i) ? QStringLiteral("NULL") : content.cells.at(i);
+    case IsNullRole:      return content.nulls.testBit(i);
+    }
+    return QVariant();
+}
+
+QVariant TableDataModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) return QVariant();
+    if (orientation == Qt::Horizontal)
+        return section < content.columns.size() ? QVariant(content.columns.at(section)) : QVariant();
+    return section + 1;
+}
+
+QHash<int, QByteArray> TableDataModel::roleNames() const
+{
+    return {
+        { Qt::DisplayRole, "display" },
+        { IsNullRole,      "isNull" }
+    };
+}
+
+void TableDataModel::setTableData(TableData &&data)
+{
+    beginResetModel();
+    content = std::move(data);
+    endResetModel();
+    emit loaded();
+}
+
+void TableDataModel::clear()
+{
+    setTableData(TableData());
+}
+
+QVariantMap TableDataModel::rowData(int row) const
+{
+    QVariantMap map;
+    if (row < 0 || row >= content.rows) return map;
+
+    const int columnTotal = int(content.columns.size());
+    for (int c = 0; c < columnTotal; ++c) {
+        const int i = row * columnTotal + c;
+        map.insert(content.columns.at(c), content.nulls.testBit(i) ? QVariant() : QVariant(content.cells.at(i)));
+    }
+    return map;
+}
+
+int TableDataModel::columnWidth(int column) const
+{
+    return column >= 0 && column < content.widths.size() ? content.widths.at(column) : MinColumnWidth;
+}
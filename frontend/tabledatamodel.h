@@ -0,0 +1,84 @@
+#ifndef TABLEDATAMODEL_H
+#define TABLEDATAMODEL_H
+
+#include <QAbstractTableModel>
+#include <QBitArray>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+class QJsonObject;
+
+// Dekodierter Inhalt von GET /api/table
+struct TableData
+{
+    QString table;
+    QStringList columns;
+    int rows = 0;
+
+    // rows × columns.size(), zeilenweise
+    QVector<QString> cells;
+    QBitArray nulls;
+    QVector<int> widths;
+
+    // Reine Funktionen ohne Modellzugriff — laufen im Worker-Thread
+    static TableData fromJson(const QByteArray &json);
+    static TableData fromJson(const QJsonObject &resp);
+    static TableData fromCbor(const QByteArray &cbor);
+
+private:
+    void appendCell(int row, int column, const QString &text, bool isNull);
+    // layout=columnar: Anzeige-Strings + NULL-Bitmap je Spalte → Zellen
+    void appendColumns(const QVector<QVector<QString>> &texts, const QVector<QByteArray> &nullMaps);
+    void finishWidths();
+};
+
+// Tabelleninhalt für den DB-Browser (TableView)
+//
+// Übernimmt die dekodierte Antwort von GET /api/table ({columns, rows});
+// die Zellen liegen als fertige Anzeige-Strings in einem flachen Array
+// (zeilenweise). Die TableView fragt nur sichtbare Zellen ab und
+// recycelt ihre Delegates — auch breite Tabellen mit vielen Zeilen
+// bleiben so flüssig.
+class TableDataModel : public QAbstractTableModel
+{
+    Q_OBJECT
+    Q_PROPERTY(QString tableName READ tableName NOTIFY loaded)
+    Q_PROPERTY(QStringList columns READ columns NOTIFY loaded)
+    Q_PROPERTY(int rows READ rows NOTIFY loaded)
+
+public:
+    enum Roles {
+        IsNullRole = Qt::UserRole + 1
+    };
+
+    explicit TableDataModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    QString tableName() const { return content.table; }
+    QStringList columns() const { return content.columns; }
+    int rows() const { return content.rows; }
+
+    // Dekodierten Tabelleninhalt übernehmen
+    void setTableData(TableData &&data);
+    Q_INVOKABLE void clear();
+
+    // Zeile als Objekt mit Spaltennamen (Detail-Dialog)
+    Q_INVOKABLE QVariantMap rowData(int row) const;
+
+    // Spaltenbreite in Pixeln, geschätzt aus Inhalt (für columnWidthProvider)
+    Q_INVOKABLE int columnWidth(int column) const;
+
+signals:
+    void loaded();
+
+private:
+    TableData content;
+};
+
+#endif // TABLEDATAMODEL_H
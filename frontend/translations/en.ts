@@ -2,58 +2,46 @@
 <!DOCTYPE TS>
 <TS version="2.1" language="en">
 <context>
-    <name>main</name>
+    <name>Main</name>
     <message>
-        <source>Server beenden?</source>
-        <translation>Shut down server?</translation>
-    </message>
-    <message>
-        <source>Möchten Sie das Qt-Backend wirklich beenden?
-
-Die Applikation ist danach nicht mehr funktionsfähig.</source>
-        <translation>Do you really want to shut down the Qt backend?
-
-The application will no longer be functional afterwards.</translation>
+        <source>Bitte anmelden...</source>
+        <translation>Please log in...</translation>
     </message>
     <message>
-        <source>Ja</source>
-        <translation>Yes</translation>
+        <source>Nicht angemeldet</source>
+        <translation>Not logged in</translation>
     </message>
     <message>
-        <source>Nein</source>
-        <translation>No</translation>
+        <source>Sprache:</source>
+        <translation>Language:</translation>
     </message>
     <message>
-        <source>Schließen</source>
-        <translation>Close</translation>
+        <source>Angemeldet als: </source>
+        <translation>Logged in as: </translation>
     </message>
     <message>
-        <source>Datensatz Details</source>
-        <translation>Record Details</translation>
+        <source>Lade...</source>
+        <translation>Loading...</translation>
     </message>
     <message>
-        <source>Datenbank-Abfrage</source>
-        <translation>Database Query</translation>
+        <source>Sitzung abgelaufen — bitte erneut anmelden</source>
+        <translation>Session expired — please log in again</translation>
     </message>
     <message>
-        <source>Lade...</source>
-        <translation>Loading...</translation>
+        <source>Sitzung abgelaufen</source>
+        <translation>Session expired</translation>
     </message>
     <message>
         <source>Verbinde mit Backend...</source>
         <translation>Connecting to backend...</translation>
     </message>
-    <message>
-        <source>Lade Greeting (Sprache: </source>
-        <translation>Loading greeting (language: </translation>
-    </message>
     <message>
         <source>Geladen: </source>
         <translation>Loaded: </translation>
     </message>
     <message>
-        <source>Fehler beim Parsen</source>
-        <translation>Parse error</translation>
+        <source>Lade Greeting (Sprache: </source>
+        <translation>Loading greeting (language: </translation>
     </message>
     <message>
         <source>Fehler: </source>
@@ -64,121 +52,145 @@ The application will no longer be functional afterwards.</translation>
         <translation>Backend unreachable</translation>
     </message>
     <message>
-        <source>Neu laden</source>
-        <translation>Reload</translation>
+        <source>Sende Shutdown-Befehl...</source>
+        <translation>Sending shutdown command...</translation>
     </message>
     <message>
-        <source>Datenbank-Browser</source>
-        <translation>Database Browser</translation>
+        <source>Sende Shutdown-Befehl an Backend...</source>
+        <translation>Sending shutdown command to backend...</translation>
     </message>
     <message>
-        <source>Tabellen</source>
-        <translation>Tables</translation>
+        <source>Server wird beendet</source>
+        <translation>Server shutting down</translation>
     </message>
     <message>
-        <source>Aktualisieren</source>
-        <translation>Refresh</translation>
+        <source>Shutdown erfolgreich</source>
+        <translation>Shutdown successful</translation>
     </message>
     <message>
-        <source>Zeilen</source>
-        <translation>rows</translation>
+        <source>Shutdown-Fehler: </source>
+        <translation>Shutdown error: </translation>
     </message>
     <message>
-        <source>Tabelle wählen...</source>
-        <translation>Select table...</translation>
+        <source>Fehler beim Parsen</source>
+        <translation>Parse error</translation>
     </message>
     <message>
-        <source>Detail-Ansicht: </source>
-        <translation>Detail view: </translation>
+        <source>Applikation gestartet</source>
+        <translation>Application started</translation>
     </message>
     <message>
-        <source>Doppelklick für Details</source>
-        <translation>Double-click for details</translation>
+        <source>Wert: </source>
+        <translation>Value: </translation>
     </message>
     <message>
-        <source>Server Kontrolle</source>
-        <translation>Server Control</translation>
+        <source>Datum &amp; Zeit</source>
+        <translation>Date &amp; Time</translation>
     </message>
     <message>
-        <source>Backend beenden</source>
-        <translation>Shut down backend</translation>
+        <source>Datum:</source>
+        <translation>Date:</translation>
     </message>
     <message>
-        <source>Nur Development!</source>
-        <translation>Development only!</translation>
+        <source>Zeit:</source>
+        <translation>Time:</translation>
     </message>
     <message>
-        <source>API Informationen</source>
-        <translation>API Information</translation>
+        <source>Kalender:</source>
+        <translation>Calendar:</translation>
     </message>
+</context>
+<context>
+    <name>InputTab</name>
     <message>
-        <source>Sende Shutdown-Befehl...</source>
-        <translation>Sending shutdown command...</translation>
+        <source>Datum: </source>
+        <translation>Date: </translation>
     </message>
     <message>
-        <source>Sende Shutdown-Befehl an Backend...</source>
-        <translation>Sending shutdown command to backend...</translation>
+        <source>Zeit: </source>
+        <translation>Time: </translation>
     </message>
     <message>
-        <source>Server wird beendet</source>
-        <translation>Server shutting down</translation>
+        <source>Numerische Eingabe</source>
+        <translation>Numeric Input</translation>
     </message>
     <message>
-        <source>Shutdown erfolgreich</source>
-        <translation>Shutdown successful</translation>
+        <source>Kalender: </source>
+        <translation>Calendar: </translation>
+    </message>
+</context>
+<context>
+    <name>DatabaseTab</name>
+    <message>
+        <source>Datenbank-Abfrage</source>
+        <translation>Database Query</translation>
     </message>
     <message>
-        <source>Shutdown-Fehler: </source>
-        <translation>Shutdown error: </translation>
+        <source>Neu laden</source>
+        <translation>Reload</translation>
     </message>
     <message>
-        <source>Applikation gestartet</source>
-        <translation>Application started</translation>
+        <source>Datenbank-Browser</source>
+        <translation>Database Browser</translation>
     </message>
     <message>
-        <source>Sprache:</source>
-        <translation>Language:</translation>
+        <source>Tabellen</source>
+        <translation>Tables</translation>
     </message>
     <message>
-        <source>Numerische Eingabe</source>
-        <translation>Numeric Input</translation>
+        <source>Aktualisieren</source>
+        <translation>Refresh</translation>
     </message>
     <message>
-        <source>Wert: </source>
-        <translation>Value: </translation>
+        <source>Zeilen</source>
+        <translation>rows</translation>
     </message>
     <message>
-        <source>Datum &amp; Zeit</source>
-        <translation>Date &amp; Time</translation>
+        <source>Tabelle wählen...</source>
+        <translation>Select table...</translation>
     </message>
     <message>
-        <source>Datum:</source>
-        <translation>Date:</translation>
+        <source>Doppelklick für Details</source>
+        <translation>Double-click for details</translation>
     </message>
     <message>
-        <source>Zeit:</source>
-        <translation>Time:</translation>
+        <source>Datensatz Details</source>
+        <translation>Record Details</translation>
     </message>
     <message>
-        <source>Datum: </source>
-        <translation>Date: </translation>
+        <source>Detail-Ansicht: </source>
+        <translation>Detail view: </translation>
     </message>
     <message>
-        <source>Zeit: </source>
-        <translation>Time: </translation>
+        <source>Server Kontrolle</source>
+        <translation>Server Control</translation>
     </message>
     <message>
-        <source>Kalender:</source>
-        <translation>Calendar:</translation>
+        <source>Backend beenden</source>
+        <translation>Shut down backend</translation>
     </message>
     <message>
-        <source>Kalender: </source>
-        <translation>Calendar: </translation>
+        <source>Nur Development!</source>
+        <translation>Development only!</translation>
     </message>
-    <!-- Auth / Login -->
     <message>
-        <source>Bitte anmelden...</source>
-        <translation>Please log in...</translation>
+        <source>API Informationen</source>
+        <translation>API Information</translation>
+    </message>
+</context>
+<context>
+    <name>LoginDialog</name>
+    <message>
+        <source>Serverfehler beim Login</source>
+        <translation>Server error during login</translation>
+    </message>
+    <message>
+        <source>Ungültige Anmeldedaten</source>
+        <translation>Invalid credentials</translation>
+    </message>
+    <message>
+        <source>Verbindungsfehler: </source>
+        <translation>Connection error: </translation>
     </message>
     <message>
         <source>Anmeldung</source>
@@ -208,33 +220,50 @@ The application will no longer be functional afterwards.</translation>
         <source>Anmelden</source>
         <translation>Sign in</translation>
     </message>
+</context>
+<context>
+    <name>ShutdownDialog</name>
     <message>
-        <source>Angemeldet als: </source>
-        <translation>Logged in as: </translation>
+        <source>Server beenden?</source>
+        <translation>Shut down server?</translation>
     </message>
     <message>
-        <source>Serverfehler beim Login</source>
-        <translation>Server error during login</translation>
+        <source>Möchten Sie das Qt-Backend wirklich beenden?
+
+Die Applikation ist danach nicht mehr funktionsfähig.</source>
+        <translation>Do you really want to shut down the Qt backend?
+
+The application will no longer be functional afterwards.</translation>
     </message>
     <message>
-        <source>Ungültige Anmeldedaten</source>
-        <translation>Invalid credentials</translation>
+        <source>Ja</source>
+        <translation>Yes</translation>
     </message>
     <message>
-        <source>Verbindungsfehler: </source>
-        <translation>Connection error: </translation>
+        <source>Nein</source>
+        <translation>No</translation>
     </message>
+</context>
+<context>
+    <name>DetailDialog</name>
     <message>
-        <source>Sitzung abgelaufen — bitte erneut anmelden</source>
-        <translation>Session expired — please log in again</translation>
+        <source>Datensatz Details</source>
+        <translation>Record Details</translation>
     </message>
     <message>
-        <source>Sitzung abgelaufen</source>
-        <translation>Session expired</translation>
+        <source>Schließen</source>
+        <translation>Close</translation>
     </message>
+</context>
+<context>
+    <name>ProductDialog</name>
     <message>
-        <source>Nicht angemeldet</source>
-        <translation>Not logged in</translation>
+        <source>Ja</source>
+        <translation>Yes</translation>
+    </message>
+    <message>
+        <source>Nein</source>
+        <translation>No</translation>
     </message>
 </context>
 </TS>
@@ -64,6 +64,7 @@ fi
 
 # Temporäre Dateien entfernen
 rm -f frontend.html frontend.js frontend.wasm qtloader.js 2>/dev/null || true
+rm -f frontend.js.br frontend.js.gz frontend.wasm.br frontend.wasm.gz qtloader.js.br qtloader.js.gz 2>/dev/null || true
 rm -rf obj moc 2>/dev/null || true
 
 # qmake für WebAssembly
@@ -126,6 +127,21 @@ if [ "$FILES_OK" = false ]; then
     error "Nicht alle benötigten Dateien wurden generiert!"
 fi
 
+# Vorkomprimieren für das Backend (STATIC_DIR) — Varianten werden per
+# Accept-Encoding gewählt, komprimiert wird nur einmal hier
+for f in frontend.js frontend.wasm qtloader.js; do
+    [ -f "$f" ] || continue
+    gzip -9 -k -f "$f"
+    if command -v brotli &> /dev/null; then
+        brotli -q 11 -k -f "$f"
+    fi
+done
+if command -v brotli &> /dev/null; then
+    info "✓ .gz/.br-Varianten erzeugt"
+else
+    info "✓ .gz-Varianten erzeugt (für .br: brew install brotli)"
+fi
+
 echo ""
 info "Build erfolgreich abgeschlossen!"
 echo ""
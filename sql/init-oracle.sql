@@ -4,6 +4,9 @@
 -- Verbindung testen
 SELECT 'Connected to Oracle: ' || banner FROM v$version WHERE ROWNUM = 1;
 
+-- Hinweis: Die Tabelle product wird vom Backend über versionierte
+-- Migrationen angelegt (backend/schemamigrator.cpp, Tabelle schema_version)
+
 -- Greetings Tabelle erstellen
 CREATE TABLE greetings (
     id NUMBER GENERATED ALWAYS AS IDENTITY PRIMARY KEY,
@@ -4,6 +4,9 @@
 -- Schema erstellen (falls nicht automatisch)
 CREATE SCHEMA IF NOT EXISTS public;
 
+-- Hinweis: Die Tabelle product wird vom Backend über versionierte
+-- Migrationen angelegt (backend/schemamigrator.cpp, Tabelle schema_version)
+
 -- Greetings Tabelle
 CREATE TABLE IF NOT EXISTS greetings (
     id SERIAL PRIMARY KEY,
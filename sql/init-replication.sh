@@ -0,0 +1,11 @@
+#!/bin/sh
+# Streaming-Replikation für die lokalen Lese-Replicas
+# (docker compose --profile replicas up, siehe README "Lese-Replicas")
+# Läuft nur beim ersten Start mit leerem Volume.
+set -e
+
+psql -v ON_ERROR_STOP=1 --username "$POSTGRES_USER" --dbname "$POSTGRES_DB" <<-EOSQL
+    CREATE ROLE replicator WITH REPLICATION LOGIN PASSWORD 'replicator_pass';
+EOSQL
+
+echo "host replication replicator all scram-sha-256" >> "$PGDATA/pg_hba.conf"